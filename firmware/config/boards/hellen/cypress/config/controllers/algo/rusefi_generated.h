@@ -1077,6 +1077,7 @@
 #define LDS_ETB_PID_STATE_INDEX 7
 #define LDS_FUEL_TRIM_STATE_INDEX 4
 #define LDS_IDLE_PID_STATE_INDEX 8
+#define LDS_PERF_STATS_INDEX 12
 #define LDS_SPEED_DENSITY_STATE_INDEX 2
 #define LDS_TPS_TPS_ENEICHMENT_STATE_INDEX 5
 #define LDS_TRIGGER_CENTRAL_STATE_INDEX 6
@@ -1627,9 +1628,13 @@
 #define TS_ONLINE_PROTOCOL_char z
 #define TS_OUTPUT_COMMAND 'O'
 #define TS_OUTPUT_COMMAND_char O
+#define TS_OUTPUT_DELTA_COMMAND 'd'
+#define TS_OUTPUT_DELTA_COMMAND_char d
 #define TS_OUTPUT_SIZE 340
 #define TS_PAGE_COMMAND 'P'
 #define TS_PAGE_COMMAND_char P
+#define TS_PERF_TRACE_ARM 'a'
+#define TS_PERF_TRACE_ARM_char a
 #define TS_PERF_TRACE_BEGIN '_'
 #define TS_PERF_TRACE_BEGIN_char _
 #define TS_PERF_TRACE_GET_BUFFER 'b'
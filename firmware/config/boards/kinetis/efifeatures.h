@@ -344,6 +344,7 @@
 #define EXTREME_TERM_LOGGING FALSE
 #define EFI_PRINTF_FUEL_DETAILS FALSE
 #define ENABLE_PERF_TRACE FALSE
+#define EFI_PERF_STATS FALSE
 
 #define RAM_UNUSED_SIZE 1
 #define CCM_UNUSED_SIZE 1
@@ -119,6 +119,13 @@
 #define EFI_SIGNAL_EXECUTOR_ONE_TIMER TRUE
 #define EFI_SIGNAL_EXECUTOR_HW_TIMER FALSE
 
+/**
+ * TimerWheel instead of sorted linked list as SingleTimerExecutor queue
+ */
+#ifndef EFI_EVENT_QUEUE_TIMER_WHEEL
+#define EFI_EVENT_QUEUE_TIMER_WHEEL FALSE
+#endif
+
 #define FUEL_MATH_EXTREME_LOGGING FALSE
 
 #define SPARK_EXTREME_LOGGING FALSE
@@ -129,6 +136,14 @@
 #define EFI_INTERNAL_FLASH TRUE
 #endif
 
+/**
+ * Burn appends changed bytes to a journal next to each configuration copy instead of erasing both sectors.
+ * Needs each copy in a sector of its own with room for the journal, see flash_journal.h
+ */
+#ifndef EFI_FLASH_JOURNAL
+#define EFI_FLASH_JOURNAL TRUE
+#endif
+
 /**
  * Usually you need shaft position input, but maybe you do not need it?
  */
@@ -273,6 +288,11 @@
 	#define ENABLE_PERF_TRACE FALSE
 #endif
 
+// per-PE duration histograms, about 4k of memory
+#ifndef EFI_PERF_STATS
+#define EFI_PERF_STATS TRUE
+#endif
+
 #ifndef EFI_LUA
 #define EFI_LUA TRUE
 #endif
@@ -58,3 +58,7 @@
 
 // F7 may have dual bank, so flash on its own (low priority) thread so as to not block any other operations
 #define EFI_FLASH_WRITE_THREAD TRUE
+
+// on some F7 devices configuration copies are only 32K apart, no room for a journal
+#undef EFI_FLASH_JOURNAL
+#define EFI_FLASH_JOURNAL FALSE
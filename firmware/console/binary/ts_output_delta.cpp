@@ -0,0 +1,107 @@
+/**
+ * @file	ts_output_delta.cpp
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#include "ts_output_delta.h"
+
+#include <cstring>
+
+// both run header fields are single bytes
+#define RUN_MAX 255
+
+int encodeOutputDelta(const uint8_t* previous, const uint8_t* current, size_t size, uint8_t* out, size_t outCapacity) {
+	// trailing unchanged bytes are implicit
+	while (size > 0 && previous[size - 1] == current[size - 1]) {
+		size--;
+	}
+
+	size_t outIndex = 0;
+	size_t index = 0;
+
+	while (true) {
+		size_t skip = 0;
+		while (index < size && previous[index] == current[index] && skip < RUN_MAX) {
+			index++;
+			skip++;
+		}
+		if (index == size) {
+			break;
+		}
+
+		size_t literalStart = index;
+		while (index < size && index - literalStart < RUN_MAX) {
+			if (previous[index] != current[index]) {
+				index++;
+			} else if (index + 1 < size && previous[index + 1] != current[index + 1]
+					&& index + 1 - literalStart < RUN_MAX) {
+				// one unchanged byte followed by a change
+				index += 2;
+			} else {
+				break;
+			}
+		}
+
+		size_t length = index - literalStart;
+		if (outIndex + 2 + length > outCapacity) {
+			return -1;
+		}
+		out[outIndex++] = skip;
+		out[outIndex++] = length;
+		memcpy(out + outIndex, current + literalStart, length);
+		outIndex += length;
+	}
+
+	return outIndex;
+}
+
+bool TsOutputDelta::needsKeyframe(uint16_t offset, uint16_t count, uint8_t ackedSequence) const {
+	return m_keyframeCount + m_deltaCount == 0
+		|| offset != m_offset
+		|| count != m_count
+		// client has not got our last frame
+		|| ackedSequence != m_sequence
+		|| m_framesSinceKeyframe >= TS_OUTPUT_DELTA_KEYFRAME_PERIOD;
+}
+
+size_t TsOutputDelta::update(const uint8_t* current, uint16_t offset, uint16_t count, uint8_t ackedSequence) {
+	if (count > TS_OUTPUT_DELTA_MAX_SIZE) {
+		count = TS_OUTPUT_DELTA_MAX_SIZE;
+	}
+
+	int deltaSize = -1;
+	if (!needsKeyframe(offset, count, ackedSequence)) {
+		deltaSize = encodeOutputDelta(m_reference, current, count,
+				m_response + TS_OUTPUT_DELTA_HEADER_SIZE, count);
+		if (deltaSize >= count) {
+			// a delta as large as the keyframe is of no use
+			deltaSize = -1;
+		}
+	}
+
+	m_sequence++;
+	m_response[1] = m_sequence;
+
+	size_t size;
+	if (deltaSize < 0) {
+		m_response[0] = TS_OUTPUT_DELTA_KEYFRAME;
+		memcpy(m_response + TS_OUTPUT_DELTA_HEADER_SIZE, current, count);
+		size = TS_OUTPUT_DELTA_HEADER_SIZE + count;
+
+		m_offset = offset;
+		m_count = count;
+		m_framesSinceKeyframe = 0;
+		m_keyframeCount++;
+	} else {
+		m_response[0] = 0;
+		size = TS_OUTPUT_DELTA_HEADER_SIZE + deltaSize;
+
+		m_framesSinceKeyframe++;
+		m_deltaCount++;
+	}
+
+	memcpy(m_reference, current, count);
+	return size;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file	ts_output_delta.h
+ *
+ * Delta compressed output channels, see TS_OUTPUT_DELTA_COMMAND
+ *
+ * Request is same as TS_OUTPUT_COMMAND plus one byte: sequence number of the last frame which the client
+ * has decoded. If that frame is the one we have sent last we only send what has changed since, otherwise
+ * and every TS_OUTPUT_DELTA_KEYFRAME_PERIOD frames we send a keyframe.
+ *
+ * Response payload:
+ *   byte 0: flags, TS_OUTPUT_DELTA_KEYFRAME
+ *   byte 1: sequence number of this frame
+ *   keyframe: 'count' bytes of output channels
+ *   delta: runs of [unchanged byte count][changed byte count][changed bytes], unchanged bytes after the
+ *   last run are implicit. Single unchanged bytes between changes are sent as changed, that's cheaper
+ *   than a new run header.
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#pragma once
+
+#include "tunerstudio_outputs.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#define TS_OUTPUT_DELTA_KEYFRAME 1
+#define TS_OUTPUT_DELTA_HEADER_SIZE 2
+#define TS_OUTPUT_DELTA_KEYFRAME_PERIOD 64
+
+#define TS_OUTPUT_DELTA_MAX_SIZE sizeof(TunerStudioOutputChannels)
+
+/**
+ * @return size of encoded delta, -1 if it does not fit into outCapacity
+ */
+int encodeOutputDelta(const uint8_t* previous, const uint8_t* current, size_t size, uint8_t* out, size_t outCapacity);
+
+/**
+ * Encoder state of one TS channel, each channel has a client of its own
+ */
+class TsOutputDelta {
+public:
+	/**
+	 * @return size of response payload, see getResponse()
+	 */
+	size_t update(const uint8_t* current, uint16_t offset, uint16_t count, uint8_t ackedSequence);
+
+	const uint8_t* getResponse() const {
+		return m_response;
+	}
+
+	uint32_t getKeyframeCount() const {
+		return m_keyframeCount;
+	}
+
+	uint32_t getDeltaCount() const {
+		return m_deltaCount;
+	}
+
+private:
+	bool needsKeyframe(uint16_t offset, uint16_t count, uint8_t ackedSequence) const;
+
+	uint8_t m_reference[TS_OUTPUT_DELTA_MAX_SIZE];
+	uint8_t m_response[TS_OUTPUT_DELTA_HEADER_SIZE + TS_OUTPUT_DELTA_MAX_SIZE];
+
+	// what m_reference holds
+	uint16_t m_offset = 0;
+	uint16_t m_count = 0;
+	uint8_t m_sequence = 0;
+
+	int m_framesSinceKeyframe = 0;
+
+	uint32_t m_keyframeCount = 0;
+	uint32_t m_deltaCount = 0;
+};
@@ -87,6 +87,7 @@
 #include "status_loop.h"
 #include "mmc_card.h"
 #include "perf_trace.h"
+#include "perf_stats.h"
 #include "thread_priority.h"
 
 #include "signature.h"
@@ -253,6 +254,11 @@ static const void * getStructAddr(int structId) {
 		return static_cast<pid_state_s*>(getIdlePid());
 #endif /* EFI_IDLE_CONTROL */
 
+#if EFI_PERF_STATS
+	case LDS_PERF_STATS_INDEX:
+		return getPerfStats();
+#endif /* EFI_PERF_STATS */
+
 	default:
 		return NULL;
 	}
@@ -421,6 +427,7 @@ static void handleBurnCommand(TsChannelBase* tsChannel, ts_response_format_e mod
 
 static bool isKnownCommand(char command) {
 	return command == TS_HELLO_COMMAND || command == TS_READ_COMMAND || command == TS_OUTPUT_COMMAND
+			|| command == TS_OUTPUT_DELTA_COMMAND
 			|| command == TS_PAGE_COMMAND || command == TS_BURN_COMMAND || command == TS_SINGLE_WRITE_COMMAND
 			|| command == TS_CHUNK_WRITE_COMMAND || command == TS_EXECUTE
 			|| command == TS_IO_TEST_COMMAND
@@ -433,6 +440,7 @@ static bool isKnownCommand(char command) {
 			|| command == TS_GET_FIRMWARE_VERSION
 			|| command == TS_PERF_TRACE_BEGIN
 			|| command == TS_PERF_TRACE_GET_BUFFER
+			|| command == TS_PERF_TRACE_ARM
 			|| command == TS_SD_R_COMMAND
 			|| command == TS_SD_W_COMMAND
 			|| command == TS_GET_CONFIG_ERROR;
@@ -702,6 +710,9 @@ int TunerStudioBase::handleCrcCommand(TsChannelBase* tsChannel, char *data, int
 	case TS_OUTPUT_COMMAND:
 		cmdOutputChannels(tsChannel, offset, count);
 		break;
+	case TS_OUTPUT_DELTA_COMMAND:
+		cmdOutputChannelsDelta(tsChannel, offset, count, data[4]);
+		break;
 	case TS_HELLO_COMMAND:
 		tunerStudioDebug("got Query command");
 		handleQueryCommand(tsChannel, TS_CRC);
@@ -833,6 +844,10 @@ int TunerStudioBase::handleCrcCommand(TsChannelBase* tsChannel, char *data, int
 		perfTraceEnable();
 		sendOkResponse(tsChannel, TS_CRC);
 		break;
+	case TS_PERF_TRACE_ARM:
+		perfTraceArm(data[4], offset, count);
+		sendOkResponse(tsChannel, TS_CRC);
+		break;
 	case TS_PERF_TRACE_GET_BUFFER:
 		{
 			auto trace = perfTraceGetBuffer();
@@ -5,5 +5,6 @@ TUNERSTUDIO_SRC_CPP = $(PROJECT_DIR)/console/binary/tunerstudio_io.cpp \
 	$(PROJECT_DIR)/console/binary/ts_can_channel.cpp \
 	$(PROJECT_DIR)/console/binary/tunerstudio.cpp \
 	$(PROJECT_DIR)/console/binary/tunerstudio_commands.cpp \
+	$(PROJECT_DIR)/console/binary/ts_output_delta.cpp \
 	$(PROJECT_DIR)/console/binary/bluetooth.cpp \
 	$(PROJECT_DIR)/console/binary/signature.cpp
@@ -26,4 +26,24 @@ void TunerStudio::cmdOutputChannels(TsChannelBase* tsChannel, uint16_t offset, u
 	tsChannel->sendResponse(TS_CRC, reinterpret_cast<const uint8_t*>(&tsOutputChannels) + offset, count);
 }
 
+/**
+ * @brief Same as 'Output' command but only sends what has changed since the last frame client has got
+ * @see ts_output_delta.h
+ */
+void TunerStudio::cmdOutputChannelsDelta(TsChannelBase* tsChannel, uint16_t offset, uint16_t count, uint8_t ackedSequence) {
+	if (offset + count > sizeof(TunerStudioOutputChannels)) {
+		efiPrintf("TS: Version Mismatch? Too much outputs requested %d/%d/%d", offset, count,
+				sizeof(TunerStudioOutputChannels));
+		sendErrorCode(tsChannel, TS_RESPONSE_OUT_OF_RANGE);
+		return;
+	}
+
+	tsState.outputChannelsCommandCounter++;
+	prepareTunerStudioOutputs();
+	TsOutputDelta& outputDelta = tsChannel->outputDelta;
+	size_t size = outputDelta.update(reinterpret_cast<const uint8_t*>(&tsOutputChannels) + offset,
+			offset, count, ackedSequence);
+	tsChannel->sendResponse(TS_CRC, outputDelta.getResponse(), size);
+}
+
 #endif // EFI_TUNER_STUDIO
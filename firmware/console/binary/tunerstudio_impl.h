@@ -10,11 +10,13 @@ public:
 
 protected:
 	virtual void cmdOutputChannels(TsChannelBase* tsChannel, uint16_t offset, uint16_t count) = 0;
+	virtual void cmdOutputChannelsDelta(TsChannelBase* tsChannel, uint16_t offset, uint16_t count, uint8_t ackedSequence) = 0;
 };
 
 class TunerStudio : public TunerStudioBase {
 public:
 	void cmdOutputChannels(TsChannelBase* tsChannel, uint16_t offset, uint16_t count) override;
+	void cmdOutputChannelsDelta(TsChannelBase* tsChannel, uint16_t offset, uint16_t count, uint8_t ackedSequence) override;
 
 private:
 	void sendErrorCode(TsChannelBase* tsChannel, uint8_t code);
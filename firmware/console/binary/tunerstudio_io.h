@@ -8,6 +8,7 @@
 
 #pragma once
 #include "global.h"
+#include "ts_output_delta.h"
 
 #if EFI_USB_SERIAL
 #include "usbconsole.h"
@@ -48,6 +49,11 @@ public:
 	 */
 	char scratchBuffer[BLOCKING_FACTOR + 30];
 
+	/**
+	 * Delta compressed output channels are relative to what the client of this channel has got
+	 */
+	TsOutputDelta outputDelta;
+
 private:
 	void writeCrcPacketSmall(uint8_t responseCode, const uint8_t* buf, size_t size);
 	void writeCrcPacketLarge(uint8_t responseCode, const uint8_t* buf, size_t size);
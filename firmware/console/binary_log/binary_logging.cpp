@@ -131,12 +131,12 @@ void writeHeader(Writer& outBuffer) {
 
 static uint8_t blockRollCounter = 0;
 
-size_t writeBlock(char* buffer) {
+size_t writeBlock(Writer& outBuffer, char* buffer) {
 	// Offset 0 = Block type, standard data block in this case
 	buffer[0] = 0;
 
 	// Offset 1 = rolling counter sequence number
-	buffer[1] = blockRollCounter++;
+	buffer[1] = blockRollCounter;
 
 	// Offset 2, size 2 = Timestamp at 10us resolution
 	uint16_t timestamp = getTimeNowUs() / 10;
@@ -165,5 +165,12 @@ size_t writeBlock(char* buffer) {
 	*dataBlock = sum;
 
 	// Total size has 4 byte header + 1 byte checksum
-	return dataBlockSize + 5;
+	size_t length = dataBlockSize + 5;
+
+	// counter only moves for blocks which made it into the log, findLogDataEnd() takes a gap for the end of data
+	if (outBuffer.write(buffer, length) == length) {
+		blockRollCounter++;
+	}
+
+	return length;
 }
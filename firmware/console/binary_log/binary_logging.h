@@ -2,4 +2,8 @@
 
 struct Writer;
 void writeHeader(Writer& buffer);
-size_t writeBlock(char* buffer);
+/**
+ * Fills buffer with one data block and writes it
+ * @return size of the block, whether or not the writer has accepted it
+ */
+size_t writeBlock(Writer& outBuffer, char* buffer);
@@ -0,0 +1,59 @@
+/**
+ * @file log_recovery.cpp
+ *
+ * Data block layout is the one written by writeBlock() in binary_logging.cpp
+ */
+
+#include "global.h"
+#include "log_recovery.h"
+
+#include <cstring>
+
+size_t findLogDataEnd(LogReader& reader, size_t fileSize) {
+	char buffer[MAX_RECOVERY_BLOCK_SIZE];
+
+	if (fileSize < MLQ_HEADER_SIZE || reader.read(0, buffer, MLQ_HEADER_SIZE) != MLQ_HEADER_SIZE
+			|| memcmp(buffer, "MLVLG", 6) != 0) {
+		// not even the header made it
+		return 0;
+	}
+
+	// use the layout from the file itself, not current firmware
+	size_t offset = (buffer[16] & 0xFF) << 8 | (buffer[17] & 0xFF);
+	size_t dataLength = (buffer[18] & 0xFF) << 8 | (buffer[19] & 0xFF);
+	size_t blockSize = dataLength + 5;
+	if (blockSize > sizeof(buffer) || offset > fileSize) {
+		// does not look like ours, do not touch
+		return fileSize;
+	}
+
+	bool isFirst = true;
+	uint8_t expectedCounter = 0;
+	while (offset + blockSize <= fileSize) {
+		if (reader.read(offset, buffer, blockSize) != blockSize) {
+			break;
+		}
+		// standard data block
+		if (buffer[0] != 0) {
+			break;
+		}
+		uint8_t counter = buffer[1];
+		if (!isFirst && counter != expectedCounter) {
+			break;
+		}
+
+		uint8_t sum = 0;
+		for (size_t i = 0; i < dataLength; i++) {
+			sum += buffer[4 + i];
+		}
+		if (sum != (uint8_t)buffer[4 + dataLength]) {
+			break;
+		}
+
+		isFirst = false;
+		expectedCounter = counter + 1;
+		offset += blockSize;
+	}
+
+	return offset;
+}
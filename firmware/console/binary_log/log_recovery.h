@@ -0,0 +1,28 @@
+/**
+ * @file log_recovery.h
+ *
+ * See also mlq_file_format.txt
+ */
+
+#pragma once
+
+#include <cstddef>
+
+// longest data block we are ready to validate, 4 byte header + data + checksum
+#define MAX_RECOVERY_BLOCK_SIZE 512
+
+struct LogReader {
+	/**
+	 * @return number of bytes actually read
+	 */
+	virtual size_t read(size_t offset, char* buffer, size_t count) = 0;
+};
+
+/**
+ * Finds where valid data ends in a log file which was preallocated but not truncated, for example after power loss.
+ * Walks data blocks for as long as block type, rolling counter and checksum all make sense.
+ * Writer is expected to keep at least MAX_RECOVERY_BLOCK_SIZE bytes of 0xFF after its data, since the rest
+ * of the region is not erased and could hold blocks of an older log which happen to continue the counter.
+ * @return size of the valid part of the file
+ */
+size_t findLogDataEnd(LogReader& reader, size_t fileSize);
@@ -166,9 +166,8 @@ void writeLogLine(Writer& buffer) {
 		writeHeader(buffer);
 	} else {
 		updateTunerStudioState(&tsOutputChannels);
-		size_t length = writeBlock(sdLogBuffer);
+		size_t length = writeBlock(buffer, sdLogBuffer);
 		efiAssertVoid(OBD_PCM_Processor_Fault, length <= efi::size(sdLogBuffer), "SD log buffer overflow");
-		buffer.write(sdLogBuffer, length);
 	}
 
 	binaryLogCount++;
@@ -54,7 +54,7 @@ static angle_t getRunningAdvance(int rpm, float engineLoad DECLARE_ENGINE_PARAME
 
 	efiAssert(CUSTOM_ERR_ASSERT, !cisnan(engineLoad), "invalid el", NAN);
 
-	float advanceAngle = advanceMap.getValue((float) rpm, engineLoad);
+	float advanceAngle = advanceMap.getValueWithAxisCache((float) rpm, engineLoad, ENGINE(engineState.tableAxisCache));
 
 	// get advance from the separate table for Idle
 	if (CONFIG(useSeparateAdvanceForIdle) && isIdling()) {
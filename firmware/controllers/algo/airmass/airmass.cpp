@@ -21,7 +21,7 @@ float AirmassVeModelBase::getVe(int rpm, float load) const {
 	// Override the load value if necessary
 	load = getVeLoadAxis(load);
 
-	float ve = m_veTable->getValue(rpm, load);
+	float ve = m_veTable->getValueWithAxisCache(rpm, load, ENGINE(engineState.tableAxisCache));
 
 	auto tps = Sensor::get(SensorType::Tps1);
 	// get VE from the separate table for Idle if idling
@@ -9,6 +9,7 @@ CONTROLLERS_ALGO_SRC_CPP = $(PROJECT_DIR)/controllers/algo/advance_map.cpp \
 	$(PROJECT_DIR)/controllers/algo/dynoview.cpp \
 	$(PROJECT_DIR)/controllers/algo/runtime_state.cpp \
 	$(PROJECT_DIR)/controllers/algo/engine_configuration.cpp \
+	$(PROJECT_DIR)/controllers/algo/config_change.cpp \
 	$(PROJECT_DIR)/controllers/algo/engine.cpp \
 	$(PROJECT_DIR)/controllers/algo/engine2.cpp \
 	$(PROJECT_DIR)/controllers/gauges/lcd_menu_tree.cpp \
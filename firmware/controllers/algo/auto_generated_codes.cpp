@@ -57,8 +57,6 @@ case CUSTOM_ENGINE_REF:
   return "CUSTOM_ENGINE_REF";
 case CUSTOM_ERR_2ND_WATCHDOG:
   return "CUSTOM_ERR_2ND_WATCHDOG";
-case CUSTOM_ERR_6102:
-  return "CUSTOM_ERR_6102";
 case CUSTOM_ERR_6122:
   return "CUSTOM_ERR_6122";
 case CUSTOM_ERR_6123:
@@ -321,6 +319,8 @@ case CUSTOM_ERR_BUFF_INIT_ERROR:
   return "CUSTOM_ERR_BUFF_INIT_ERROR";
 case CUSTOM_ERR_CAN_CONFIGURATION:
   return "CUSTOM_ERR_CAN_CONFIGURATION";
+case CUSTOM_ERR_CAN_RX_OVERRUN:
+  return "CUSTOM_ERR_CAN_RX_OVERRUN";
 case CUSTOM_ERR_CJ125_DIAG:
   return "CUSTOM_ERR_CJ125_DIAG";
 case CUSTOM_ERR_COMMAND_LOWER_CASE_EXPECTED:
@@ -0,0 +1,88 @@
+/**
+ * @file	config_change.cpp
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#include "global.h"
+#include "config_change.h"
+
+#include <cstddef>
+
+struct ConfigRegion {
+	uint16_t offset;
+	uint16_t size;
+	config_change_mask_t mask;
+};
+
+#define CONFIG_REGION(field, mask) { offsetof(engine_configuration_s, field), sizeof(engine_configuration_s::field), mask }
+
+/**
+ * Mask of a region has to cover every subsystem which looks at the field while (re)initializing.
+ * Bit fields cannot be listed here, these always end up as CC_ALL.
+ */
+static const ConfigRegion configRegions[] = {
+	// read on every use, nothing to re-initialize
+	CONFIG_REGION(cranking, CC_NONE),
+	CONFIG_REGION(crankingTimingAngle, CC_NONE),
+	CONFIG_REGION(ignitionDwellForCrankingMs, CC_NONE),
+	CONFIG_REGION(fixedModeTiming, CC_NONE),
+	CONFIG_REGION(globalFuelCorrection, CC_NONE),
+	CONFIG_REGION(rpmHardLimit, CC_NONE),
+
+	CONFIG_REGION(alternatorControl, CC_ALTERNATOR),
+	CONFIG_REGION(boostPid, CC_BOOST),
+	CONFIG_REGION(etb, CC_ETB),
+	CONFIG_REGION(idleRpmPid, CC_IDLE),
+
+	CONFIG_REGION(trigger, CC_TRIGGER),
+	CONFIG_REGION(ambiguousOperationMode, CC_TRIGGER),
+	CONFIG_REGION(globalTriggerAngleOffset, CC_TRIGGER),
+	CONFIG_REGION(vvtOffsets, CC_TRIGGER),
+	CONFIG_REGION(vvtMode, CC_TRIGGER),
+	CONFIG_REGION(triggerGapOverride, CC_TRIGGER),
+
+	CONFIG_REGION(triggerSimulatorFrequency, CC_EMULATOR),
+};
+
+static const ConfigRegion* findRegion(size_t offset) {
+	for (size_t i = 0; i < efi::size(configRegions); i++) {
+		const ConfigRegion& region = configRegions[i];
+		if (offset >= region.offset && offset < region.offset + region.size) {
+			return &region;
+		}
+	}
+	return nullptr;
+}
+
+config_change_mask_t getConfigurationChanges(const engine_configuration_s *previous, const engine_configuration_s *current) {
+	const uint8_t *before = reinterpret_cast<const uint8_t*>(previous);
+	const uint8_t *after = reinterpret_cast<const uint8_t*>(current);
+
+	config_change_mask_t changes = CC_NONE;
+	size_t offset = 0;
+	while (offset < sizeof(engine_configuration_s)) {
+		// skip equal words, most of configuration does not change
+		if (offset % sizeof(uint32_t) == 0 && offset + sizeof(uint32_t) <= sizeof(engine_configuration_s)
+				&& *reinterpret_cast<const uint32_t*>(before + offset) == *reinterpret_cast<const uint32_t*>(after + offset)) {
+			offset += sizeof(uint32_t);
+			continue;
+		}
+
+		if (before[offset] == after[offset]) {
+			offset++;
+			continue;
+		}
+
+		const ConfigRegion *region = findRegion(offset);
+		if (!region) {
+			return CC_ALL;
+		}
+		changes |= region->mask;
+		// no need to look at the rest of this region
+		offset = region->offset + region->size;
+	}
+
+	return changes;
+}
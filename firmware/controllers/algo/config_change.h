@@ -0,0 +1,36 @@
+/**
+ * @file	config_change.h
+ * @brief	Which subsystems have to be re-initialized after a configuration change
+ *
+ * incrementGlobalConfigurationVersion() compares the new configuration with activeConfiguration
+ * and only invokes the callbacks of subsystems whose fields have changed.
+ *
+ * Only fields listed in config_change.cpp are attributed to specific subsystems, a change anywhere
+ * else is reported as CC_ALL so an unknown field never goes unnoticed.
+ *
+ * With EFI_ACTIVE_CONFIGURATION_IN_FLASH the previous configuration is the burned one, see
+ * incrementGlobalConfigurationVersion() about what is missed in that mode.
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#pragma once
+
+#include "engine_configuration_generated_structures.h"
+
+typedef uint32_t config_change_mask_t;
+
+#define CC_HARDWARE 	(1u << 0)
+#define CC_SENSORS 		(1u << 1)
+#define CC_ALTERNATOR 	(1u << 2)
+#define CC_BOOST 		(1u << 3)
+#define CC_ETB 			(1u << 4)
+#define CC_IDLE 		(1u << 5)
+#define CC_TRIGGER 		(1u << 6)
+#define CC_EMULATOR 	(1u << 7)
+
+#define CC_NONE 0u
+#define CC_ALL 0xFFFFFFFFu
+
+config_change_mask_t getConfigurationChanges(const engine_configuration_s *previous, const engine_configuration_s *current);
@@ -19,6 +19,7 @@
 #include "buttonshift.h"
 #include "gear_controller.h"
 #include "limp_manager.h"
+#include "config_change.h"
 
 #if EFI_SIGNAL_EXECUTOR_ONE_TIMER
 // PROD real firmware uses this implementation
@@ -178,11 +179,10 @@ public:
 	bool needToStopEngine(efitick_t nowNt) const;
 	bool etbAutoTune = false;
 	/**
-	 * That's the linked list of pending events scheduled in relation to trigger
-	 * At the moment we iterate over the whole list while looking for events for specific trigger index
-	 * We can make it an array of lists per trigger index, but that would take some RAM and probably not needed yet.
+	 * Pending events scheduled in relation to trigger, one list per trigger index
+	 * so that each tooth only looks at its own events.
 	 */
-	AngleBasedEvent *angleBasedEventsHead = nullptr;
+	AngleBasedEventQueue angleBasedEvents;
 	/**
 	 * this is based on isEngineChartEnabled and engineSnifferRpmThreshold settings
 	 */
@@ -224,6 +224,10 @@ public:
 	 * tuning software)
 	 */
 	volatile int globalConfigurationVersion = 0;
+	/**
+	 * Subsystems which were re-initialized by the last configuration change, see getConfigurationChanges()
+	 */
+	config_change_mask_t lastConfigurationChanges = CC_NONE;
 
 	/**
 	 * always 360 or 720, never zero
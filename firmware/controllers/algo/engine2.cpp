@@ -107,6 +107,8 @@ void EngineState::periodicFastCallback(DECLARE_ENGINE_PARAMETER_SIGNATURE) {
 	ScopePerf perf(PE::EngineStatePeriodicFastCallback);
 
 #if EFI_ENGINE_CONTROL
+	tableAxisCache.beginPass(engine->getGlobalConfigurationVersion());
+
 	if (!engine->slowCallBackWasInvoked) {
 		warning(CUSTOM_SLOW_NOT_INVOKED, "Slow not invoked yet");
 	}
@@ -183,6 +185,7 @@ void EngineState::periodicFastCallback(DECLARE_ENGINE_PARAMETER_SIGNATURE) {
 
 	engine->limpManager.updateState(rpm, nowNt);
 
+	tableAxisCache.endPass();
 #endif // EFI_ENGINE_CONTROL
 }
 
@@ -23,6 +23,7 @@
 #include "global.h"
 #include "os_access.h"
 #include "engine_configuration.h"
+#include "config_change.h"
 #include "fsio_impl.h"
 #include "allsensors.h"
 #include "interpolation.h"
@@ -167,43 +168,76 @@ void onBurnRequest(DECLARE_ENGINE_PARAMETER_SIGNATURE) {
  *
  * this method is NOT currently invoked on ECU start - actual user input has to happen!
  * See preCalculate which is invoked BOTH on start and configuration change
+ *
+ * Only subsystems affected by the change are re-initialized, see getConfigurationChanges()
  */
 void incrementGlobalConfigurationVersion(DECLARE_ENGINE_PARAMETER_SIGNATURE) {
 	ENGINE(globalConfigurationVersion++);
 #if EFI_DEFAILED_LOGGING
 	efiPrintf("set globalConfigurationVersion=%d", globalConfigurationVersion);
 #endif /* EFI_DEFAILED_LOGGING */
+
+#if EFI_ACTIVE_CONFIGURATION_IN_FLASH
+	/**
+	 * Limitation: here activeConfiguration is the burned copy, not what subsystems were last initialized with.
+	 * A change which is applied and then reverted before burn compares equal to flash, so the revert is missed
+	 * and subsystems keep the changed value until the next full re-initialization.
+	 * No board enables this mode today.
+	 */
+	config_change_mask_t changes = isActiveConfigurationVoid ? CC_ALL : getConfigurationChanges(&activeConfiguration, engineConfiguration);
+#else
+	config_change_mask_t changes = getConfigurationChanges(&activeConfiguration, engineConfiguration);
+#endif /* EFI_ACTIVE_CONFIGURATION_IN_FLASH */
+	ENGINE(lastConfigurationChanges) = changes;
 /**
  * All these callbacks could be implemented as listeners, but these days I am saving RAM
  */
 #if EFI_PROD_CODE
-	applyNewHardwareSettings();
-	reconfigureSensors();
+	if (changes & CC_HARDWARE) {
+		applyNewHardwareSettings();
+	}
+	if (changes & CC_SENSORS) {
+		reconfigureSensors();
+	}
 #endif /* EFI_PROD_CODE */
+	// tune CRC covers tables which are not part of activeConfiguration, always refresh it
 	engine->preCalculate(PASS_ENGINE_PARAMETER_SIGNATURE);
 #if EFI_ALTERNATOR_CONTROL
-	onConfigurationChangeAlternatorCallback(&activeConfiguration);
+	if (changes & CC_ALTERNATOR) {
+		onConfigurationChangeAlternatorCallback(&activeConfiguration);
+	}
 #endif /* EFI_ALTERNATOR_CONTROL */
 
 #if EFI_BOOST_CONTROL
-	onConfigurationChangeBoostCallback(&activeConfiguration);
+	if (changes & CC_BOOST) {
+		onConfigurationChangeBoostCallback(&activeConfiguration);
+	}
 #endif
 #if EFI_ELECTRONIC_THROTTLE_BODY
-	onConfigurationChangeElectronicThrottleCallback(&activeConfiguration);
+	if (changes & CC_ETB) {
+		onConfigurationChangeElectronicThrottleCallback(&activeConfiguration);
+	}
 #endif /* EFI_ELECTRONIC_THROTTLE_BODY */
 
 #if EFI_IDLE_CONTROL && ! EFI_UNIT_TEST
-	onConfigurationChangeIdleCallback(&activeConfiguration);
+	if (changes & CC_IDLE) {
+		onConfigurationChangeIdleCallback(&activeConfiguration);
+	}
 #endif /* EFI_IDLE_CONTROL */
 
 #if EFI_SHAFT_POSITION_INPUT
-	onConfigurationChangeTriggerCallback(PASS_ENGINE_PARAMETER_SIGNATURE);
+	if (changes & CC_TRIGGER) {
+		onConfigurationChangeTriggerCallback(PASS_ENGINE_PARAMETER_SIGNATURE);
+	}
 #endif /* EFI_SHAFT_POSITION_INPUT */
 #if EFI_EMULATE_POSITION_SENSORS && ! EFI_UNIT_TEST
-	onConfigurationChangeRpmEmulatorCallback(&activeConfiguration);
+	if (changes & CC_EMULATOR) {
+		onConfigurationChangeRpmEmulatorCallback(&activeConfiguration);
+	}
 #endif /* EFI_EMULATE_POSITION_SENSORS */
 
 #if EFI_FSIO
+	// formulas are not part of activeConfiguration, callback compares them on its own
 	onConfigurationChangeFsioCallback(&activeConfiguration PASS_ENGINE_PARAMETER_SUFFIX);
 #endif /* EFI_FSIO */
 	rememberCurrentConfiguration(PASS_ENGINE_PARAMETER_SIGNATURE);
@@ -12,6 +12,7 @@
 #include "engine_parts.h"
 #include "pid.h"
 #include "engine_state_generated.h"
+#include "table_helper.h"
 
 class EngineState : public engine_state2_s {
 public:
@@ -27,6 +28,11 @@ public:
 
 	WarningCodeState warnings;
 
+	/**
+	 * Shared RPM/load axis resolution for the tables looked up by periodicFastCallback
+	 */
+	TableAxisCache tableAxisCache;
+
 	/**
 	 * speed-density logic, calculated air flow in kg/h for tCharge Air-Interp. method
 	 */
@@ -38,9 +44,10 @@ public:
 	float auxValveEnd = 0;
 
 	/**
-	 * MAP averaging angle start, in relation to 'mapAveragingSchedulingAtIndex' trigger index index
+	 * MAP averaging window start and end, engine cycle angle
 	 */
 	angle_t mapAveragingStart[MAX_CYLINDER_COUNT];
+	angle_t mapAveragingEnd[MAX_CYLINDER_COUNT];
 	angle_t mapAveragingDuration = 0;
 
 	/**
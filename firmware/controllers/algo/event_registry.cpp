@@ -36,3 +36,116 @@ IgnitionOutputPin * IgnitionEvent::getOutputForLoggins() {
 	return outputs[0];
 }
 
+static_assert(MAX_CYLINDER_COUNT <= 8 * sizeof(cylinder_mask_t), "one mask bit per cylinder");
+
+#define TOOTH_PLAN_NONE -1
+
+ToothPlan::ToothPlan() {
+	clear();
+}
+
+void ToothPlan::setTooth(int cylinderIndex, uint32_t triggerEventIndex) {
+	efiAssertVoid(CUSTOM_ERR_ASSERT, cylinderIndex >= 0 && cylinderIndex < MAX_CYLINDER_COUNT, "plan cylinder");
+	efiAssertVoid(CUSTOM_ERR_ASSERT, triggerEventIndex < PWM_PHASE_MAX_COUNT, "plan tooth");
+
+	cylinder_mask_t bit = 1 << cylinderIndex;
+	int previous = toothByCylinder[cylinderIndex];
+	if (previous != TOOTH_PLAN_NONE) {
+		byTooth[previous] &= ~bit;
+	}
+	byTooth[triggerEventIndex] |= bit;
+	toothByCylinder[cylinderIndex] = triggerEventIndex;
+}
+
+cylinder_mask_t ToothPlan::getCylinders(uint32_t triggerEventIndex) const {
+	if (triggerEventIndex >= PWM_PHASE_MAX_COUNT) {
+		return 0;
+	}
+	return byTooth[triggerEventIndex];
+}
+
+void ToothPlan::clear() {
+	memset(byTooth, 0, sizeof(byTooth));
+	for (int i = 0; i < MAX_CYLINDER_COUNT; i++) {
+		toothByCylinder[i] = TOOTH_PLAN_NONE;
+	}
+}
+
+bool AngleBasedEventQueue::queue(AngleBasedEvent *event) {
+	uint32_t toothIndex = event->position.triggerEventIndex;
+	efiAssert(CUSTOM_ERR_ASSERT, toothIndex < PWM_PHASE_MAX_COUNT, "angle event tooth", false);
+
+	if (isPending(event)) {
+		/**
+		 * for example, this might happen in case of sudden RPM change if event
+		 * was not scheduled by angle but was scheduled by time. In case of scheduling
+		 * by time with slow RPM the whole next fast revolution might be within the wait period
+		 */
+		warning(CUSTOM_RE_ADDING_INTO_EXECUTION_QUEUE, "re-adding element into event_queue");
+		if (event->queuedToothIndex == (int)toothIndex) {
+			return false;
+		}
+		// angle was updated since the event was queued, follow it to the new tooth
+		remove(event);
+	}
+
+	// appending to the tail so that events on the same tooth are handled in the order they were queued
+	AngleBasedEvent **link = &byTooth[toothIndex];
+	while (*link) {
+		link = &(*link)->nextToothEvent;
+	}
+	event->nextToothEvent = nullptr;
+	*link = event;
+	event->queuedToothIndex = toothIndex;
+	count++;
+	return true;
+}
+
+AngleBasedEvent *AngleBasedEventQueue::takeForTooth(uint32_t triggerEventIndex) {
+	if (triggerEventIndex >= PWM_PHASE_MAX_COUNT) {
+		return nullptr;
+	}
+	AngleBasedEvent *head = byTooth[triggerEventIndex];
+	if (head) {
+		byTooth[triggerEventIndex] = head->nextToothEvent;
+		head->nextToothEvent = nullptr;
+		head->queuedToothIndex = ANGLE_EVENT_NOT_QUEUED;
+		count--;
+	}
+	return head;
+}
+
+void AngleBasedEventQueue::remove(AngleBasedEvent *event) {
+	AngleBasedEvent **link = &byTooth[event->queuedToothIndex];
+	while (*link != event) {
+		link = &(*link)->nextToothEvent;
+	}
+	*link = event->nextToothEvent;
+	event->nextToothEvent = nullptr;
+	event->queuedToothIndex = ANGLE_EVENT_NOT_QUEUED;
+	count--;
+}
+
+bool AngleBasedEventQueue::isPending(const AngleBasedEvent *event) const {
+	return event->queuedToothIndex != ANGLE_EVENT_NOT_QUEUED;
+}
+
+int AngleBasedEventQueue::size() const {
+	return count;
+}
+
+AngleBasedEvent *AngleBasedEventQueue::getElementAtIndexForUnitText(int index) {
+	for (int i = 0; i < PWM_PHASE_MAX_COUNT; i++) {
+		for (AngleBasedEvent *current = byTooth[i]; current; current = current->nextToothEvent) {
+			if (index == 0) {
+				return current;
+			}
+			index--;
+		}
+	}
+#if EFI_UNIT_TEST
+	firmwareError(OBD_PCM_Processor_Fault, "getElementAtIndexForUnitText: null");
+#endif /* EFI_UNIT_TEST */
+	return nullptr;
+}
+
@@ -16,6 +16,8 @@
 
 #define MAX_WIRES_COUNT 2
 
+#define ANGLE_EVENT_NOT_QUEUED -1
+
 class Engine;
 
 class InjectionEvent {
@@ -51,6 +53,27 @@ public:
 	WallFuel wallFuel;
 };
 
+typedef uint16_t cylinder_mask_t;
+
+/**
+ * For each trigger event index, the set of cylinders which have an event starting on that tooth.
+ * It is updated every time an event angle is recalculated, this way a trigger tooth only visits
+ * cylinders which are due on that tooth instead of looping over all of them.
+ */
+class ToothPlan {
+public:
+	ToothPlan();
+	/**
+	 * Moves cylinder to a new trigger event index
+	 */
+	void setTooth(int cylinderIndex, uint32_t triggerEventIndex);
+	cylinder_mask_t getCylinders(uint32_t triggerEventIndex) const;
+	void clear();
+private:
+	cylinder_mask_t byTooth[PWM_PHASE_MAX_COUNT];
+	int16_t toothByCylinder[MAX_CYLINDER_COUNT];
+};
+
 /**
  * This class knows about when to inject fuel
  */
@@ -76,6 +99,10 @@ public:
 	 * injection events, per cylinder
 	 */
 	InjectionEvent elements[MAX_CYLINDER_COUNT];
+	/**
+	 * which cylinders start injection on which tooth
+	 */
+	ToothPlan toothPlan;
 	bool isReady = false;
 };
 
@@ -85,9 +112,43 @@ public:
 	event_trigger_position_s position;
 	action_s action;
 	/**
-	 * Trigger-based scheduler maintains a linked list of all pending tooth-based events.
+	 * Trigger-based scheduler maintains a linked list of pending tooth-based events per tooth, see AngleBasedEventQueue
 	 */
 	AngleBasedEvent *nextToothEvent = nullptr;
+	/**
+	 * index of AngleBasedEventQueue list this event is in, ANGLE_EVENT_NOT_QUEUED if none
+	 */
+	int16_t queuedToothIndex = ANGLE_EVENT_NOT_QUEUED;
+};
+
+/**
+ * Pending tooth-based events, one linked list per trigger event index. This way each trigger tooth
+ * only looks at events which are due on that tooth and checking if an event is already pending is O(1).
+ *
+ * Trigger event index is always below PWM_PHASE_MAX_COUNT so we size the table statically.
+ */
+class AngleBasedEventQueue {
+public:
+	/**
+	 * Appends the event to the list of position.triggerEventIndex tooth
+	 * @return false if event was already pending
+	 */
+	bool queue(AngleBasedEvent *event);
+	/**
+	 * @return next pending event for given tooth, removed from the queue, or nullptr
+	 */
+	AngleBasedEvent *takeForTooth(uint32_t triggerEventIndex);
+	bool isPending(const AngleBasedEvent *event) const;
+	int size() const;
+	/**
+	 * events are enumerated in tooth order
+	 */
+	AngleBasedEvent *getElementAtIndexForUnitText(int index);
+private:
+	void remove(AngleBasedEvent *event);
+
+	AngleBasedEvent *byTooth[PWM_PHASE_MAX_COUNT] = {};
+	int count = 0;
 };
 
 #define MAX_OUTPUTS_FOR_IGNITION 2
@@ -137,6 +198,10 @@ public:
 	 * ignition events, per cylinder
 	 */
 	IgnitionEvent elements[MAX_CYLINDER_COUNT];
+	/**
+	 * which cylinders start dwell on which tooth
+	 */
+	ToothPlan toothPlan;
 	bool isReady = false;
 };
 
@@ -53,7 +53,7 @@ float FuelComputer::getStoichiometricRatio() const {
 float FuelComputer::getTargetLambda(int rpm, float load) const {
 	efiAssert(OBD_PCM_Processor_Fault, m_lambdaTable != nullptr, "AFR table null", 0);
 
-	return m_lambdaTable->getValue(rpm, load);
+	return m_lambdaTable->getValueWithAxisCache(rpm, load, ENGINE(engineState.tableAxisCache));
 }
 
 float FuelComputer::getTargetLambdaLoadAxis(float defaultLoad) const {
@@ -447,7 +447,7 @@ float getBaroCorrection(DECLARE_ENGINE_PARAMETER_SIGNATURE) {
 		// Default to 1atm if failed
 		float pressure = Sensor::get(SensorType::BarometricPressure).value_or(101.325f);
 
-		float correction = baroCorrMap.getValue(GET_RPM(), pressure);
+		float correction = baroCorrMap.getValueWithAxisCache(GET_RPM(), pressure, ENGINE(engineState.tableAxisCache));
 		if (cisnan(correction) || correction < 0.01) {
 			warning(OBD_Barometric_Press_Circ_Range_Perf, "Invalid baro correction %f", correction);
 			return 1;
@@ -1791,7 +1791,7 @@ typedef enum {
 
 	CUSTOM_ERR_OP_MODE = 6100,
 	CUSTOM_ERR_TRIGGER_ZERO = 6101,
-	CUSTOM_ERR_6102 = 6102,
+	CUSTOM_ERR_CAN_RX_OVERRUN = 6102,
 	CUSTOM_ERR_2ND_WATCHDOG = 6103,
 	CUSTOM_ERR_INVALID_INJECTION_MODE = 6104,
 	CUSTOM_ERR_WAVE_1 = 6105,
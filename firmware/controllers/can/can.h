@@ -10,6 +10,7 @@
 #include "hal.h"
 
 #include "periodic_thread_controller.h"
+#include "can_tx_schedule.h"
 
 #define CAN_PEDAL_TPS_OFFSET 2
 #define CAN_SENSOR_1_OFFSET 3
@@ -17,23 +18,7 @@
 #define CAN_TIMEOUT MS2NT(100)
 
 //can tx periodic task cycle time in frequency, 200hz -> 5ms period
-#define CAN_CYCLE_FREQ		(200.0f)
-//can tx periodic task cycle time in ms
-#define CAN_CYCLE_PERIOD    (CH_CFG_ST_FREQUENCY / CAN_CYCLE_FREQ)
-
-enum class CanInterval : uint16_t {
-	None    = 0,
-	_5ms    = 1 << 0,
-	_10ms   = 1 << 1,
-	_20ms   = 1 << 2,
-	_50ms   = 1 << 3,
-	_100ms  = 1 << 4,
-	_200ms  = 1 << 5,
-	_250ms  = 1 << 6,
-	_500ms  = 1 << 7,
-	_1000ms = 1 << 8,
-	_MAX_Cycle = _1000ms,
-};
+#define CAN_CYCLE_FREQ		(1000.0f / CAN_TX_TICK_MS)
 
 class CanListener;
 class CanSensorBase;
@@ -58,41 +43,11 @@ public:
 	void PeriodicTask(efitime_t nowNt) override;
 };
 
-// allow using shorthand CI
-using CI = CanInterval;
-
-// logical and/or operators so we can use our enum like an int
-constexpr CI operator |(CI lhs, CI rhs) {
-    using T = std::underlying_type_t<CI>;
-    return static_cast<CI>(static_cast<T>(lhs) | static_cast<T>(rhs));
-}
-
-constexpr CI operator &(CI lhs, CI rhs) {
-    using T = std::underlying_type_t<CI>;
-    return static_cast<CI>(static_cast<T>(lhs) & static_cast<T>(rhs));
-}
-
-constexpr CI& operator |=(CI& lhs, CI rhs) {
-    lhs = lhs | rhs;
-    return lhs;
-}
-
-class CanCycle {
-public:
-	explicit CanCycle(uint32_t cycleCounter200hz)
-		: m_cycleFlags(computeFlags(cycleCounter200hz))
-	{
-	}
-
-	bool isInterval(CanInterval interval) {
-		return CanInterval::None != (m_cycleFlags & interval);
-	}
-
-private:
-	static CanInterval computeFlags(uint32_t cycleCount);
-
-	const CanInterval m_cycleFlags;
-};
+void printCanTxStats();
+// estimated share of bus bandwidth used by our transmissions over last second, percent
+float getCanTxBusLoad();
+// worst encode time of any CAN TX schedule slot, microseconds
+uint32_t getCanTxMaxEncodeUs();
 
 // We need these helpers because the frame layout is different on STM32H7
 #ifdef STM32H7XX
@@ -8,4 +8,9 @@
 #pragma once
 #include "can.h"
 
-void updateDash(CanCycle cycle);
+#include "rusefi_enums.h"
+
+/**
+ * @return TX schedule of selected dashboard, nullptr if none
+ */
+const CanTxSlot* getDashSchedule(can_nbc_e type, size_t& slotCount);
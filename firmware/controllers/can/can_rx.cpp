@@ -80,19 +80,65 @@ static void printPacket(const CANRxFrame &rx) {
 
 volatile float canMap = 0;
 
+/**
+ * All registered listeners, can_tx walks this list to send requests
+ */
 CanListener *canListeners_head = nullptr;
 
+#ifndef CAN_LISTENER_MAX_COUNT
+#define CAN_LISTENER_MAX_COUNT 32
+#endif
+
+/**
+ * Same listeners sorted by EID, built at registration time so that a received frame costs one binary search
+ * no matter how many listeners we have and frames nobody listens to are dropped right away.
+ * Several listeners could share one EID, for example OBD sensors decoding the same PID response.
+ */
+static CanListener *canListenersByEid[CAN_LISTENER_MAX_COUNT];
+static size_t canListenerCount = 0;
+
+/**
+ * @return index of the first listener with EID equal or above given one
+ */
+static size_t findFirstListener(uint32_t eid) {
+	size_t low = 0;
+	size_t high = canListenerCount;
+	while (low < high) {
+		size_t middle = (low + high) / 2;
+		if (canListenersByEid[middle]->getEid() < eid) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return low;
+}
+
 void serviceCanSubscribers(const CANRxFrame &frame, efitick_t nowNt) {
-	CanListener *current = canListeners_head;
+	uint32_t eid = CAN_EID(frame);
 
-	while (current) {
-		current = current->processFrame(frame, nowNt);
+	for (size_t i = findFirstListener(eid); i < canListenerCount && canListenersByEid[i]->getEid() == eid; i++) {
+		canListenersByEid[i]->processFrame(frame, nowNt);
 	}
 }
 
 void registerCanListener(CanListener& listener) {
+	efiAssertVoid(OBD_PCM_Processor_Fault, canListenerCount < CAN_LISTENER_MAX_COUNT, "too many CAN listeners");
+
 	listener.setNext(canListeners_head);
 	canListeners_head = &listener;
+
+	// insert after listeners with the same EID, shifting the rest up
+	uint32_t eid = listener.getEid();
+	size_t index = findFirstListener(eid);
+	while (index < canListenerCount && canListenersByEid[index]->getEid() == eid) {
+		index++;
+	}
+	for (size_t i = canListenerCount; i > index; i--) {
+		canListenersByEid[i] = canListenersByEid[i - 1];
+	}
+	canListenersByEid[index] = &listener;
+	canListenerCount++;
 }
 
 void registerCanSensor(CanSensorBase& sensor) {
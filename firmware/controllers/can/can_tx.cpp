@@ -23,6 +23,68 @@ EXTERN_ENGINE;
 extern CanListener* canListeners_head;
 
 
+extern uint32_t canWriteBits;
+
+void sendCanVerbose();
+
+// verbose frames go between dashboard slots, see getDashSchedule
+#define CAN_VERBOSE_PHASE_MS 25
+
+#define CAN_TX_MAX_SLOTS 8
+
+struct CanTxSlotStats {
+	uint32_t count;
+	uint32_t lastEncodeUs;
+	uint32_t maxEncodeUs;
+};
+
+static const CanTxSlot *currentDashSchedule = nullptr;
+static size_t currentDashSlotCount = 0;
+static int currentDashSharedTickCount = 0;
+static CanTxSlotStats dashSlotStats[CAN_TX_MAX_SLOTS];
+static CanTxSlotStats verboseSlotStats;
+
+static uint32_t busLoadWindowStartMs = 0;
+static uint32_t busLoadWindowStartBits = 0;
+static float busLoadPercent = 0;
+
+static int getCanBaudRate() {
+	switch (CONFIG(canBaudRate)) {
+	case B100KBPS:
+		return 100000;
+	case B250KBPS:
+		return 250000;
+	case B1MBPS:
+		return 1000000;
+	default:
+		return 500000;
+	}
+}
+
+static void runSlot(CanTxEncoder encode, CanTxSlotStats& stats) {
+	efitick_t start = getTimeNowNt();
+	encode();
+	uint32_t encodeUs = NT2US(getTimeNowNt() - start);
+
+	stats.count++;
+	stats.lastEncodeUs = encodeUs;
+	if (encodeUs > stats.maxEncodeUs) {
+		stats.maxEncodeUs = encodeUs;
+	}
+}
+
+static void updateBusLoad(uint32_t timeMs) {
+	uint32_t windowMs = timeMs - busLoadWindowStartMs;
+	if (windowMs < 1000) {
+		return;
+	}
+	uint32_t bits = canWriteBits - busLoadWindowStartBits;
+	busLoadPercent = 100.0f * bits * 1000 / windowMs / getCanBaudRate();
+
+	busLoadWindowStartMs = timeMs;
+	busLoadWindowStartBits = canWriteBits;
+}
+
 CanWrite::CanWrite()
 	: PeriodicController("CAN TX", PRIO_CAN_TX, CAN_CYCLE_FREQ)
 {
@@ -30,18 +92,10 @@ CanWrite::CanWrite()
 
 void CanWrite::PeriodicTask(efitime_t nowNt) {
 	UNUSED(nowNt);
-	static uint16_t cycleCount = 0;
-	CanCycle cycle(cycleCount);
+	static uint32_t timeMs = 0;
 
-	//in case we have Verbose Can enabled, we should keep user configured period
-	if (CONFIG(enableVerboseCanTx)) {
-		uint16_t cycleCountsPeriodMs = cycleCount * CAN_CYCLE_PERIOD;
-		if (0 != CONFIG(canSleepPeriodMs)) {
-			if (cycleCountsPeriodMs % CONFIG(canSleepPeriodMs)) {
-				void sendCanVerbose();
-				sendCanVerbose();
-			}
-		}
+	if (CONFIG(enableVerboseCanTx) && isCanTxSlotDue(timeMs, CONFIG(canSleepPeriodMs), CAN_VERBOSE_PHASE_MS)) {
+		runSlot(sendCanVerbose, verboseSlotStats);
 	}
 
 	CanListener* current = canListeners_head;
@@ -50,52 +104,57 @@ void CanWrite::PeriodicTask(efitime_t nowNt) {
 		current = current->request();
 	}
 
-	if (cycle.isInterval(CI::_MAX_Cycle)) {
-		//we now reset cycleCount since we reached max cycle count
-		cycleCount = 0;
+	size_t slotCount;
+	const CanTxSlot *schedule = getDashSchedule(CONFIG(canNbcType), slotCount);
+	if (schedule != currentDashSchedule) {
+		// dashboard type was changed, statistics of previous one are meaningless
+		memset(dashSlotStats, 0, sizeof(dashSlotStats));
+		currentDashSchedule = schedule;
+		currentDashSlotCount = slotCount < CAN_TX_MAX_SLOTS ? slotCount : CAN_TX_MAX_SLOTS;
+		currentDashSharedTickCount = getCanTxSharedTickCount(schedule, currentDashSlotCount);
 	}
 
-	updateDash(cycle);
-
-	cycleCount++;
-}
-
-CanInterval CanCycle::computeFlags(uint32_t cycleCount) {
-	CanInterval cycleMask = CanInterval::_5ms;
-
-	if ((cycleCount % 2) == 0) {
-		cycleMask |= CI::_10ms;
+	for (size_t i = 0; i < currentDashSlotCount; i++) {
+		const CanTxSlot& slot = schedule[i];
+		if (isCanTxSlotDue(timeMs, slot.periodMs, slot.phaseMs)) {
+			runSlot(slot.encode, dashSlotStats[i]);
+		}
 	}
 
-	if ((cycleCount % 4) == 0) {
-		cycleMask |= CI::_20ms;
-	}
+	updateBusLoad(timeMs);
 
-	if ((cycleCount % 10) == 0) {
-		cycleMask |= CI::_50ms;
-	}
+	timeMs += CAN_TX_TICK_MS;
+}
 
-	if ((cycleCount % 20) == 0) {
-		cycleMask |= CI::_100ms;
-	}
+static void printSlotStats(const char *name, uint16_t periodMs, uint16_t phaseMs, const CanTxSlotStats& stats) {
+	efiPrintf("CAN TX %s period=%d phase=%d count=%d encode last=%dus max=%dus", name, periodMs, phaseMs,
+			stats.count, stats.lastEncodeUs, stats.maxEncodeUs);
+}
 
-	if ((cycleCount % 40) == 0) {
-		cycleMask |= CI::_200ms;
+void printCanTxStats() {
+	efiPrintf("CAN TX bus load %.1f%%", busLoadPercent);
+	if (CONFIG(enableVerboseCanTx)) {
+		printSlotStats("verbose", CONFIG(canSleepPeriodMs), CAN_VERBOSE_PHASE_MS, verboseSlotStats);
 	}
-
-	if ((cycleCount % 50) == 0) {
-		cycleMask |= CI::_250ms;
+	for (size_t i = 0; i < currentDashSlotCount; i++) {
+		const CanTxSlot& slot = currentDashSchedule[i];
+		printSlotStats(slot.name, slot.periodMs, slot.phaseMs, dashSlotStats[i]);
 	}
+	efiPrintf("CAN TX ticks with more than one dashboard slot per schedule cycle: %d", currentDashSharedTickCount);
+}
 
-	if ((cycleCount % 100) == 0) {
-		cycleMask |= CI::_500ms;
-	}
+float getCanTxBusLoad() {
+	return busLoadPercent;
+}
 
-	if ((cycleCount % 200) == 0) {
-		cycleMask |= CI::_1000ms;
+uint32_t getCanTxMaxEncodeUs() {
+	uint32_t result = verboseSlotStats.maxEncodeUs;
+	for (size_t i = 0; i < currentDashSlotCount; i++) {
+		if (dashSlotStats[i].maxEncodeUs > result) {
+			result = dashSlotStats[i].maxEncodeUs;
+		}
 	}
-
-	return cycleMask;
+	return result;
 }
 
 #endif // EFI_CAN_SUPPORT
@@ -0,0 +1,50 @@
+/**
+ * @file	can_tx_schedule.cpp
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#include "can_tx_schedule.h"
+
+bool isCanTxSlotDue(uint32_t timeMs, uint16_t periodMs, uint16_t phaseMs) {
+	if (periodMs == 0) {
+		return false;
+	}
+	// distance from tick start to the next slot start
+	uint32_t untilSlotMs = (phaseMs % periodMs + periodMs - timeMs % periodMs) % periodMs;
+	return untilSlotMs < CAN_TX_TICK_MS;
+}
+
+static uint32_t greatestCommonDivisor(uint32_t a, uint32_t b) {
+	while (b != 0) {
+		uint32_t remainder = a % b;
+		a = b;
+		b = remainder;
+	}
+	return a;
+}
+
+int getCanTxSharedTickCount(const CanTxSlot *slots, size_t slotCount) {
+	// schedule repeats itself every least common multiple of all periods
+	uint32_t cycleMs = CAN_TX_TICK_MS;
+	for (size_t i = 0; i < slotCount; i++) {
+		if (slots[i].periodMs != 0) {
+			cycleMs = cycleMs / greatestCommonDivisor(cycleMs, slots[i].periodMs) * slots[i].periodMs;
+		}
+	}
+
+	int sharedTickCount = 0;
+	for (uint32_t timeMs = 0; timeMs < cycleMs; timeMs += CAN_TX_TICK_MS) {
+		int dueCount = 0;
+		for (size_t i = 0; i < slotCount; i++) {
+			if (isCanTxSlotDue(timeMs, slots[i].periodMs, slots[i].phaseMs)) {
+				dueCount++;
+			}
+		}
+		if (dueCount > 1) {
+			sharedTickCount++;
+		}
+	}
+	return sharedTickCount;
+}
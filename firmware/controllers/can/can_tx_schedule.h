@@ -0,0 +1,39 @@
+/**
+ * @file	can_tx_schedule.h
+ * @brief	Declarative CAN TX schedule, see getDashSchedule
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//can tx periodic task cycle time in ms
+#define CAN_TX_TICK_MS		5
+
+typedef void (*CanTxEncoder)();
+
+/**
+ * One entry of a declarative CAN TX schedule: 'encode' builds and sends its frames every 'periodMs',
+ * 'phaseMs' into the period. Different phases spread frames of one schedule over different ticks
+ * instead of bursting all of them on the same one.
+ */
+struct CanTxSlot {
+	const char *name;
+	uint16_t periodMs;
+	uint16_t phaseMs;
+	CanTxEncoder encode;
+};
+
+/**
+ * @return true if slot start falls into the tick which begins at timeMs
+ */
+bool isCanTxSlotDue(uint32_t timeMs, uint16_t periodMs, uint16_t phaseMs);
+
+/**
+ * @return number of ticks within one full cycle of the schedule which more than one slot is due on
+ */
+int getCanTxSharedTickCount(const CanTxSlot *slots, size_t slotCount);
@@ -103,6 +103,10 @@ bool warning(obd_code_e code, const char *fmt, ...) {
 	if (hasFirmwareErrorFlag)
 		return true;
 
+#if ENABLE_PERF_TRACE
+	perfTraceTrigger(PERF_TRACE_TRIGGER_WARNING);
+#endif /* ENABLE_PERF_TRACE */
+
 #if EFI_SIMULATOR
 	printf("sim_warning %s\r\n", fmt);
 #endif /* EFI_SIMULATOR */
@@ -204,6 +208,9 @@ void firmwareError(obd_code_e code, const char *fmt, ...) {
 #if EFI_PROD_CODE
 	if (hasFirmwareErrorFlag)
 		return;
+#if ENABLE_PERF_TRACE
+	perfTraceTrigger(PERF_TRACE_TRIGGER_ERROR);
+#endif /* ENABLE_PERF_TRACE */
 	engine->limpManager.fatalError();
 	engine->engineState.warnings.addWarningCode(code);
 #ifdef EFI_PRINT_ERRORS_AS_WARNINGS
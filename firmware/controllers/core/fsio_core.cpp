@@ -6,7 +6,8 @@
  * http://en.wikipedia.org/wiki/Reverse_Polish_notation
  *
  * Once the expressions are parsed on startup (that's a heavy operation),
- * evaluating those is relatively efficient.
+ * evaluating those is relatively efficient. Runtime paths evaluate the
+ * compiled form, see LEElementPool::compile()
  *
  *
  * @date Oct 3, 2014
@@ -351,6 +352,11 @@ LEElement* LEElementPool::parseExpression(const char * line) {
 	LEElement* n = expressionHead;
 
 	while (true) {
+		if (n >= m_pool + size) {
+			// no room for the next token or the return statement, caller reports the failure
+			return nullptr;
+		}
+
 		line = getNextToken(line, parsingBuffer, sizeof(parsingBuffer));
 
 		if (!line) {
@@ -387,6 +393,279 @@ LEElement* LEElementPool::parseExpression(const char * line) {
 	}
 }
 
+/**
+ * @return how many values the action takes from the stack, -1 if the action cannot be compiled
+ */
+static int getOperandCount(le_action_e action) {
+	switch (action) {
+	case LE_OPERATOR_NOT:
+	case LE_METHOD_FSIO_SETTING:
+	case LE_METHOD_FSIO_ANALOG_INPUT:
+		return 1;
+	case LE_OPERATOR_AND:
+	case LE_OPERATOR_OR:
+	case LE_OPERATOR_ADDITION:
+	case LE_OPERATOR_SUBTRACTION:
+	case LE_OPERATOR_MULTIPLICATION:
+	case LE_OPERATOR_DIVISION:
+	case LE_OPERATOR_LESS:
+	case LE_OPERATOR_MORE:
+	case LE_OPERATOR_LESS_OR_EQUAL:
+	case LE_OPERATOR_MORE_OR_EQUAL:
+	case LE_METHOD_MIN:
+	case LE_METHOD_MAX:
+		return 2;
+	case LE_METHOD_IF:
+	case LE_METHOD_FSIO_TABLE:
+		return 3;
+	case LE_UNDEFINED:
+	// always an error at runtime, let LECalculator report it
+	case LE_METHOD_FSIO_DIGITAL_INPUT:
+	case LE_COMPILED_FSIO_SETTING:
+	case LE_COMPILED_FSIO_TABLE:
+		return -1;
+	default:
+		// literals, self and engine values
+		return 0;
+	}
+}
+
+/**
+ * @return folded value, unexpected if the action depends on something besides its operands
+ */
+static FsioResult foldConstants(le_action_e action, const float* operands) {
+	switch (action) {
+	case LE_OPERATOR_AND:
+	case LE_OPERATOR_OR:
+		return doBinaryBoolean(action, operands[0], operands[1]);
+	case LE_OPERATOR_NOT:
+		return !float2bool(operands[0]) ? 1 : 0;
+	case LE_METHOD_IF:
+		return operands[0] != 0 ? operands[1] : operands[2];
+	default:
+		return doBinaryNumeric(action, operands[0], operands[1]);
+	}
+}
+
+FsioProgram LEElementPool::compile(const LEElement* expression) {
+	FsioProgram program;
+	if (!expression) {
+		return program;
+	}
+
+	int sourceLength = 0;
+	while (expression[sourceLength].action != LE_METHOD_RETURN) {
+		sourceLength++;
+	}
+	// compiled code is never longer than the source
+	if (m_nextFree + sourceLength + 1 > m_pool + size) {
+		return program;
+	}
+
+	LEElement* code = m_nextFree;
+	int codeLength = 0;
+	// a constant is always a single LE_NUMERIC_VALUE instruction, so constant operands are the last instructions
+	bool isConstant[MAX_STACK_DEPTH];
+	int depth = 0;
+
+	for (const LEElement* element = expression; element->action != LE_METHOD_RETURN; element++) {
+		le_action_e action = element->action;
+		int operandCount = getOperandCount(action);
+		if (operandCount < 0 || operandCount > depth) {
+			return program;
+		}
+
+		bool constantOperands = true;
+		for (int i = depth - operandCount; i < depth; i++) {
+			constantOperands = constantOperands && isConstant[i];
+		}
+		depth -= operandCount;
+		if (depth == MAX_STACK_DEPTH) {
+			return program;
+		}
+
+		LEElement* n;
+		switch (action) {
+		case LE_NUMERIC_VALUE:
+		case LE_BOOLEAN_VALUE:
+			n = &code[codeLength++];
+			n->init(LE_NUMERIC_VALUE, action == LE_BOOLEAN_VALUE ? (element->fValue != 0 ? 1.0f : 0.0f) : element->fValue);
+			isConstant[depth] = true;
+			break;
+		case LE_METHOD_FSIO_SETTING:
+		case LE_METHOD_FSIO_TABLE:
+			// index is the last operand
+			if (!isConstant[depth + operandCount - 1]) {
+				code[codeLength++].init(action);
+			} else {
+				int humanIndex = (int) code[codeLength - 1].fValue;
+				int maxHumanIndex = action == LE_METHOD_FSIO_SETTING ? FSIO_COMMAND_COUNT : MAX_TABLE_INDEX;
+				if (humanIndex < 1 || humanIndex > maxHumanIndex) {
+					return program;
+				}
+				// index instruction is replaced by the resolved one
+				code[codeLength - 1].init(action == LE_METHOD_FSIO_SETTING ? LE_COMPILED_FSIO_SETTING : LE_COMPILED_FSIO_TABLE,
+						(float) (humanIndex - 1));
+			}
+			isConstant[depth] = false;
+			break;
+		default:
+			if (operandCount > 0 && constantOperands && action != LE_METHOD_FSIO_ANALOG_INPUT) {
+				float operands[3];
+				for (int i = 0; i < operandCount; i++) {
+					operands[i] = code[codeLength - operandCount + i].fValue;
+				}
+				FsioResult folded = foldConstants(action, operands);
+				if (!folded) {
+					return program;
+				}
+				codeLength -= operandCount;
+				code[codeLength++].init(LE_NUMERIC_VALUE, folded.Value);
+				isConstant[depth] = true;
+			} else {
+				code[codeLength++].init(action);
+				isConstant[depth] = false;
+			}
+		}
+		depth++;
+	}
+
+	if (depth != 1) {
+		return program;
+	}
+
+	code[codeLength].init(LE_METHOD_RETURN);
+	m_nextFree = code + codeLength + 1;
+	program.m_code = code;
+	return program;
+}
+
+float FsioProgram::evaluate(float selfValue DECLARE_ENGINE_PARAMETER_SUFFIX) const {
+	if (!m_code) {
+		return NAN;
+	}
+#if EFI_PROD_CODE
+	efiAssert(CUSTOM_ERR_ASSERT, getCurrentRemainingStack() > 64 + sizeof(float) * MAX_STACK_DEPTH, "FSIO program", NAN);
+#endif
+
+	// LEElementPool::compile() has made sure this neither overflows nor underflows
+	float stack[MAX_STACK_DEPTH];
+	int top = -1;
+
+	for (const LEElement* element = m_code; ; element++) {
+		switch (element->action) {
+		case LE_METHOD_RETURN:
+			return stack[0];
+		case LE_NUMERIC_VALUE:
+			stack[++top] = element->fValue;
+			break;
+		case LE_METHOD_SELF:
+			stack[++top] = selfValue;
+			break;
+		case LE_OPERATOR_AND:
+			top--;
+			stack[top] = float2bool(stack[top]) && float2bool(stack[top + 1]);
+			break;
+		case LE_OPERATOR_OR:
+			top--;
+			stack[top] = float2bool(stack[top]) || float2bool(stack[top + 1]);
+			break;
+		case LE_OPERATOR_NOT:
+			stack[top] = !float2bool(stack[top]);
+			break;
+		case LE_OPERATOR_ADDITION:
+			top--;
+			stack[top] = stack[top] + stack[top + 1];
+			break;
+		case LE_OPERATOR_SUBTRACTION:
+			top--;
+			stack[top] = stack[top] - stack[top + 1];
+			break;
+		case LE_OPERATOR_MULTIPLICATION:
+			top--;
+			stack[top] = stack[top] * stack[top + 1];
+			break;
+		case LE_OPERATOR_DIVISION:
+			top--;
+			stack[top] = stack[top] / stack[top + 1];
+			break;
+		case LE_OPERATOR_LESS:
+			top--;
+			stack[top] = stack[top] < stack[top + 1];
+			break;
+		case LE_OPERATOR_MORE:
+			top--;
+			stack[top] = stack[top] > stack[top + 1];
+			break;
+		case LE_OPERATOR_LESS_OR_EQUAL:
+			top--;
+			stack[top] = stack[top] <= stack[top + 1];
+			break;
+		case LE_OPERATOR_MORE_OR_EQUAL:
+			top--;
+			stack[top] = stack[top] >= stack[top + 1];
+			break;
+		case LE_METHOD_MIN:
+			top--;
+			stack[top] = minF(stack[top], stack[top + 1]);
+			break;
+		case LE_METHOD_MAX:
+			top--;
+			stack[top] = maxF(stack[top], stack[top + 1]);
+			break;
+		case LE_METHOD_IF:
+			top -= 2;
+			stack[top] = stack[top] != 0 ? stack[top + 1] : stack[top + 2];
+			break;
+		case LE_COMPILED_FSIO_SETTING:
+			stack[++top] = CONFIG(fsio_setting)[(int) element->fValue];
+			break;
+		case LE_COMPILED_FSIO_TABLE:
+			top--;
+			stack[top] = getFSIOTable((int) element->fValue)->getValue(stack[top], stack[top + 1]);
+			break;
+		case LE_METHOD_FSIO_SETTING: {
+			int index = (int) stack[top] - 1;
+			if (index < 0 || index >= FSIO_COMMAND_COUNT) {
+				return NAN;
+			}
+			stack[top] = CONFIG(fsio_setting)[index];
+			break;
+		}
+		case LE_METHOD_FSIO_TABLE: {
+			top -= 2;
+			int index = (int) stack[top + 2];
+			if (index < 1 || index > MAX_TABLE_INDEX) {
+				return NAN;
+			}
+			// index parameter is 1-based, getFSIOTable is 0-based
+			stack[top] = getFSIOTable(index - 1)->getValue(stack[top], stack[top + 1]);
+			break;
+		}
+		case LE_METHOD_FSIO_ANALOG_INPUT: {
+			int index = clampF(0, stack[top], FSIO_ANALOG_INPUT_COUNT - 1);
+			int sensorIdx = static_cast<int>(SensorType::Aux1) + index;
+			SensorResult result = Sensor::get(static_cast<SensorType>(sensorIdx));
+			if (!result) {
+				return NAN;
+			}
+			stack[top] = result.Value;
+			break;
+		}
+		case LE_METHOD_KNOCK:
+			stack[++top] = ENGINE(knockCount);
+			break;
+		default: {
+			FsioResult result = getEngineValue(element->action PASS_ENGINE_PARAMETER_SUFFIX);
+			if (!result) {
+				return NAN;
+			}
+			stack[++top] = result.Value;
+		}
+		}
+	}
+}
+
 FsioValue::FsioValue(float f)
 {
 	u.f32 = f;
@@ -62,6 +62,10 @@ typedef enum {
 	LE_METHOD_FUEL_FLOW_RATE = 131,
 	LE_METHOD_OIL_PRESSURE = 132,
 
+	// only produced by LEElementPool::compile(), fValue is the resolved 0-based index
+	LE_COMPILED_FSIO_SETTING = 133,
+	LE_COMPILED_FSIO_TABLE = 134,
+
 #include "fsio_enums_generated.def"
 
 	Force_4b_le_action = ENUM_32_BITS,
@@ -108,12 +112,45 @@ public:
 	float fValue;
 };
 
+/**
+ * Expression compiled by LEElementPool::compile(): constants are folded, fsio_setting and fsio_table
+ * indices are resolved and stack depth is checked once, so evaluate() runs without any stack checks.
+ */
+class FsioProgram {
+public:
+	bool isValid() const {
+		return m_code != nullptr;
+	}
+
+	/**
+	 * @return NAN if program is not valid or an input value is not available
+	 */
+	float evaluate(float selfValue DECLARE_ENGINE_PARAMETER_SUFFIX) const;
+
+	const LEElement* getCode() const {
+		return m_code;
+	}
+
+private:
+	friend class LEElementPool;
+	const LEElement* m_code = nullptr;
+};
+
 class LEElementPool {
 public:
 	LEElementPool(LEElement *pool, int size);
 
 	void reset();
+	/**
+	 * @return nullptr if expression cannot be parsed or there is no room left in the pool
+	 */
 	LEElement * parseExpression(const char * line);
+	/**
+	 * Compiles parsed expression into this pool, which could be other than the one holding the expression.
+	 * Parsed expression is kept intact for LECalculator.
+	 * Returned program is not valid if expression is malformed or there is no room left in the pool.
+	 */
+	FsioProgram compile(const LEElement* expression);
 	int getSize() const;
 private:
 	LEElement* m_pool;
@@ -94,10 +94,21 @@ LEElementPool sysPool(sysElements, SYS_ELEMENT_POOL_SIZE);
 static LEElement userElements[UD_ELEMENT_POOL_SIZE] CCM_OPTIONAL;
 LEElementPool userPool(userElements, UD_ELEMENT_POOL_SIZE);
 
+/**
+ * Compiled programs have pools of their own so that expressions have all of their pool, just like before
+ * compilation was added. Code is never longer than the source so the same size is always enough.
+ */
+static LEElement sysCodeElements[SYS_ELEMENT_POOL_SIZE] CCM_OPTIONAL;
+LEElementPool sysCodePool(sysCodeElements, SYS_ELEMENT_POOL_SIZE);
+
+static LEElement userCodeElements[UD_ELEMENT_POOL_SIZE] CCM_OPTIONAL;
+LEElementPool userCodePool(userCodeElements, UD_ELEMENT_POOL_SIZE);
+
 class FsioPointers {
 public:
 	FsioPointers();
 	LEElement * fsioLogics[FSIO_COMMAND_COUNT];
+	FsioProgram fsioPrograms[FSIO_COMMAND_COUNT];
 };
 
 FsioPointers::FsioPointers() : fsioLogics() {
@@ -106,10 +117,13 @@ FsioPointers::FsioPointers() : fsioLogics() {
 static FsioPointers state;
 
 static LEElement * fuelPumpLogic;
+static FsioProgram fuelPumpProgram;
 static LEElement * starterRelayDisableLogic;
+static FsioProgram starterRelayDisableProgram;
 
 #if EFI_MAIN_RELAY_CONTROL
 static LEElement * mainRelayLogic;
+static FsioProgram mainRelayProgram;
 #endif /* EFI_MAIN_RELAY_CONTROL */
 
 #if EFI_PROD_CODE || EFI_SIMULATOR
@@ -272,8 +286,13 @@ void setFsio(int index, brain_pin_e pin, const char * exp DECLARE_CONFIG_PARAMET
 	setFsioExt(index, pin, exp, NO_PWM PASS_CONFIG_PARAMETER_SUFFIX);
 }
 
+// formulas the current programs were parsed from
+static uint32_t appliedFormulasCrc;
+
 void applyFsioConfiguration(DECLARE_ENGINE_PARAMETER_SIGNATURE) {
+	appliedFormulasCrc = crc32(config->fsioFormulas, sizeof(config->fsioFormulas));
 	userPool.reset();
+	userCodePool.reset();
 	for (int i = 0; i < FSIO_COMMAND_COUNT; i++) {
 		const char *formula = config->fsioFormulas[i];
 		int len = strlen(formula);
@@ -283,18 +302,34 @@ void applyFsioConfiguration(DECLARE_ENGINE_PARAMETER_SIGNATURE) {
 		}
 
 		state.fsioLogics[i] = logic;
+		state.fsioPrograms[i] = userCodePool.compile(logic);
 	}
 }
 
 void onConfigurationChangeFsioCallback(engine_configuration_s *previousConfiguration DECLARE_ENGINE_PARAMETER_SUFFIX) {
 	(void)previousConfiguration;
 #if EFI_FSIO
+	// parsing is expensive, most configuration changes do not touch formulas
+	if (crc32(config->fsioFormulas, sizeof(config->fsioFormulas)) == appliedFormulasCrc) {
+		return;
+	}
 	applyFsioConfiguration(PASS_ENGINE_PARAMETER_SIGNATURE);
 #endif
 }
 
 static LECalculator calc;
 
+/**
+ * Compiled program is what we run, parsed expression is only interpreted if it could not be compiled
+ * so that LECalculator reports what is wrong with it
+ */
+static float evaluateLogic(const char *msg, float selfValue, const FsioProgram &program, const LEElement *element DECLARE_ENGINE_PARAMETER_SUFFIX) {
+	if (program.isValid()) {
+		return program.evaluate(selfValue PASS_ENGINE_PARAMETER_SUFFIX);
+	}
+	return calc.evaluate(msg, selfValue, element PASS_ENGINE_PARAMETER_SUFFIX);
+}
+
 static SimplePwm fsioPwm[FSIO_COMMAND_COUNT] CCM_OPTIONAL;
 
 // that's crazy, but what's an alternative? we need const char *, a shared buffer would not work for pin repository
@@ -341,7 +376,7 @@ float getFsioOutputValue(int index DECLARE_ENGINE_PARAMETER_SUFFIX) {
 		warning(CUSTOM_NO_FSIO, "no FSIO for #%d %s", index + 1, hwPortname(CONFIG(fsioOutputPins)[index]));
 		return NAN;
 	} else {
-		return calc.evaluate("FSIO", engine->fsioState.fsioLastValue[index], state.fsioLogics[index] PASS_ENGINE_PARAMETER_SUFFIX);
+		return evaluateLogic("FSIO", engine->fsioState.fsioLastValue[index], state.fsioPrograms[index], state.fsioLogics[index] PASS_ENGINE_PARAMETER_SUFFIX);
 	}
 }
 
@@ -398,7 +433,7 @@ static const char * action2String(le_action_e action) {
 	return buffer;
 }
 
-static void setPinState(const char * msg, OutputPin *pin, LEElement *element DECLARE_ENGINE_PARAMETER_SUFFIX) {
+static void setPinState(const char * msg, OutputPin *pin, const FsioProgram &program, LEElement *element DECLARE_ENGINE_PARAMETER_SUFFIX) {
 #if EFI_PROD_CODE
 	if (isRunningBenchTest()) {
 		return; // let's not mess with bench testing
@@ -408,8 +443,12 @@ static void setPinState(const char * msg, OutputPin *pin, LEElement *element DEC
 	if (!element) {
 		warning(CUSTOM_FSIO_INVALID_EXPRESSION, "invalid expression for %s", msg);
 	} else {
-		int value = (int)calc.evaluate(msg, pin->getLogicValue(), element PASS_ENGINE_PARAMETER_SUFFIX);
+		int value = (int)evaluateLogic(msg, pin->getLogicValue(), program, element PASS_ENGINE_PARAMETER_SUFFIX);
 		if (pin->isInitialized() && value != pin->getLogicValue()) {
+			if (program.isValid()) {
+				// compiled program keeps no log, interpreter run is only needed once the pin changes
+				calc.evaluate(msg, pin->getLogicValue(), element PASS_ENGINE_PARAMETER_SUFFIX);
+			}
 
 			for (int i = 0;i < calc.currentCalculationLogPosition;i++) {
 				efiPrintf("calc %d: action %s value %.2f", i, action2String(calc.calcLogAction[i]), calc.calcLogValue[i]);
@@ -445,12 +484,13 @@ static void setFsioFrequency(int index, int frequency) {
 static bool updateValueOrWarning(int humanIndex, const char *msg, float *value DECLARE_ENGINE_PARAMETER_SUFFIX) {
 	int fsioIndex = humanIndex - 1;
 	LEElement * element = state.fsioLogics[fsioIndex];
+	const FsioProgram &program = state.fsioPrograms[fsioIndex];
 	if (element == NULL) {
 		warning(CUSTOM_FSIO_INVALID_EXPRESSION, "invalid expression for %s", msg);
 		return false;
 	} else {
 		float beforeValue = *value;
-		*value = calc.evaluate(msg, beforeValue, element PASS_ENGINE_PARAMETER_SUFFIX);
+		*value = evaluateLogic(msg, beforeValue, program, element PASS_ENGINE_PARAMETER_SUFFIX);
 		// floating '==' comparison without EPS seems fine here
 		return (beforeValue != *value);
 	}
@@ -470,14 +510,14 @@ void runFsio(DECLARE_ENGINE_PARAMETER_SIGNATURE) {
 
 #if EFI_FUEL_PUMP
 	if (isBrainPinValid(CONFIG(fuelPumpPin))) {
-		setPinState("pump", &enginePins.fuelPumpRelay, fuelPumpLogic PASS_ENGINE_PARAMETER_SUFFIX);
+		setPinState("pump", &enginePins.fuelPumpRelay, fuelPumpProgram, fuelPumpLogic PASS_ENGINE_PARAMETER_SUFFIX);
 	}
 #endif /* EFI_FUEL_PUMP */
 
 #if EFI_MAIN_RELAY_CONTROL
 	if (isBrainPinValid(CONFIG(mainRelayPin)))
 		// the MAIN_RELAY_LOGIC calls engine->isInShutdownMode()
-		setPinState("main_relay", &enginePins.mainRelay, mainRelayLogic PASS_ENGINE_PARAMETER_SUFFIX);
+		setPinState("main_relay", &enginePins.mainRelay, mainRelayProgram, mainRelayLogic PASS_ENGINE_PARAMETER_SUFFIX);
 #else /* EFI_MAIN_RELAY_CONTROL */
 	/**
 	 * main relay is always on if ECU is on, that's a good enough initial implementation
@@ -487,7 +527,7 @@ void runFsio(DECLARE_ENGINE_PARAMETER_SIGNATURE) {
 #endif /* EFI_MAIN_RELAY_CONTROL */
 
 	if (isBrainPinValid(CONFIG(starterRelayDisablePin)))
-		setPinState("starter_relay", &enginePins.starterRelayDisable, starterRelayDisableLogic PASS_ENGINE_PARAMETER_SUFFIX);
+		setPinState("starter_relay", &enginePins.starterRelayDisable, starterRelayDisableProgram, starterRelayDisableLogic PASS_ENGINE_PARAMETER_SUFFIX);
 
 	/**
 	 * o2 heater is off during cranking
@@ -678,18 +718,24 @@ void initFsioImpl(DECLARE_ENGINE_PARAMETER_SIGNATURE) {
 #if EFI_UNIT_TEST
 	// only unit test needs this
 	sysPool.reset();
+	sysCodePool.reset();
 #endif
 
 #if EFI_FUEL_PUMP
 	fuelPumpLogic = sysPool.parseExpression(FUEL_PUMP_LOGIC);
+	fuelPumpProgram = sysCodePool.compile(fuelPumpLogic);
 #endif /* EFI_FUEL_PUMP */
 
 #if EFI_MAIN_RELAY_CONTROL
-	if (isBrainPinValid(CONFIG(mainRelayPin)))
+	if (isBrainPinValid(CONFIG(mainRelayPin))) {
 		mainRelayLogic = sysPool.parseExpression(MAIN_RELAY_LOGIC);
+		mainRelayProgram = sysCodePool.compile(mainRelayLogic);
+	}
 #endif /* EFI_MAIN_RELAY_CONTROL */
-	if (isBrainPinValid(CONFIG(starterRelayDisablePin)))
+	if (isBrainPinValid(CONFIG(starterRelayDisablePin))) {
 		starterRelayDisableLogic = sysPool.parseExpression(STARTER_RELAY_LOGIC);
+		starterRelayDisableProgram = sysCodePool.compile(starterRelayDisableLogic);
+	}
 
 #if EFI_PROD_CODE
 	for (int i = 0; i < FSIO_COMMAND_COUNT; i++) {
@@ -126,6 +126,7 @@ bool FuelSchedule::addFuelEventsForCylinder(int i  DECLARE_ENGINE_PARAMETER_SUFF
 	efiAssert(CUSTOM_ERR_ASSERT, !cisnan(angle), "findAngle#3", false);
 	assertAngleRange(angle, "findAngle#a33", CUSTOM_ERR_6544);
 	ev->injectionStart.setAngle(angle PASS_ENGINE_PARAMETER_SUFFIX);
+	toothPlan.setTooth(i, ev->injectionStart.triggerEventIndex);
 #if EFI_UNIT_TEST
 	printf("registerInjectionEvent angle=%.2f trgIndex=%d inj %d\r\n", angle, ev->injectionStart.triggerEventIndex, injectorIndex);
 #endif
@@ -133,6 +134,8 @@ bool FuelSchedule::addFuelEventsForCylinder(int i  DECLARE_ENGINE_PARAMETER_SUFF
 }
 
 void FuelSchedule::addFuelEvents(DECLARE_ENGINE_PARAMETER_SIGNATURE) {
+	toothPlan.clear();
+
 	for (size_t cylinderIndex = 0; cylinderIndex < CONFIG(specs.cylindersCount); cylinderIndex++) {
 		InjectionEvent *ev = &elements[cylinderIndex];
 		ev->ownIndex = cylinderIndex;  // todo: is this assignment needed here? we now initialize in constructor
@@ -153,7 +156,11 @@ void FuelSchedule::onTriggerTooth(size_t toothIndex, int rpm, efitick_t nowNt DE
 		return;
 	}
 
-	for (size_t i = 0; i < CONFIG(specs.cylindersCount); i++) {
+	// only cylinders which start injection on this tooth
+	cylinder_mask_t cylinders = toothPlan.getCylinders(toothIndex) & ((1 << CONFIG(specs.cylindersCount)) - 1);
+	while (cylinders) {
+		int i = __builtin_ctz(cylinders);
+		cylinders &= cylinders - 1;
 		elements[i].onTriggerTooth(toothIndex, rpm, nowNt);
 	}
 }
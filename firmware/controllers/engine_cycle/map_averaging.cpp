@@ -37,6 +37,7 @@
 #include "engine.h"
 #include "engine_math.h"
 #include "perf_trace.h"
+#include "spark_logic.h"
 
 #if EFI_SENSOR_CHART
 #include "sensor_chart.h"
@@ -95,10 +96,17 @@ static float currentPressure = NO_VALUE_YET;
 EXTERN_ENGINE;
 
 /**
- * here we have averaging start and averaging end points for each cylinder
+ * Averaging window of one cylinder. Both start and end are anchored to their closest trigger tooth,
+ * same as spark, so that only the angle between that tooth and the event is RPM-predicted.
  */
-static scheduling_s startTimers[MAX_CYLINDER_COUNT][2];
-static scheduling_s endTimers[MAX_CYLINDER_COUNT][2];
+struct MapAveragingWindow {
+	AngleBasedEvent start;
+	AngleBasedEvent end;
+	int cylinderIndex;
+	DECLARE_ENGINE_PTR;
+};
+
+static MapAveragingWindow windows[MAX_CYLINDER_COUNT];
 
 /**
  * that's a performance optimization: let's not bother averaging
@@ -108,7 +116,7 @@ static bool isAveraging = false;
 
 static void endAveraging(void *arg);
 
-static void startAveraging(scheduling_s *endAveragingScheduling) {
+static void startAveraging(MapAveragingWindow *window) {
 	efiAssertVoid(CUSTOM_ERR_6649, getCurrentRemainingStack() > 128, "lowstck#9");
 
 	{
@@ -120,14 +128,25 @@ static void startAveraging(scheduling_s *endAveragingScheduling) {
 	}
 
 #if EFI_UNIT_TEST
-	Engine *engine = endAveragingScheduling->engine;
+	Engine *engine = window->engine;
 	EXPAND_Engine;
 #endif
 
 	mapAveragingPin.setHigh();
 
-	scheduleByAngle(endAveragingScheduling, getTimeNowNt(), ENGINE(engineState.mapAveragingDuration),
-		endAveraging PASS_ENGINE_PARAMETER_SUFFIX);
+	angle_t samplingEnd = ENGINE(engineState.mapAveragingEnd[window->cylinderIndex]);
+	event_trigger_position_s endPosition;
+	endPosition.setAngle(samplingEnd PASS_ENGINE_PARAMETER_SUFFIX);
+
+	if (endPosition.triggerEventIndex == window->start.position.triggerEventIndex
+			&& endPosition.angleOffsetFromTriggerEvent > window->start.position.angleOffsetFromTriggerEvent) {
+		// whole window is between two teeth - queueing the end would postpone it for a whole engine cycle
+		scheduleByAngle(&window->end.scheduling, getTimeNowNt(), ENGINE(engineState.mapAveragingDuration),
+			endAveraging PASS_ENGINE_PARAMETER_SUFFIX);
+	} else {
+		scheduleOrQueue(&window->end, TRIGGER_EVENT_UNDEFINED, getTimeNowNt(), samplingEnd,
+			endAveraging PASS_ENGINE_PARAMETER_SUFFIX);
+	}
 }
 
 #if HAL_USE_ADC
@@ -234,8 +253,13 @@ void refreshMapAveragingPreCalc(DECLARE_ENGINE_PARAMETER_SIGNATURE) {
 		angle_t start = interpolate2d(rpm, c->samplingAngleBins, c->samplingAngle);
 		efiAssertVoid(CUSTOM_ERR_MAP_START_ASSERT, !cisnan(start), "start");
 
-		angle_t offsetAngle = ENGINE(triggerCentral.triggerFormDetails).eventAngles[CONFIG(mapAveragingSchedulingAtIndex)];
-		efiAssertVoid(CUSTOM_ERR_MAP_AVG_OFFSET, !cisnan(offsetAngle), "offsetAngle");
+		angle_t duration = interpolate2d(rpm, c->samplingWindowBins, c->samplingWindow);
+		assertAngleRange(duration, "samplingDuration", CUSTOM_ERR_6563);
+		if (duration <= 0) {
+			warning(CUSTOM_MAP_ANGLE_PARAM, "map sampling angle should be positive");
+			engine->engineState.mapAveragingDuration = NAN;
+			return;
+		}
 
 		for (size_t i = 0; i < engineConfiguration->specs.cylindersCount; i++) {
 			angle_t cylinderOffset = getEngineCycle(engine->getOperationMode(PASS_ENGINE_PARAMETER_SIGNATURE)) * i / engineConfiguration->specs.cylindersCount;
@@ -243,14 +267,19 @@ void refreshMapAveragingPreCalc(DECLARE_ENGINE_PARAMETER_SIGNATURE) {
 			// part of this formula related to specific cylinder offset is never changing - we can
 			// move the loop into start-up calculation and not have this loop as part of periodic calculation
 			// todo: change the logic as described above in order to reduce periodic CPU usage?
-			float cylinderStart = start + cylinderOffset - offsetAngle + tdcPosition();
+			float cylinderStart = start + cylinderOffset;
 			fixAngle(cylinderStart, "cylinderStart", CUSTOM_ERR_6562);
 			engine->engineState.mapAveragingStart[i] = cylinderStart;
+
+			float cylinderEnd = cylinderStart + duration;
+			fixAngle(cylinderEnd, "samplingEnd", CUSTOM_ERR_6563);
+			engine->engineState.mapAveragingEnd[i] = cylinderEnd;
 		}
-		engine->engineState.mapAveragingDuration = interpolate2d(rpm, c->samplingWindowBins, c->samplingWindow);
+		engine->engineState.mapAveragingDuration = duration;
 	} else {
 		for (size_t i = 0; i < engineConfiguration->specs.cylindersCount; i++) {
 			engine->engineState.mapAveragingStart[i] = NAN;
+			engine->engineState.mapAveragingEnd[i] = NAN;
 		}
 		engine->engineState.mapAveragingDuration = NAN;
 	}
@@ -258,7 +287,8 @@ void refreshMapAveragingPreCalc(DECLARE_ENGINE_PARAMETER_SIGNATURE) {
 }
 
 /**
- * Shaft Position callback used to schedule start and end of MAP averaging
+ * Shaft Position callback used to queue start of MAP averaging for each cylinder, once per engine cycle.
+ * Windows are then started and ended from their closest trigger tooth, see scheduleOrQueue
  */
 void mapAveragingTriggerCallback(
 		uint32_t index, efitick_t edgeTimestamp DECLARE_ENGINE_PARAMETER_SUFFIX) {
@@ -281,44 +311,23 @@ void mapAveragingTriggerCallback(
 	measurementsPerRevolution = measurementsPerRevolutionCounter;
 	measurementsPerRevolutionCounter = 0;
 
-	// todo: this could be pre-calculated
-	int samplingCount = CONFIG(measureMapOnlyInOneCylinder) ? 1 : engineConfiguration->specs.cylindersCount;
-
-	for (int i = 0; i < samplingCount; i++) {
-		angle_t samplingStart = ENGINE(engineState.mapAveragingStart[i]);
+	if (cisnan(ENGINE(engineState.mapAveragingDuration))) {
+		// not prepared yet or invalid configuration, see refreshMapAveragingPreCalc
+		return;
+	}
 
-		angle_t samplingDuration = ENGINE(engineState.mapAveragingDuration);
-		// todo: this assertion could be moved out of trigger handler
-		assertAngleRange(samplingDuration, "samplingDuration", CUSTOM_ERR_6563);
-		if (samplingDuration <= 0) {
-			warning(CUSTOM_MAP_ANGLE_PARAM, "map sampling angle should be positive");
-			return;
-		}
+	int samplingCount = CONFIG(measureMapOnlyInOneCylinder) ? 1 : engineConfiguration->specs.cylindersCount;
 
-		angle_t samplingEnd = samplingStart + samplingDuration;
+	INJECT_ENGINE_REFERENCE(&mapAveragingPin);
 
-		if (cisnan(samplingEnd)) {
-			// todo: when would this happen?
-			warning(CUSTOM_ERR_6549, "no map angles");
-			return;
-		}
+	for (int i = 0; i < samplingCount; i++) {
+		MapAveragingWindow *window = &windows[i];
+		window->cylinderIndex = i;
+		INJECT_ENGINE_REFERENCE(window);
 
-		// todo: pre-calculate samplingEnd for each cylinder
-		fixAngle(samplingEnd, "samplingEnd", CUSTOM_ERR_6563);
-		// only if value is already prepared
-		int structIndex = getRevolutionCounter() % 2;
-
-		scheduling_s *starTimer = &startTimers[i][structIndex];
-		scheduling_s *endTimer = &endTimers[i][structIndex];
-		INJECT_ENGINE_REFERENCE(&mapAveragingPin);
-		INJECT_ENGINE_REFERENCE(starTimer);
-		INJECT_ENGINE_REFERENCE(endTimer);
-
-		// at the moment we schedule based on time prediction based on current RPM and angle
-		// we are loosing precision in case of changing RPM - the further away is the event the worse is precision
-		// todo: schedule this based on closest trigger event, same as ignition works
-		scheduleByAngle(starTimer, edgeTimestamp, samplingStart,
-				{ startAveraging, endTimer } PASS_ENGINE_PARAMETER_SUFFIX);
+		// window which is still pending from previous cycle stays queued
+		scheduleOrQueue(&window->start, index, edgeTimestamp, ENGINE(engineState.mapAveragingStart[i]),
+				{ startAveraging, window } PASS_ENGINE_PARAMETER_SUFFIX);
 	}
 #endif
 }
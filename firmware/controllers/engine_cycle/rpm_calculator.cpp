@@ -396,19 +396,36 @@ void initRpmCalculator(DECLARE_ENGINE_PARAMETER_SIGNATURE) {
  * The callback would be executed once after the duration of time which
  * it takes the crankshaft to rotate to the specified angle.
  */
-efitick_t scheduleByAngle(scheduling_s *timer, efitick_t edgeTimestamp, angle_t angle,
-		action_s action DECLARE_ENGINE_PARAMETER_SUFFIX) {
+static efitick_t getAngleTimestamp(efitick_t edgeTimestamp, angle_t angle DECLARE_ENGINE_PARAMETER_SUFFIX) {
 	float delayUs = ENGINE(rpmCalculator.oneDegreeUs) * angle;
 
     // 'delayNt' is below 10 seconds here so we use 32 bit type for performance reasons
 	int32_t delayNt = USF2NT(delayUs);
-	efitime_t delayedTime = edgeTimestamp + delayNt;
+	return edgeTimestamp + delayNt;
+}
+
+efitick_t scheduleByAngle(scheduling_s *timer, efitick_t edgeTimestamp, angle_t angle,
+		action_s action DECLARE_ENGINE_PARAMETER_SUFFIX) {
+	efitime_t delayedTime = getAngleTimestamp(edgeTimestamp, angle PASS_ENGINE_PARAMETER_SUFFIX);
 
 	ENGINE(executor.scheduleByTimestampNt(timer, delayedTime, action));
 
 	return delayedTime;
 }
 
+/**
+ * Same as scheduleByAngle but if 'timer' is still pending it is moved to the new time
+ * instead of keeping the older estimate.
+ */
+efitick_t rescheduleByAngle(scheduling_s *timer, efitick_t edgeTimestamp, angle_t angle,
+		action_s action DECLARE_ENGINE_PARAMETER_SUFFIX) {
+	efitime_t delayedTime = getAngleTimestamp(edgeTimestamp, angle PASS_ENGINE_PARAMETER_SUFFIX);
+
+	ENGINE(executor.rescheduleByTimestampNt(timer, delayedTime, action));
+
+	return delayedTime;
+}
+
 #else
 RpmCalculator::RpmCalculator() {
 
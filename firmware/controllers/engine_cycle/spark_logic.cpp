@@ -10,7 +10,6 @@
 #include "os_access.h"
 #include "engine_math.h"
 
-#include "utlist.h"
 #include "event_queue.h"
 #include "perf_trace.h"
 #include "tooth_logger.h"
@@ -119,6 +118,7 @@ static void prepareCylinderIgnitionSchedule(angle_t dwellAngleDuration, floatms_
 	efiAssertVoid(CUSTOM_ERR_6590, !cisnan(dwellStartAngle), "findAngle#5");
 	assertAngleRange(dwellStartAngle, "findAngle#a6", CUSTOM_ERR_6550);
 	event->dwellPosition.setAngle(dwellStartAngle PASS_ENGINE_PARAMETER_SUFFIX);
+	ENGINE(ignitionEvents.toothPlan).setTooth(event->cylinderIndex, event->dwellPosition.triggerEventIndex);
 
 #if FUEL_MATH_EXTREME_LOGGING
 	if (printFuelDebug) {
@@ -294,10 +294,6 @@ void turnSparkPinHigh(IgnitionEvent *event) {
 	}
 }
 
-static bool assertNotInIgnitionList(AngleBasedEvent *head, AngleBasedEvent *element) {
-	assertNotInListMethodBody(AngleBasedEvent, head, element, nextToothEvent)
-}
-
 /**
  * @return true if event corresponds to current tooth and was time-based scheduler
  *         false if event was put into queue for scheduling at a later tooth
@@ -319,10 +315,11 @@ bool scheduleOrQueue(AngleBasedEvent *event,
 	if (trgEventIndex != TRIGGER_EVENT_UNDEFINED && event->position.triggerEventIndex == trgEventIndex) {
 		/**
 		 * Spark should be fired before the next trigger event - time-based delay is best precision possible
+		 * If this event is still pending from an earlier estimate we move it here, fresh tooth timestamp is more accurate.
 		 */
 		scheduling_s * sDown = &event->scheduling;
 
-		scheduleByAngle(
+		rescheduleByAngle(
 			sDown,
 			edgeTimestamp,
 			event->position.angleOffsetFromTriggerEvent,
@@ -336,13 +333,10 @@ bool scheduleOrQueue(AngleBasedEvent *event,
 		/**
 		 * Spark should be scheduled in relation to some future trigger event, this way we get better firing precision
 		 */
-		bool isPending = assertNotInIgnitionList(ENGINE(angleBasedEventsHead), event);
-		if (isPending) {
+		if (!ENGINE(angleBasedEvents).queue(event)) {
 #if SPARK_EXTREME_LOGGING
 			efiPrintf("isPending thus not adding to queue index=%d rev=%d now=%d", trgEventIndex, getRevolutionCounter(), (int)getTimeNowUs());
 #endif /* SPARK_EXTREME_LOGGING */
-		} else {
-			LL_APPEND2(ENGINE(angleBasedEventsHead), event, nextToothEvent);
 		}
 		return false;
 	}
@@ -439,6 +433,8 @@ void initializeIgnitionActions(DECLARE_ENGINE_PARAMETER_SIGNATURE) {
 	}
 	efiAssertVoid(CUSTOM_ERR_6592, engineConfiguration->specs.cylindersCount > 0, "cylindersCount");
 
+	list->toothPlan.clear();
+
 	for (size_t cylinderIndex = 0; cylinderIndex < CONFIG(specs.cylindersCount); cylinderIndex++) {
 		list->elements[cylinderIndex].cylinderIndex = cylinderIndex;
 #if EFI_UNIT_TEST
@@ -480,28 +476,27 @@ static void prepareIgnitionSchedule(DECLARE_ENGINE_PARAMETER_SIGNATURE) {
 
 
 static void scheduleAllSparkEventsUntilNextTriggerTooth(uint32_t trgEventIndex, efitick_t edgeTimestamp DECLARE_ENGINE_PARAMETER_SUFFIX) {
-	AngleBasedEvent *current, *tmp;
+	ScopePerf perf(PE::ScheduleAngleBasedEvents);
 
-	LL_FOREACH_SAFE2(ENGINE(angleBasedEventsHead), current, tmp, nextToothEvent)
-	{
-		if (current->position.triggerEventIndex == trgEventIndex) {
-			// time to fire a spark which was scheduled previously
-			LL_DELETE2(ENGINE(angleBasedEventsHead), current, nextToothEvent);
+	AngleBasedEvent *current;
 
-			scheduling_s * sDown = &current->scheduling;
+	// only events queued for this very tooth are looked at
+	while ((current = ENGINE(angleBasedEvents).takeForTooth(trgEventIndex))) {
+		// time to fire a spark which was scheduled previously
+		scheduling_s * sDown = &current->scheduling;
 
 #if SPARK_EXTREME_LOGGING
 	efiPrintf("time to invoke ind=%d %d %d", trgEventIndex, getRevolutionCounter(), (int)getTimeNowUs());
 #endif /* SPARK_EXTREME_LOGGING */
 
-			scheduleByAngle(
-				sDown,
-				edgeTimestamp,
-				current->position.angleOffsetFromTriggerEvent,
-				current->action
-				PASS_ENGINE_PARAMETER_SUFFIX
-			);
-		}
+		// same as in scheduleOrQueue: this tooth is the most accurate reference we will get
+		rescheduleByAngle(
+			sDown,
+			edgeTimestamp,
+			current->position.angleOffsetFromTriggerEvent,
+			current->action
+			PASS_ENGINE_PARAMETER_SUFFIX
+		);
 	}
 }
 
@@ -529,10 +524,16 @@ void onTriggerEventSparkLogic(bool limitedSpark, uint32_t trgEventIndex, int rpm
 
 //	scheduleSimpleMsg(&logger, "eventId spark ", eventIndex);
 	if (ENGINE(ignitionEvents.isReady)) {
-		for (size_t i = 0; i < CONFIG(specs.cylindersCount); i++) {
+		// only cylinders which start dwell on this tooth
+		cylinder_mask_t cylinders = ENGINE(ignitionEvents.toothPlan).getCylinders(trgEventIndex) & ((1 << CONFIG(specs.cylindersCount)) - 1);
+		while (cylinders) {
+			int i = __builtin_ctz(cylinders);
+			cylinders &= cylinders - 1;
 			IgnitionEvent *event = &ENGINE(ignitionEvents.elements[i]);
-			if (event->dwellPosition.triggerEventIndex != trgEventIndex)
+			if (event->dwellPosition.triggerEventIndex != trgEventIndex) {
+				// moved by a callback while we were handling previous cylinder
 				continue;
+			}
 			handleSparkEvent(limitedSpark, trgEventIndex, event, rpm, edgeTimestamp PASS_ENGINE_PARAMETER_SUFFIX);
 		}
 	}
@@ -0,0 +1,358 @@
+/**
+ * @file    flash_journal.cpp
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#include "flash_journal.h"
+#include "crc.h"
+
+#include <cstring>
+
+#define JOURNAL_BASE_MAGIC 0x4553414A
+#define JOURNAL_DELTA_MAGIC 0x544C444A
+
+struct ChunkHeader {
+	uint16_t offset;
+	uint16_t length;
+};
+
+#define MAX_CHUNK_LENGTH 0xFFFF
+
+static size_t alignToBlock(size_t size) {
+	return (size + FLASH_JOURNAL_BLOCK_SIZE - 1) / FLASH_JOURNAL_BLOCK_SIZE * FLASH_JOURNAL_BLOCK_SIZE;
+}
+
+static bool isErased(const uint8_t* data, size_t size) {
+	for (size_t i = 0; i < size; i++) {
+		if (data[i] != 0xFF) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Collects a stream of bytes into whole blocks
+ */
+class BlockWriter {
+public:
+	BlockWriter(IFlashRegion& flash, size_t offset)
+		: m_flash(flash)
+		, m_offset(offset)
+	{
+	}
+
+	void append(const void* data, size_t size) {
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+		while (size > 0) {
+			size_t count = FLASH_JOURNAL_BLOCK_SIZE - m_count;
+			if (count > size) {
+				count = size;
+			}
+			memcpy(m_block + m_count, bytes, count);
+			m_count += count;
+			bytes += count;
+			size -= count;
+
+			if (m_count == FLASH_JOURNAL_BLOCK_SIZE) {
+				flush();
+			}
+		}
+	}
+
+	/**
+	 * @return false if any of the writes has failed
+	 */
+	bool finish() {
+		if (m_count > 0) {
+			// leave the rest of the block erased
+			memset(m_block + m_count, 0xFF, FLASH_JOURNAL_BLOCK_SIZE - m_count);
+			flush();
+		}
+		return m_isOk;
+	}
+
+private:
+	void flush() {
+		if (m_isOk) {
+			m_isOk = m_flash.write(m_offset, m_block, FLASH_JOURNAL_BLOCK_SIZE);
+		}
+		m_offset += FLASH_JOURNAL_BLOCK_SIZE;
+		m_count = 0;
+	}
+
+	IFlashRegion& m_flash;
+	size_t m_offset;
+	uint8_t m_block[FLASH_JOURNAL_BLOCK_SIZE];
+	size_t m_count = 0;
+	bool m_isOk = true;
+};
+
+FlashJournal::FlashJournal(IFlashRegion& flash, size_t imageSize, size_t journalSize)
+	: m_flash(flash)
+	, m_imageSize(imageSize)
+	, m_journalStart(alignToBlock(imageSize))
+	, m_journalSize(journalSize)
+{
+}
+
+size_t FlashJournal::getRegionSize() const {
+	return m_journalStart + m_journalSize;
+}
+
+void FlashJournal::invalidate() {
+	m_isScanned = true;
+	m_needsCompaction = true;
+	m_lastDelta = 0;
+}
+
+/**
+ * Chunks of the image which differ from the copy in flash. Unchanged gaps shorter than a chunk header
+ * are included into the chunk, that's cheaper than one more chunk.
+ */
+template<typename TCallback>
+void FlashJournal::forEachChangedChunk(const uint8_t* image, TCallback onChunk) {
+	uint8_t flashCopy[FLASH_JOURNAL_BLOCK_SIZE];
+	bool hasChunk = false;
+	size_t chunkStart = 0;
+	size_t chunkEnd = 0;
+
+	for (size_t offset = 0; offset < m_imageSize; offset += sizeof(flashCopy)) {
+		size_t size = m_imageSize - offset;
+		if (size > sizeof(flashCopy)) {
+			size = sizeof(flashCopy);
+		}
+		m_flash.read(offset, flashCopy, size);
+
+		for (size_t i = 0; i < size; i++) {
+			size_t index = offset + i;
+			if (flashCopy[i] == image[index]) {
+				continue;
+			}
+
+			if (hasChunk && index - chunkEnd < sizeof(ChunkHeader) && index + 1 - chunkStart <= MAX_CHUNK_LENGTH) {
+				chunkEnd = index + 1;
+				continue;
+			}
+
+			if (hasChunk) {
+				onChunk(chunkStart, chunkEnd - chunkStart);
+			}
+			hasChunk = true;
+			chunkStart = index;
+			chunkEnd = index + 1;
+		}
+	}
+
+	if (hasChunk) {
+		onChunk(chunkStart, chunkEnd - chunkStart);
+	}
+}
+
+bool FlashJournal::isBaseValid() {
+	RecordHeader header;
+	m_flash.read(m_journalStart, reinterpret_cast<uint8_t*>(&header), sizeof(header));
+	if (header.magic != JOURNAL_BASE_MAGIC || header.payloadSize != m_imageSize) {
+		return false;
+	}
+
+	uint8_t buffer[FLASH_JOURNAL_BLOCK_SIZE];
+	uint32_t crc = 0;
+	for (size_t offset = 0; offset < m_imageSize; offset += sizeof(buffer)) {
+		size_t size = m_imageSize - offset;
+		if (size > sizeof(buffer)) {
+			size = sizeof(buffer);
+		}
+		m_flash.read(offset, buffer, size);
+		crc = crc32inc(buffer, crc, size);
+	}
+	return crc == header.crc;
+}
+
+void FlashJournal::scan() {
+	m_isScanned = true;
+	m_used = 0;
+	m_lastDelta = 0;
+
+	if (!isBaseValid()) {
+		// older firmware, power loss while rewriting the region or blank flash
+		m_needsCompaction = true;
+		return;
+	}
+	m_needsCompaction = false;
+
+	size_t position = alignToBlock(sizeof(RecordHeader));
+	m_used = position;
+
+	while (position + FLASH_JOURNAL_BLOCK_SIZE <= m_journalSize) {
+		RecordHeader header;
+		m_flash.read(m_journalStart + position, reinterpret_cast<uint8_t*>(&header), sizeof(header));
+		if (isErased(reinterpret_cast<uint8_t*>(&header), sizeof(header))) {
+			break;
+		}
+
+		bool isValid = header.magic == JOURNAL_DELTA_MAGIC
+			&& header.payloadSize <= m_journalSize - position - sizeof(header);
+
+		if (isValid) {
+			uint8_t buffer[FLASH_JOURNAL_BLOCK_SIZE];
+			uint32_t crc = 0;
+			size_t payloadStart = m_journalStart + position + sizeof(header);
+			for (size_t offset = 0; offset < header.payloadSize; offset += sizeof(buffer)) {
+				size_t size = header.payloadSize - offset;
+				if (size > sizeof(buffer)) {
+					size = sizeof(buffer);
+				}
+				m_flash.read(payloadStart + offset, buffer, size);
+				crc = crc32inc(buffer, crc, size);
+			}
+			isValid = crc == header.crc;
+		}
+
+		if (!isValid) {
+			// torn by a power loss, nothing could be appended after it
+			m_needsCompaction = true;
+			break;
+		}
+
+		m_lastDelta = position;
+		m_lastDeltaSize = header.payloadSize;
+		position += alignToBlock(sizeof(header) + header.payloadSize);
+		m_used = position;
+	}
+}
+
+void FlashJournal::read(uint8_t* image) {
+	m_flash.read(0, image, m_imageSize);
+
+	if (!m_isScanned) {
+		scan();
+	}
+
+	if (!m_lastDelta) {
+		return;
+	}
+
+	size_t position = m_journalStart + m_lastDelta + sizeof(RecordHeader);
+	size_t end = position + m_lastDeltaSize;
+	while (position + sizeof(ChunkHeader) <= end) {
+		ChunkHeader chunk;
+		m_flash.read(position, reinterpret_cast<uint8_t*>(&chunk), sizeof(chunk));
+		position += sizeof(chunk);
+
+		if (chunk.offset + chunk.length > m_imageSize || position + chunk.length > end) {
+			// CRC has matched so we never get here
+			return;
+		}
+		m_flash.read(position, image + chunk.offset, chunk.length);
+		position += chunk.length;
+	}
+}
+
+bool FlashJournal::appendRecord(uint32_t magic, uint32_t payloadSize, uint32_t crc, const uint8_t* image) {
+	RecordHeader header = { magic, payloadSize, crc };
+
+	size_t position = m_used;
+	BlockWriter writer(m_flash, m_journalStart + position);
+	writer.append(&header, sizeof(header));
+
+	if (magic == JOURNAL_DELTA_MAGIC) {
+		forEachChangedChunk(image, [&](size_t offset, size_t length) {
+			ChunkHeader chunk = { (uint16_t)offset, (uint16_t)length };
+			writer.append(&chunk, sizeof(chunk));
+			writer.append(image + offset, length);
+		});
+	}
+
+	if (!writer.finish()) {
+		m_needsCompaction = true;
+		return false;
+	}
+
+	m_used = position + alignToBlock(sizeof(header) + (magic == JOURNAL_DELTA_MAGIC ? payloadSize : 0));
+	if (magic == JOURNAL_DELTA_MAGIC) {
+		m_lastDelta = position;
+		m_lastDeltaSize = payloadSize;
+		m_deltaCount++;
+	}
+	return true;
+}
+
+bool FlashJournal::compact(const uint8_t* image) {
+	m_compactionCount++;
+	m_isScanned = true;
+	m_used = 0;
+	m_lastDelta = 0;
+	// until the base record is in place
+	m_needsCompaction = true;
+
+	if (!m_flash.erase(getRegionSize())) {
+		return false;
+	}
+
+	BlockWriter writer(m_flash, 0);
+	writer.append(image, m_imageSize);
+	if (!writer.finish()) {
+		return false;
+	}
+
+	// base record goes last, it tells that the image is complete
+	if (!appendRecord(JOURNAL_BASE_MAGIC, m_imageSize, crc32(image, m_imageSize), image)) {
+		return false;
+	}
+	m_needsCompaction = false;
+	return true;
+}
+
+bool FlashJournal::write(const uint8_t* image) {
+	if (!m_isScanned) {
+		scan();
+	}
+	if (m_needsCompaction) {
+		return compact(image);
+	}
+
+	uint32_t payloadSize = 0;
+	uint32_t crc = 0;
+	// does the last delta already hold exactly these chunks?
+	bool isSameAsLast = m_lastDelta != 0;
+	size_t lastPosition = m_journalStart + m_lastDelta + sizeof(RecordHeader);
+
+	forEachChangedChunk(image, [&](size_t offset, size_t length) {
+		ChunkHeader chunk = { (uint16_t)offset, (uint16_t)length };
+		crc = crc32inc(&chunk, crc, sizeof(chunk));
+		crc = crc32inc(image + offset, crc, length);
+
+		if (isSameAsLast && payloadSize + sizeof(chunk) + length <= m_lastDeltaSize) {
+			uint8_t buffer[FLASH_JOURNAL_BLOCK_SIZE];
+			m_flash.read(lastPosition + payloadSize, buffer, sizeof(chunk));
+			isSameAsLast = memcmp(buffer, &chunk, sizeof(chunk)) == 0;
+
+			for (size_t i = 0; isSameAsLast && i < length; i += sizeof(buffer)) {
+				size_t size = length - i;
+				if (size > sizeof(buffer)) {
+					size = sizeof(buffer);
+				}
+				m_flash.read(lastPosition + payloadSize + sizeof(chunk) + i, buffer, size);
+				isSameAsLast = memcmp(buffer, image + offset + i, size) == 0;
+			}
+		} else {
+			isSameAsLast = false;
+		}
+
+		payloadSize += sizeof(chunk) + length;
+	});
+
+	if (m_lastDelta ? (isSameAsLast && payloadSize == m_lastDeltaSize) : payloadSize == 0) {
+		// flash already holds this image
+		return true;
+	}
+
+	if (m_used + alignToBlock(sizeof(RecordHeader) + payloadSize) > m_journalSize) {
+		return compact(image);
+	}
+
+	return appendRecord(JOURNAL_DELTA_MAGIC, payloadSize, crc, image);
+}
@@ -0,0 +1,116 @@
+/**
+ * @file    flash_journal.h
+ * @brief	Incremental persistence of an image into internal flash
+ *
+ * Flash region holds a full copy of the image followed by a journal:
+ *
+ *   [image][base record][delta record][delta record]...[erased]
+ *
+ * Base record is written after the image once the whole image is in flash, it carries CRC of the image.
+ * Each delta record holds all chunks (offset, length, data) which differ between the image in flash and
+ * the image at the moment of the write, together with CRC of its payload. Only the last complete delta
+ * is applied on read, so a record torn by a power loss simply falls back to the previous one.
+ *
+ * Writing a delta takes a few milliseconds. Region is erased and rewritten only once the journal is full,
+ * after a torn record or if the base record does not match the image.
+ *
+ * All writes are done in FLASH_JOURNAL_BLOCK_SIZE units, each block is written only once after erase.
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// flash word of stm32h7, any other chip is fine with this
+#define FLASH_JOURNAL_BLOCK_SIZE 32
+
+/**
+ * Flash area of one image copy together with its journal, offsets are relative to the start of the area
+ */
+class IFlashRegion {
+public:
+	/**
+	 * @return false if flash has reported an error
+	 */
+	virtual bool erase(size_t size) = 0;
+	virtual bool write(size_t offset, const uint8_t* data, size_t size) = 0;
+	virtual void read(size_t offset, uint8_t* data, size_t size) = 0;
+};
+
+class FlashJournal {
+public:
+	/**
+	 * @param imageSize should be below 64K, chunk offsets are 16 bit
+	 */
+	FlashJournal(IFlashRegion& flash, size_t imageSize, size_t journalSize);
+
+	/**
+	 * Reads the image and applies the last complete delta on top of it.
+	 * Image is read even if the base record is missing, which is the case for flash written by
+	 * older firmware, the caller is responsible for validating the content.
+	 */
+	void read(uint8_t* image);
+
+	/**
+	 * Appends a delta record, rewrites the whole region if that's not possible
+	 * @return false if flash has reported an error
+	 */
+	bool write(const uint8_t* image);
+
+	/**
+	 * Next write would rewrite the whole region, for example because the caller has found the image invalid
+	 */
+	void invalidate();
+
+	/**
+	 * Size of the region this journal needs
+	 */
+	size_t getRegionSize() const;
+
+	size_t getJournalUsed() const {
+		return m_used;
+	}
+
+	uint32_t getCompactionCount() const {
+		return m_compactionCount;
+	}
+
+	uint32_t getDeltaCount() const {
+		return m_deltaCount;
+	}
+
+private:
+	struct RecordHeader {
+		uint32_t magic;
+		uint32_t payloadSize;
+		uint32_t crc;
+	};
+
+	void scan();
+	bool isBaseValid();
+	bool compact(const uint8_t* image);
+	bool appendRecord(uint32_t magic, uint32_t payloadSize, uint32_t crc, const uint8_t* image);
+
+	template<typename TCallback>
+	void forEachChangedChunk(const uint8_t* image, TCallback onChunk);
+
+	IFlashRegion& m_flash;
+	const size_t m_imageSize;
+	const size_t m_journalStart;
+	const size_t m_journalSize;
+
+	bool m_isScanned = false;
+	bool m_needsCompaction = true;
+	// bytes of journal in use, base record included
+	size_t m_used = 0;
+	// position of the delta which is applied on read, 0 if there is none
+	size_t m_lastDelta = 0;
+	uint32_t m_lastDeltaSize = 0;
+
+	uint32_t m_compactionCount = 0;
+	uint32_t m_deltaCount = 0;
+};
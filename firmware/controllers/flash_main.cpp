@@ -24,6 +24,18 @@
 
 #include "engine_controller.h"
 
+#if EFI_FLASH_JOURNAL
+#include "flash_journal.h"
+
+#if EFI_ACTIVE_CONFIGURATION_IN_FLASH
+#error "activeConfiguration would point at the base copy which does not include journal"
+#endif
+
+#ifndef FLASH_JOURNAL_SIZE
+#define FLASH_JOURNAL_SIZE (64 * 1024)
+#endif
+#endif /* EFI_FLASH_JOURNAL */
+
 static bool needToWriteConfiguration = false;
 
 EXTERN_ENGINE;
@@ -43,6 +55,44 @@ crc_t flashStateCrc(persistent_config_container_s *state) {
 	return calc_crc((const crc_t*) &state->persistentConfiguration, sizeof(persistent_config_s));
 }
 
+#if EFI_FLASH_JOURNAL
+static_assert(sizeof(persistent_config_container_s) <= 0xFFFF, "journal chunk offsets are 16 bit");
+
+class InternalFlashRegion final : public IFlashRegion {
+public:
+	explicit InternalFlashRegion(uintptr_t (*getAddress)(void))
+		: m_getAddress(getAddress)
+	{
+	}
+
+	bool erase(size_t size) override {
+		auto err = intFlashErase(m_getAddress(), size);
+		if (FLASH_RETURN_SUCCESS != err) {
+			firmwareError(OBD_PCM_Processor_Fault, "Failed to erase flash at 0x%08x", m_getAddress());
+			return false;
+		}
+		return true;
+	}
+
+	bool write(size_t offset, const uint8_t* data, size_t size) override {
+		return intFlashWrite(m_getAddress() + offset, reinterpret_cast<const char*>(data), size) == FLASH_RETURN_SUCCESS;
+	}
+
+	void read(size_t offset, uint8_t* data, size_t size) override {
+		intFlashRead(m_getAddress() + offset, reinterpret_cast<char*>(data), size);
+	}
+
+private:
+	uintptr_t (*const m_getAddress)(void);
+};
+
+static InternalFlashRegion firstCopyRegion(getFlashAddrFirstCopy);
+static InternalFlashRegion secondCopyRegion(getFlashAddrSecondCopy);
+
+static FlashJournal firstCopyJournal(firstCopyRegion, sizeof(persistent_config_container_s), FLASH_JOURNAL_SIZE);
+static FlashJournal secondCopyJournal(secondCopyRegion, sizeof(persistent_config_container_s), FLASH_JOURNAL_SIZE);
+#endif /* EFI_FLASH_JOURNAL */
+
 #if EFI_FLASH_WRITE_THREAD
 chibios_rt::BinarySemaphore flashWriteSemaphore(/*taken =*/ true);
 
@@ -111,15 +161,27 @@ void writeToFlashNow(void) {
 	persistentState.version = FLASH_DATA_VERSION;
 	persistentState.value = flashStateCrc(&persistentState);
 
+#if EFI_FLASH_JOURNAL
+	// Append to both journals, a copy is erased only once its journal is full
+	const uint8_t* image = reinterpret_cast<const uint8_t*>(&persistentState);
+	bool result1 = firstCopyJournal.write(image);
+	bool result2 = secondCopyJournal.write(image);
+
+	bool isSuccess = result1 && result2;
+#else
 	// Flash two copies
 	int result1 = eraseAndFlashCopy(getFlashAddrFirstCopy(), persistentState);
 	int result2 = eraseAndFlashCopy(getFlashAddrSecondCopy(), persistentState);
 
 	// handle success/failure
 	bool isSuccess = (result1 == FLASH_RETURN_SUCCESS) && (result2 == FLASH_RETURN_SUCCESS);
+#endif /* EFI_FLASH_JOURNAL */
 
 	if (isSuccess) {
 		efiPrintf("FLASH_SUCCESS");
+#if EFI_FLASH_JOURNAL
+		efiPrintf("journal %d bytes used, %d rewrites", firstCopyJournal.getJournalUsed(), firstCopyJournal.getCompactionCount());
+#endif /* EFI_FLASH_JOURNAL */
 	} else {
 		efiPrintf("Flashing failed");
 	}
@@ -149,6 +211,28 @@ typedef enum {
 	PC_ERROR = 4
 } persisted_configuration_state_e;
 
+static persisted_configuration_state_e validatePersistentState() {
+	if (!isValidCrc(&persistentState)) {
+		return CRC_FAILED;
+	} else if (persistentState.version != FLASH_DATA_VERSION || persistentState.size != sizeof(persistentState)) {
+		return INCOMPATIBLE_VERSION;
+	} else {
+		return PC_OK;
+	}
+}
+
+#if EFI_FLASH_JOURNAL
+static persisted_configuration_state_e doReadConfiguration(FlashJournal& journal) {
+	journal.read(reinterpret_cast<uint8_t*>(&persistentState));
+
+	persisted_configuration_state_e result = validatePersistentState();
+	if (result != PC_OK) {
+		// do not append to something we could not read
+		journal.invalidate();
+	}
+	return result;
+}
+#else
 static persisted_configuration_state_e doReadConfiguration(flashaddr_t address) {
 	efiPrintf("readFromFlash %x", address);
 
@@ -159,14 +243,9 @@ static persisted_configuration_state_e doReadConfiguration(flashaddr_t address)
 
 	intFlashRead(address, (char *) &persistentState, sizeof(persistentState));
 
-	if (!isValidCrc(&persistentState)) {
-		return CRC_FAILED;
-	} else if (persistentState.version != FLASH_DATA_VERSION || persistentState.size != sizeof(persistentState)) {
-		return INCOMPATIBLE_VERSION;
-	} else {
-		return PC_OK;
-	}
+	return validatePersistentState();
 }
+#endif /* EFI_FLASH_JOURNAL */
 
 /**
  * this method could and should be executed before we have any
@@ -186,12 +265,23 @@ static persisted_configuration_state_e readConfiguration() {
 	persisted_configuration_state_e result = PC_OK;
 	resetConfigurationExt(DEFAULT_ENGINE_TYPE PASS_ENGINE_PARAMETER_SUFFIX);
 #else // HW_CHECK_MODE
+#if EFI_FLASH_JOURNAL
+	(void)firstCopyAddr;
+	(void)secondyCopyAddr;
+	persisted_configuration_state_e result = doReadConfiguration(firstCopyJournal);
+
+	if (result != PC_OK) {
+		efiPrintf("Reading second configuration copy");
+		result = doReadConfiguration(secondCopyJournal);
+	}
+#else
 	persisted_configuration_state_e result = doReadConfiguration(firstCopyAddr);
 
 	if (result != PC_OK) {
 		efiPrintf("Reading second configuration copy");
 		result = doReadConfiguration(secondyCopyAddr);
 	}
+#endif /* EFI_FLASH_JOURNAL */
 
 	if (result == CRC_FAILED) {
 	    // we are here on first boot on brand new chip
@@ -8,6 +8,7 @@
 
 #include "lua.hpp"
 #include "lua_hooks.h"
+#include "lua_bytecode.h"
 
 #define TAG "LUA "
 
@@ -15,6 +16,7 @@
 #include "ch.h"
 #include "engine.h"
 #include "tunerstudio_outputs.h"
+#include "slab_allocator.h"
 
 EXTERN_ENGINE;
 
@@ -22,39 +24,38 @@ EXTERN_ENGINE;
 
 static memory_heap_t heap;
 
-static int32_t memoryUsed = 0;
-
-static void* myAlloc(void* /*ud*/, void* ptr, size_t osize, size_t nsize) {
-	if (CONFIG(debugMode) == DBG_LUA) {
-		tsOutputChannels.debugIntField1 = memoryUsed;
-	}
-
-	if (nsize == 0) {
-		// requested size is zero, free if necessary and return nullptr
-		if (ptr) {
-			chHeapFree(ptr);
-			memoryUsed -= osize;
-		}
+static void* heapAlloc(size_t size) {
+	return chHeapAlloc(&heap, size);
+}
 
-		return nullptr;
-	}
+// small strings, tables and closures come from slabs, everything else from the heap
+static SlabAllocator luaAllocator(heapAlloc, chHeapFree);
 
-	void *new_mem = chHeapAlloc(&heap, nsize);
-	memoryUsed += nsize;
+static void* myAlloc(void* /*ud*/, void* ptr, size_t osize, size_t nsize) {
+	return luaAllocator.reallocate(ptr, osize, nsize);
+}
 
-	if (!ptr) {
-		// No old pointer passed in, simply return allocated block
-		return new_mem;
-	}
+/**
+ * @return percentage of free heap which is not in the largest free block
+ */
+static int getHeapFragmentationPercent() {
+	size_t largestFree;
+	size_t totalFree;
+	chHeapStatus(&heap, &totalFree, &largestFree);
+	return totalFree == 0 ? 0 : 100 - 100 * largestFree / totalFree;
+}
 
-	// An old pointer was passed in, copy the old data in, then free
-	if (new_mem != nullptr) {
-		memcpy(new_mem, ptr, chHeapGetSize(ptr) > nsize ? nsize : chHeapGetSize(ptr));
-		chHeapFree(ptr);
-		memoryUsed -= osize;
+static void updateLuaMemoryDebug() {
+	if (CONFIG(debugMode) != DBG_LUA) {
+		return;
 	}
-
-	return new_mem;
+	// debugFloatField* belong to setDebug() in Lua scripts
+	const SlabAllocatorStats& stats = luaAllocator.getStats();
+	tsOutputChannels.debugIntField1 = stats.usedBytes;
+	tsOutputChannels.debugIntField2 = stats.peakUsedBytes;
+	tsOutputChannels.debugIntField3 = stats.failedCount;
+	tsOutputChannels.debugIntField4 = getHeapFragmentationPercent();
+	tsOutputChannels.debugIntField5 = luaAllocator.getSlabFragmentationPercent();
 }
 #else // not EFI_PROD_CODE
 // Non-MCU code can use plain realloc function instead of custom implementation
@@ -130,10 +131,28 @@ static LuaHandle setupLuaState() {
 	return ls;
 }
 
-static bool loadScript(LuaHandle& ls, const char* scriptStr) {
-	efiPrintf(TAG "loading script length: %d...", efiStrlen(scriptStr));
+/**
+ * @param bufferSize size of the buffer holding the script, only used for precompiled bytecode
+ */
+static bool loadScript(LuaHandle& ls, const char* scriptStr, size_t bufferSize) {
+	// precompiled by misc/lua_precompile, binary chunk is not null terminated
+	bool isBytecode = scriptStr[0] == LUA_SIGNATURE[0];
+	size_t size;
+	if (isBytecode) {
+		size = getLuaBytecodeSize(scriptStr, bufferSize);
+		if (size == 0) {
+			efiPrintf(TAG "ERROR bytecode is corrupt or not produced by misc/lua_precompile for this firmware");
+			return false;
+		}
+		scriptStr += LUA_BYTECODE_HEADER_SIZE;
+	} else {
+		size = efiStrlen(scriptStr);
+	}
+
+	efiPrintf(TAG "loading %s length: %d...", isBytecode ? "bytecode" : "script", size);
 
-	if (0 != luaL_dostring(ls, scriptStr)) {
+	if (0 != luaL_loadbufferx(ls, scriptStr, size, "script", isBytecode ? "b" : "t")
+			|| 0 != lua_pcall(ls, 0, LUA_MULTRET, 0)) {
 		efiPrintf(TAG "ERROR loading script: %s", lua_tostring(ls, -1));
 		lua_pop(ls, 1);
 		return false;
@@ -148,10 +167,30 @@ static bool loadScript(LuaHandle& ls, const char* scriptStr) {
 static bool interactivePending = false;
 static char interactiveCmd[100];
 
-void doInteractive(LuaHandle& ls) {
+/**
+ * onTick is referenced from registry so that we do not look it up by name on each tick
+ *
+ * @return registry reference to onTick function, LUA_NOREF if script has none
+ */
+static int referenceTickFunction(LuaHandle& ls, int previousRef) {
+	luaL_unref(ls, LUA_REGISTRYINDEX, previousRef);
+
+	lua_getglobal(ls, "onTick");
+	if (!lua_isfunction(ls, -1)) {
+		lua_pop(ls, 1);
+		return LUA_NOREF;
+	}
+
+	return luaL_ref(ls, LUA_REGISTRYINDEX);
+}
+
+/**
+ * @return true if a command was executed
+ */
+static bool doInteractive(LuaHandle& ls) {
 	if (!interactivePending) {
 		// no cmd pending, return
-		return;
+		return false;
 	}
 
 	auto status = luaL_dostring(ls, interactiveCmd);
@@ -179,19 +218,20 @@ void doInteractive(LuaHandle& ls) {
 	interactivePending = false;
 
 	lua_settop(ls, 0);
+	return true;
 }
 
-void invokeTick(LuaHandle& ls) {
+static void invokeTick(LuaHandle& ls, int tickRef) {
 	ScopePerf perf(PE::LuaTickFunction);
 
-	// run the tick function
-	lua_getglobal(ls, "onTick");
-	if (lua_isnil(ls, -1)) {
+	if (tickRef == LUA_NOREF) {
 		// TODO: handle missing tick function
-		lua_settop(ls, 0);
 		return;
 	}
 
+	// run the tick function
+	lua_rawgeti(ls, LUA_REGISTRYINDEX, tickRef);
+
 	int status = lua_pcall(ls, 0, 0, 0);
 
 	if (0 != status) {
@@ -224,6 +264,10 @@ static bool needsReset = false;
 static bool runOneLua() {
 	needsReset = false;
 
+	// previous instance is gone, so are all its blocks
+	chHeapObjectInit(&heap, &luaHeap, sizeof(luaHeap));
+	luaAllocator.reset();
+
 	auto ls = setupLuaState();
 
 	// couldn't start Lua interpreter, bail out
@@ -234,15 +278,22 @@ static bool runOneLua() {
 	// Reset default tick rate
 	luaTickPeriodMs = 100;
 
-	if (!loadScript(ls, config->luaScript)) {
+	if (!loadScript(ls, config->luaScript, sizeof(config->luaScript))) {
 		return false;
 	}
 
+	int tickRef = referenceTickFunction(ls, LUA_NOREF);
+
 	while (!needsReset && !chThdShouldTerminateX()) {
 		// First, check if there is a pending interactive command entered by the user
-		doInteractive(ls);
+		if (doInteractive(ls)) {
+			// command could have (re)defined onTick
+			tickRef = referenceTickFunction(ls, tickRef);
+		}
+
+		invokeTick(ls, tickRef);
 
-		invokeTick(ls);
+		updateLuaMemoryDebug();
 
 		chThdSleepMilliseconds(luaTickPeriodMs);
 	}
@@ -254,8 +305,6 @@ static bool runOneLua() {
 }
 
 void LuaThread::ThreadTask() {
-	chHeapObjectInit(&heap, &luaHeap, sizeof(luaHeap));
-
 	while (!chThdShouldTerminateX()) {
 		bool wasOk = runOneLua();
 
@@ -290,8 +339,12 @@ void startLua() {
 	});
 
 	addConsoleAction("luamemory", [](){
-		float pct = 100.0f * memoryUsed / LUA_HEAP_SIZE;
-		efiPrintf("Lua memory: %d / %d bytes = %.1f%%", memoryUsed, LUA_HEAP_SIZE, pct);
+		const SlabAllocatorStats& stats = luaAllocator.getStats();
+		float pct = 100.0f * stats.usedBytes / LUA_HEAP_SIZE;
+		efiPrintf("Lua memory: %d / %d bytes = %.1f%%, peak %d", stats.usedBytes, LUA_HEAP_SIZE, pct, stats.peakUsedBytes);
+		efiPrintf("Lua slabs: %d bytes, %d free = %d%%", stats.slabBytes, stats.slabFreeBytes, luaAllocator.getSlabFragmentationPercent());
+		efiPrintf("Lua large blocks: %d bytes, heap fragmentation %d%%", stats.largeBytes, getHeapFragmentationPercent());
+		efiPrintf("Lua in place reallocations %d, failed allocations %d", stats.inPlaceCount, stats.failedCount);
 	});
 }
 
@@ -304,14 +357,14 @@ void startLua() {
 #include <stdexcept>
 #include <string>
 
-static LuaHandle runScript(const char* script) {
+static LuaHandle runScript(const char* script, size_t bufferSize) {
 	auto ls = setupLuaState();
 
 	if (!ls) {
 		throw new std::logic_error("Call to setupLuaState failed, returned null");
 	}
 
-	if (!loadScript(ls, script)) {
+	if (!loadScript(ls, script, bufferSize)) {
 		throw new std::logic_error("Call to loadScript failed");
 	}
 
@@ -331,7 +384,7 @@ static LuaHandle runScript(const char* script) {
 }
 
 expected<float> testLuaReturnsNumberOrNil(const char* script) {
-	auto ls = runScript(script);
+	auto ls = runScript(script, efiStrlen(script));
 
 	// check nil return first
 	if (lua_isnil(ls, -1)) {
@@ -348,7 +401,7 @@ expected<float> testLuaReturnsNumberOrNil(const char* script) {
 }
 
 float testLuaReturnsNumber(const char* script) {
-	auto ls = runScript(script);
+	auto ls = runScript(script, efiStrlen(script));
 
 	// check the return value
 	if (!lua_isnumber(ls, -1)) {
@@ -359,8 +412,18 @@ float testLuaReturnsNumber(const char* script) {
 	return lua_tonumber(ls, -1);
 }
 
+float testLuaBytecodeReturnsNumber(const char* buffer, size_t bufferSize) {
+	auto ls = runScript(buffer, bufferSize);
+
+	if (!lua_isnumber(ls, -1)) {
+		throw new std::logic_error("Returned value is not a number");
+	}
+
+	return lua_tonumber(ls, -1);
+}
+
 int testLuaReturnsInteger(const char* script) {
-	auto ls = runScript(script);
+	auto ls = runScript(script, efiStrlen(script));
 
 	// pop the return value;
 	if (!lua_isinteger(ls, -1)) {
@@ -3,6 +3,7 @@ LUA_EXT=$(PROJECT_DIR)/ext/lua
 
 ALLCPPSRC += $(LUA_DIR)/lua.cpp \
 			 $(LUA_DIR)/lua_hooks.cpp \
+			 $(LUA_DIR)/lua_bytecode.cpp \
 
 ALLINC += $(LUA_DIR) $(LUA_EXT)
 ALLCSRC += \
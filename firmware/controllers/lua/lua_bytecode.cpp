@@ -0,0 +1,65 @@
+/**
+ * @file lua_bytecode.cpp
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#include "lua_bytecode.h"
+#include "lua.hpp"
+#include "crc.h"
+
+#include <cstdint>
+#include <cstring>
+
+// version byte of binary chunk header, see LUAC_VERSION in lundump.h
+#define LUAC_VERSION (LUA_VERSION_NUM / 100 * 16 + LUA_VERSION_NUM % 100)
+
+#define SIZE_OFFSET LUA_BYTECODE_MAGIC_SIZE
+#define CRC_OFFSET (LUA_BYTECODE_MAGIC_SIZE + 2)
+
+static uint32_t readLittleEndian(const uint8_t* data, size_t size) {
+	uint32_t result = 0;
+	for (size_t i = 0; i < size; i++) {
+		result |= (uint32_t)data[i] << (8 * i);
+	}
+	return result;
+}
+
+static void writeLittleEndian(uint8_t* data, size_t size, uint32_t value) {
+	for (size_t i = 0; i < size; i++) {
+		data[i] = value >> (8 * i);
+	}
+}
+
+size_t getLuaBytecodeSize(const char* buffer, size_t bufferSize) {
+	const uint8_t* header = reinterpret_cast<const uint8_t*>(buffer);
+	const size_t signatureSize = sizeof(LUA_SIGNATURE) - 1;
+
+	if (bufferSize < LUA_BYTECODE_HEADER_SIZE + signatureSize + 1
+			|| 0 != memcmp(buffer, LUA_BYTECODE_MAGIC, LUA_BYTECODE_MAGIC_SIZE)) {
+		return 0;
+	}
+
+	size_t size = readLittleEndian(header + SIZE_OFFSET, 2);
+	const char* bytecode = buffer + LUA_BYTECODE_HEADER_SIZE;
+	if (size < signatureSize + 1 || size > bufferSize - LUA_BYTECODE_HEADER_SIZE
+			|| 0 != memcmp(bytecode, LUA_SIGNATURE, signatureSize)
+			|| (uint8_t)bytecode[signatureSize] != LUAC_VERSION) {
+		return 0;
+	}
+
+	// number sizes and format are checked by Lua itself, what Lua does not check is the code
+	if (crc32(bytecode, size) != readLittleEndian(header + CRC_OFFSET, 4)) {
+		return 0;
+	}
+
+	return size;
+}
+
+void setLuaBytecodeHeader(char* buffer, size_t bytecodeSize) {
+	uint8_t* header = reinterpret_cast<uint8_t*>(buffer);
+	memcpy(buffer, LUA_BYTECODE_MAGIC, LUA_BYTECODE_MAGIC_SIZE);
+	writeLittleEndian(header + SIZE_OFFSET, 2, bytecodeSize);
+	writeLittleEndian(header + CRC_OFFSET, 4, crc32(buffer + LUA_BYTECODE_HEADER_SIZE, bytecodeSize));
+}
@@ -0,0 +1,32 @@
+/**
+ * @file lua_bytecode.h
+ *
+ * Precompiled script in 'luaScript' configuration field, produced by misc/lua_precompile:
+ *
+ *   [LUA_BYTECODE_MAGIC][bytecode size, 2 bytes][crc32 of bytecode, 4 bytes][bytecode]
+ *
+ * Lua only checks the header of a binary chunk, corrupt or mismatched bytecode would crash the
+ * interpreter, so firmware loads bytecode only if this container is intact.
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#pragma once
+
+#include <cstddef>
+
+// first byte matches LUA_SIGNATURE so that text loader would never accept it
+#define LUA_BYTECODE_MAGIC "\x1b" "EFI"
+#define LUA_BYTECODE_MAGIC_SIZE 4
+#define LUA_BYTECODE_HEADER_SIZE 10
+
+/**
+ * @return size of bytecode following the header, 0 if buffer does not hold bytecode for this Lua version
+ */
+size_t getLuaBytecodeSize(const char* buffer, size_t bufferSize);
+
+/**
+ * Fills the header in front of bytecode which is already at buffer + LUA_BYTECODE_HEADER_SIZE
+ */
+void setLuaBytecodeHeader(char* buffer, size_t bytecodeSize);
@@ -38,6 +38,26 @@ static int lua_getSensor(lua_State* l) {
 	return 1;
 }
 
+/**
+ * Resolves sensor name to the index getSensor() and friends take, meant to be called once when script
+ * is loaded rather than from onTick:
+ *   local clt = findSensor("CLT")
+ */
+static int lua_findSensor(lua_State* l) {
+	auto name = luaL_checkstring(l, 1);
+
+	for (size_t i = 1; i < static_cast<size_t>(SensorType::PlaceholderLast); i++) {
+		if (strEqualCaseInsensitive(name, Sensor::getSensorName(static_cast<SensorType>(i)))) {
+			lua_pushinteger(l, i);
+			return 1;
+		}
+	}
+
+	// Return nil to indicate unknown sensor
+	lua_pushnil(l);
+	return 1;
+}
+
 static int lua_getSensorRaw(lua_State* l) {
 	auto sensorIndex = luaL_checkinteger(l, 1);
 
@@ -187,6 +207,7 @@ static int lua_stopEngine(lua_State*) {
 void configureRusefiLuaHooks(lua_State* l) {
 	lua_register(l, "print", lua_efi_print);
 	lua_register(l, "getSensor", lua_getSensor);
+	lua_register(l, "findSensor", lua_findSensor);
 	lua_register(l, "getSensorRaw", lua_getSensorRaw);
 	lua_register(l, "hasSensor", lua_hasSensor);
 	lua_register(l, "table3d", lua_table3d);
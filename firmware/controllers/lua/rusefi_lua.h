@@ -6,8 +6,11 @@ void startLua();
 
 #if EFI_UNIT_TEST
 #include "expected.h"
+#include <cstddef>
 
 expected<float> testLuaReturnsNumberOrNil(const char* script);
 float testLuaReturnsNumber(const char* script);
+// buffer holds precompiled script, see lua_bytecode.h
+float testLuaBytecodeReturnsNumber(const char* buffer, size_t bufferSize);
 int testLuaReturnsInteger(const char* script);
 #endif
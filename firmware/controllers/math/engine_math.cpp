@@ -401,15 +401,6 @@ ignition_mode_e getCurrentIgnitionMode(DECLARE_ENGINE_PARAMETER_SIGNATURE) {
 void prepareOutputSignals(DECLARE_ENGINE_PARAMETER_SIGNATURE) {
 	ENGINE(engineCycle) = getEngineCycle(engine->getOperationMode(PASS_ENGINE_PARAMETER_SIGNATURE));
 
-	angle_t maxTimingCorrMap = -720.0f;
-	angle_t maxTimingMap = -720.0f;
-	for (int rpmIndex = 0;rpmIndex<IGN_RPM_COUNT;rpmIndex++) {
-		for (int l = 0;l<IGN_LOAD_COUNT;l++) {
-			maxTimingCorrMap = maxF(maxTimingCorrMap, config->ignitionIatCorrTable[l][rpmIndex]);
-			maxTimingMap = maxF(maxTimingMap, config->ignitionTable[l][rpmIndex]);
-		}
-	}
-
 #if EFI_UNIT_TEST
 	if (verboseMode) {
 		printf("prepareOutputSignals %d onlyEdge=%s %s\r\n", engineConfiguration->trigger.type, boolToString(engineConfiguration->useOnlyRisingEdgeForTrigger),
@@ -0,0 +1,61 @@
+/**
+ * @file knock_band_bank.cpp
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#include "knock_band_bank.h"
+
+/**
+ * Resonance modes of a cylinder relative to the first circumferential one,
+ * Bessel function roots 1.841, 3.054 and 3.832 - see Draper's knock frequency formula
+ */
+static const float modeRatios[KNOCK_BAND_COUNT] = { 1, 1.659f, 2.081f };
+
+// same Q the single band filter has always had
+#define KNOCK_BAND_Q 3
+
+void KnockBandBank::configure(float sampleRate, float firstBandHz) {
+	m_bandCount = 0;
+	for (size_t i = 0; i < KNOCK_BAND_COUNT; i++) {
+		float hz = firstBandHz * modeRatios[i];
+		if (hz * 2 > sampleRate) {
+			break;
+		}
+		m_filters[i].configureBandpass(sampleRate, hz, KNOCK_BAND_Q);
+		m_bandHz[i] = hz;
+		m_bandCount++;
+	}
+}
+
+void KnockBandBank::process(const uint16_t* samples, size_t count, float voltsPerCount, float restVolts, float* meanSquares) {
+	float sumSquares[KNOCK_BAND_COUNT];
+	for (size_t band = 0; band < m_bandCount; band++) {
+		m_filters[band].cookSteadyState(restVolts);
+		sumSquares[band] = 0;
+	}
+
+	for (size_t blockStart = 0; blockStart < count; blockStart += KNOCK_BLOCK_SIZE) {
+		size_t blockSize = count - blockStart < KNOCK_BLOCK_SIZE ? count - blockStart : KNOCK_BLOCK_SIZE;
+
+		for (size_t i = 0; i < blockSize; i++) {
+			m_volts[i] = voltsPerCount * samples[blockStart + i];
+		}
+
+		for (size_t band = 0; band < m_bandCount; band++) {
+			m_filters[band].filterBlock(m_volts, m_filtered, blockSize);
+
+			// accumulated in sample order to match the scalar loop
+			float sum = sumSquares[band];
+			for (size_t i = 0; i < blockSize; i++) {
+				sum += m_filtered[i] * m_filtered[i];
+			}
+			sumSquares[band] = sum;
+		}
+	}
+
+	for (size_t band = 0; band < m_bandCount; band++) {
+		meanSquares[band] = sumSquares[band] / count;
+	}
+}
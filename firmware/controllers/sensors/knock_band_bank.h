@@ -0,0 +1,54 @@
+/**
+ * @file knock_band_bank.h
+ *
+ * Band energies of one knock sampling window, several resonance modes at once.
+ *
+ * Samples are converted to volts one block at a time and each band filter runs over the whole block
+ * before the next one, so filter state stays in registers. Results are bit for bit what the
+ * sample-at-a-time Biquad::filter() loop gives.
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#pragma once
+
+#include "biquad.h"
+
+#include <cstdint>
+
+#define KNOCK_BAND_COUNT 3
+#define KNOCK_BLOCK_SIZE 64
+
+class KnockBandBank {
+public:
+	/**
+	 * First band is the configured knock frequency, taken to be the first circumferential mode of the
+	 * combustion chamber, further bands are the next modes. Bands above Nyquist are left out.
+	 */
+	void configure(float sampleRate, float firstBandHz);
+
+	/**
+	 * Every band starts from steady state at restVolts, same as each cylinder event always did
+	 *
+	 * @param meanSquares out: mean of squared band filter output, for getBandCount() bands
+	 */
+	void process(const uint16_t* samples, size_t count, float voltsPerCount, float restVolts, float* meanSquares);
+
+	size_t getBandCount() const {
+		return m_bandCount;
+	}
+
+	float getBandHz(size_t band) const {
+		return m_bandHz[band];
+	}
+
+private:
+	Biquad m_filters[KNOCK_BAND_COUNT];
+	float m_bandHz[KNOCK_BAND_COUNT];
+	size_t m_bandCount = 0;
+
+	// block buffers are here and not on stack, knock thread has a small one
+	float m_volts[KNOCK_BLOCK_SIZE];
+	float m_filtered[KNOCK_BLOCK_SIZE];
+};
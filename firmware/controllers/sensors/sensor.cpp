@@ -77,9 +77,15 @@ public:
 
 	void reset() {
 		m_sensor = nullptr;
+		m_useSnapshot = false;
 		resetMock();
 	}
 
+	void useSnapshot(efitick_t timeoutNt) {
+		m_useSnapshot = true;
+		m_snapshotTimeout = timeoutNt;
+	}
+
 	bool Register(Sensor* sensor) {
 		// If there's somebody already here - a consumer tried to double-register a sensor
 		if (m_sensor) {
@@ -93,12 +99,29 @@ public:
 		}
 	}
 
-	SensorResult get() const {
+	SensorResult get(const SensorSnapshot& snapshot) const {
 		// Check if mock
 		if (m_useMock) {
 			return m_mockValue;
 		}
 
+		// Sensor publishes its readings, no need to ask it
+		if (m_useSnapshot) {
+			if (!snapshot.valid) {
+				return unexpected;
+			}
+
+			float value = snapshot.value;
+
+			if (m_snapshotTimeout != 0) { // zero timeout means value lasts forever
+				if (getTimeNowNt() - m_snapshotTimeout > snapshot.timestamp) {
+					return unexpected;
+				}
+			}
+
+			return value;
+		}
+
 		// Get the sensor out of the entry
 		const Sensor *s = m_sensor;
 		if (s) {
@@ -161,16 +184,61 @@ public:
 private:
 	bool m_useMock = false;
 	bool m_mockRedundant = false;
+	bool m_useSnapshot = false;
 	float m_mockValue;
+	efitick_t m_snapshotTimeout = 0;
 	Sensor* m_sensor = nullptr;
 };
 
 static SensorRegistryEntry s_sensorRegistry[static_cast<size_t>(SensorType::PlaceholderLast)] = {};
 
+// Kept apart from the registry entries so that hot path reads touch as few cache lines as possible
+static SensorSnapshot s_sensorSnapshot[static_cast<size_t>(SensorType::PlaceholderLast)] = {};
+
 static_assert(efi::size(s_sensorNames) == efi::size(s_sensorRegistry));
 
 bool Sensor::Register() {
-	return s_sensorRegistry[getIndex()].Register(this);
+	auto& entry = s_sensorRegistry[getIndex()];
+
+	if (!entry.Register(this)) {
+		return false;
+	}
+
+	if (m_publishesSnapshot) {
+		entry.useSnapshot(m_snapshotTimeout);
+
+		// Seed the snapshot with whatever the sensor got before it was registered
+		auto result = get();
+		publish(result.Value, result.Valid && hasSensor(), getTimeNowNt());
+	}
+
+	return true;
+}
+
+void Sensor::publish(float value, bool valid, efitick_t timestamp) {
+	size_t index = getIndex();
+
+	if (s_sensorRegistry[index].getSensor() != this) {
+		// Not registered, or another sensor of the same type is
+		return;
+	}
+
+	// Readers copy the snapshot with the same lock held, so they never see half of an update
+	chibios_rt::CriticalSectionLocker csl;
+
+	auto& snapshot = s_sensorSnapshot[index];
+	snapshot.value = value;
+	snapshot.timestamp = timestamp;
+	snapshot.generation++;
+	snapshot.valid = valid;
+}
+
+/**
+ * publish() may be invoked from an interrupt, and a 64 bit timestamp alone is not read atomically on Cortex-M
+ */
+static SensorSnapshot readSnapshot(size_t index) {
+	chibios_rt::CriticalSectionLocker csl;
+	return s_sensorSnapshot[index];
 }
 
 /*static*/ void Sensor::resetRegistry() {
@@ -179,6 +247,7 @@ bool Sensor::Register() {
 		auto &entry = s_sensorRegistry[i];
 
 		entry.reset();
+		s_sensorSnapshot[i] = {};
 	}
 }
 
@@ -205,7 +274,21 @@ bool Sensor::Register() {
 		return unexpected;
 	}
 
-	return entry->get();
+	return entry->get(readSnapshot(getIndex(type)));
+}
+
+/*static*/ SensorSnapshot Sensor::getSnapshot(SensorType type) {
+	size_t index = getIndex(type);
+
+	if (index >= getIndex(SensorType::PlaceholderLast)) {
+		return {};
+	}
+
+	return readSnapshot(index);
+}
+
+/*static*/ uint32_t Sensor::getGeneration(SensorType type) {
+	return getSnapshot(type).generation;
 }
 
 /*static*/ float Sensor::getRaw(SensorType type) {
@@ -29,6 +29,12 @@
  *   Instantiate a subclass of Sensor, and implement the Get() function.
  *   Call Register() to install the new sensor in the registry, preparing it for use.
  *
+ * Snapshot:
+ *   Sensors that store their readings (see StoredValueSensor) also publish each reading into a
+ *   packed array owned by the registry. Sensor::get(SensorType) reads those straight from the array
+ *   without any virtual call, Sensor::getSnapshot/getGeneration let a consumer tell whether it has
+ *   already seen the current reading.
+ *
  * Mocking:
  *   The sensor table supports mocking each sensors value.  Call Sensor::SetMockValue to
  *   set a mock value for a particular sensor, and Sensor::ResetMockValue or
@@ -49,11 +55,25 @@
 
 #include "sensor_type.h"
 #include "expected.h"
+#include "rusefi_types.h"
 
 #include <cstddef>
 
 using SensorResult = expected<float>;
 
+/**
+ * Last reading published by a sensor, one per SensorType in the registry.
+ * Producer may be an interrupt, the registry writes and copies a snapshot inside a critical section
+ * so that a consumer always gets a consistent copy.
+ */
+struct SensorSnapshot {
+	efitick_t timestamp;
+	float value;
+	// incremented on every reading published, including invalid ones
+	uint32_t generation;
+	bool valid;
+};
+
 // Fwd declare - nobody outside of Sensor.cpp needs to see inside this type
 class SensorRegistryEntry;
 
@@ -86,6 +106,16 @@ public:
 	 */
 	static SensorResult get(SensorType type);
 
+	/*
+	 * Get the last published reading of the specified sensor, without timeout or mock applied.
+	 */
+	static SensorSnapshot getSnapshot(SensorType type);
+
+	/*
+	 * Get the generation of the last published reading, cheap way to detect a stale sensor.
+	 */
+	static uint32_t getGeneration(SensorType type);
+
 	/*
 	 * Get a raw (unconverted) value from the sensor, if available.
 	 */
@@ -160,9 +190,22 @@ protected:
 	explicit Sensor(SensorType type)
 		: m_type(type) {}
 
+	// Constructor for sensors which publish every reading into the registry snapshot
+	Sensor(SensorType type, efitick_t snapshotTimeoutNt)
+		: m_type(type)
+		, m_publishesSnapshot(true)
+		, m_snapshotTimeout(snapshotTimeoutNt) {}
+
+	// Store a new reading in the registry snapshot, ignored unless this sensor is the registered one
+	void publish(float value, bool valid, efitick_t timestamp);
+
 private:
 	const SensorType m_type;
 
+	const bool m_publishesSnapshot = false;
+	// zero means the published value lasts forever
+	const efitick_t m_snapshotTimeout = 0;
+
 	// Get this sensor's index in the list
 	constexpr size_t getIndex() {
 		return getIndex(m_type);
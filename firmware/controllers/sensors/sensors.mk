@@ -15,6 +15,7 @@ CONTROLLERS_SENSORS_SRC_CPP = 	$(PROJECT_DIR)/controllers/sensors/thermistors.cp
 	$(PROJECT_DIR)/controllers/sensors/AemXSeriesLambda.cpp \
 	$(PROJECT_DIR)/cotnrollers/sensors/flex_sensor.cpp \
 	$(PROJECT_DIR)/controllers/sensors/software_knock.cpp \
+	$(PROJECT_DIR)/controllers/sensors/knock_band_bank.cpp \
 	$(PROJECT_DIR)/controllers/sensors/Lps25Sensor.cpp \
 	$(PROJECT_DIR)/controllers/sensors/converters/linear_func.cpp \
 	$(PROJECT_DIR)/controllers/sensors/converters/resistance_func.cpp \
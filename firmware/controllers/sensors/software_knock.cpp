@@ -1,6 +1,6 @@
 #include "global.h"
 #include "engine.h"
-#include "biquad.h"
+#include "knock_band_bank.h"
 #include "perf_trace.h"
 #include "thread_controller.h"
 #include "knock_logic.h"
@@ -15,14 +15,28 @@ EXTERN_ENGINE;
 #include "knock_config.h"
 #include "ch.hpp"
 
-static NO_CACHE adcsample_t sampleBuffer[2000];
-static int8_t currentCylinderIndex = 0;
-static efitick_t lastKnockSampleTime = 0;
-static Biquad knockFilter;
+/**
+ * ADC fills one buffer while knock thread processes the other one, so a cylinder event is only
+ * skipped if processing falls behind by more than one event
+ */
+struct KnockSampleBuffer {
+	adcsample_t samples[2000];
+	size_t sampleCount;
+	int8_t cylinderIndex;
+	efitick_t sampleTime;
+	volatile bool needsProcess;
+};
+
+static NO_CACHE KnockSampleBuffer sampleBuffers[2];
+// buffer ADC is filling or is going to fill next
+static size_t samplingIndex = 0;
+// buffer knock thread is going to process next
+static size_t processingIndex = 0;
+
+static KnockBandBank knockBands;
 
-static volatile bool knockIsSampling = false;
-static volatile bool knockNeedsProcess = false;
-static volatile size_t sampleCount = 0;
+static uint32_t processedEventCount = 0;
+static uint32_t skippedEventCount = 0;
 
 chibios_rt::BinarySemaphore knockSem(/* taken =*/ true);
 
@@ -30,7 +44,8 @@ static void completionCallback(ADCDriver* adcp) {
 	palClearPad(GPIOD, 2);
 
 	if (adcp->state == ADC_COMPLETE) {
-		knockNeedsProcess = true;
+		sampleBuffers[samplingIndex].needsProcess = true;
+		samplingIndex = (samplingIndex + 1) % efi::size(sampleBuffers);
 
 		// Notify the processing thread that it's time to process this sample
 		chSysLockFromISR();
@@ -125,24 +140,27 @@ void startKnockSampling(uint8_t cylinderIndex) {
 		return;
 	}
 
-	// If there's pending processing, skip this event
-	if (knockNeedsProcess) {
+	KnockSampleBuffer& buffer = sampleBuffers[samplingIndex];
+
+	// If both buffers are pending processing, skip this event
+	if (buffer.needsProcess) {
+		skippedEventCount++;
 		return;
 	}
 
 	// Sample for 45 degrees
 	float samplingSeconds = ENGINE(rpmCalculator).oneDegreeUs * 45 * 1e-6;
 	constexpr int sampleRate = KNOCK_SAMPLE_RATE;
-	sampleCount = 0xFFFFFFFE & static_cast<size_t>(clampF(100, samplingSeconds * sampleRate, efi::size(sampleBuffer)));
+	buffer.sampleCount = 0xFFFFFFFE & static_cast<size_t>(clampF(100, samplingSeconds * sampleRate, efi::size(buffer.samples)));
 
 	// Select the appropriate conversion group - it will differ depending on which sensor this cylinder should listen on
 	auto conversionGroup = getConversionGroup(cylinderIndex);
 
 	// Stash the current cylinder's index so we can store the result appropriately
-	currentCylinderIndex = cylinderIndex;
+	buffer.cylinderIndex = cylinderIndex;
 
-	adcStartConversionI(&KNOCK_ADC, conversionGroup, sampleBuffer, sampleCount);
-	lastKnockSampleTime = getTimeNowNt();
+	adcStartConversionI(&KNOCK_ADC, conversionGroup, buffer.samples, buffer.sampleCount);
+	buffer.sampleTime = getTimeNowNt();
 }
 
 class KnockThread : public ThreadController<256> {
@@ -155,7 +173,7 @@ static KnockThread kt;
 
 void initSoftwareKnock() {
 	if (CONFIG(enableSoftwareKnock)) {
-		knockFilter.configureBandpass(KNOCK_SAMPLE_RATE, 1000 * CONFIG(knockBandCustom), 3);
+		knockBands.configure(KNOCK_SAMPLE_RATE, 1000 * CONFIG(knockBandCustom));
 		adcStart(&KNOCK_ADC, nullptr);
 
 		efiSetPadMode("knock ch1", KNOCK_PIN_CH1, PAL_MODE_INPUT_ANALOG);
@@ -170,53 +188,67 @@ using PD = PeakDetect<float, MS2NT(100)>;
 static PD peakDetectors[12];
 static PD allCylinderPeakDetector;
 
-void processLastKnockEvent() {
-	if (!knockNeedsProcess) {
-		return;
-	}
+// latest band levels, dBv
+static float bandLevels[12][KNOCK_BAND_COUNT];
 
-	float sumSq = 0;
+float getKnockBandLevel(uint8_t cylinderIndex, size_t band) {
+	if (cylinderIndex >= efi::size(bandLevels) || band >= knockBands.getBandCount()) {
+		return NAN;
+	}
+	return bandLevels[cylinderIndex][band];
+}
 
+static void processKnockBuffer(KnockSampleBuffer& buffer) {
 	// todo: reduce magic constants. engineConfiguration->adcVcc?
 	constexpr float ratio = 3.3f / 4095.0f;
 
-	size_t localCount = sampleCount;
+	float meanSquares[KNOCK_BAND_COUNT];
 
-	// Prepare the steady state at vcc/2 so that there isn't a step
-	// when samples begin
+	// Every band starts at steady state vcc/2 so that there isn't a step when samples begin
 	// todo: reduce magic constants. engineConfiguration->adcVcc?
-	knockFilter.cookSteadyState(3.3f / 2);
-
-	// Compute the sum of squares
-	for (size_t i = 0; i < localCount; i++) {
-		float volts = ratio * sampleBuffer[i];
-
-		float filtered = knockFilter.filter(volts);
-
-		sumSq += filtered * filtered;
-	}
+	knockBands.process(buffer.samples, buffer.sampleCount, ratio, 3.3f / 2, meanSquares);
 
 	// take a local copy
-	auto lastKnockTime = lastKnockSampleTime;
+	auto lastKnockTime = buffer.sampleTime;
+	int8_t cylinderIndex = buffer.cylinderIndex;
 
 	// We're done with inspecting the buffer, another sample can be taken
-	knockNeedsProcess = false;
+	buffer.needsProcess = false;
+	processedEventCount++;
 
-	// mean of squares (not yet root)
-	float meanSquares = sumSq / localCount;
+	for (size_t band = 0; band < knockBands.getBandCount(); band++) {
+		// mean of squares (not yet root)
+		float db = 10 * log10(meanSquares[band]);
 
-	// RMS
-	float db = 10 * log10(meanSquares);
+		// clamp to reasonable range
+		bandLevels[cylinderIndex][band] = clampF(-100, db, 100);
+	}
 
-	// clamp to reasonable range
-	db = clampF(-100, db, 100);
+	// first band is the configured knock frequency
+	float db = bandLevels[cylinderIndex][0];
 
 	// Pass through peak detector
-	float cylPeak = peakDetectors[currentCylinderIndex].detect(db, lastKnockTime);
+	float cylPeak = peakDetectors[cylinderIndex].detect(db, lastKnockTime);
 
-	tsOutputChannels.knockLevels[currentCylinderIndex] = roundf(cylPeak);
+	tsOutputChannels.knockLevels[cylinderIndex] = roundf(cylPeak);
 	tsOutputChannels.knockLevel = allCylinderPeakDetector.detect(db, lastKnockTime);
 
+	if (CONFIG(debugMode) == DBG_KNOCK) {
+		auto firstDebugField = &tsOutputChannels.debugFloatField1;
+		for (size_t band = 0; band < knockBands.getBandCount(); band++) {
+			firstDebugField[band] = bandLevels[cylinderIndex][band];
+		}
+		tsOutputChannels.debugIntField3 = processedEventCount;
+		tsOutputChannels.debugIntField4 = skippedEventCount;
+	}
+}
+
+void processLastKnockEvent() {
+	// both buffers could be ready by now, oldest one first
+	while (sampleBuffers[processingIndex].needsProcess) {
+		processKnockBuffer(sampleBuffers[processingIndex]);
+		processingIndex = (processingIndex + 1) % efi::size(sampleBuffers);
+	}
 }
 
 void KnockThread::ThreadTask() {
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 void initSoftwareKnock();
 void startKnockSampling(uint8_t cylinderIndex);
 void processLastKnockEvent();
+/**
+ * @return latest level of given knock band for the cylinder in dBv, NAN if there is no such band
+ */
+float getKnockBandLevel(uint8_t cylinderIndex, size_t band);
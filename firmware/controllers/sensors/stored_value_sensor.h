@@ -25,7 +25,8 @@
  * and call Invalidate() and SetValidValue(float) as appropriate when readings are available
  * (or known to be invalid) for your sensor.
  *
- * Consumers will retrieve the last set (or invalidated) value.
+ * Consumers will retrieve the last set (or invalidated) value. Once registered, every reading
+ * is also published into the registry snapshot, so Sensor::get(SensorType) does not have to call back here.
  */
 class StoredValueSensor : public Sensor {
 public:
@@ -46,9 +47,14 @@ public:
 		return value;
 	}
 
+	// Registry reads the snapshot, presence has to be published, so it can't be overridden
+	bool hasSensor() const final override {
+		return m_hasSensor;
+	}
+
 protected:
 	StoredValueSensor(SensorType type, efitick_t timeoutNt)
-		: Sensor(type)
+		: Sensor(type, timeoutNt)
 		, m_timeoutPeriod(timeoutNt)
 	{
 	}
@@ -56,6 +62,12 @@ protected:
 	// Invalidate the stored value.
 	void invalidate() {
 		m_isValid = false;
+		publish(m_value, false, m_lastUpdate);
+	}
+
+	void setHasSensor(bool hasSensor) {
+		m_hasSensor = hasSensor;
+		publish(m_value, m_isValid && hasSensor, m_lastUpdate);
 	}
 
 	// A new reading is available: set and validate a new value for the sensor.
@@ -64,10 +76,13 @@ protected:
 		m_value = value;
 		m_isValid = true;
 		m_lastUpdate = timestamp;
+
+		publish(value, m_hasSensor, timestamp);
 	}
 
 private:
 	bool m_isValid = false;
+	bool m_hasSensor = true;
 	float m_value = 0.0f;
 
 	const efitick_t m_timeoutPeriod;
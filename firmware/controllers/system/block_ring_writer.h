@@ -0,0 +1,144 @@
+/**
+ * @file block_ring_writer.h
+ *
+ * Ring of fixed size blocks between one producer thread which writes records and one consumer thread
+ * which drains whole blocks, for example into a file on SD card. Neither side ever blocks the other:
+ * if the consumer falls behind, new records are dropped and counted instead of stalling the producer.
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2020
+ */
+
+#pragma once
+
+#include "buffered_writer.h"
+
+#include <atomic>
+#include <cstdint>
+
+template <size_t TBlockSize, size_t TBlockCount>
+class BlockRingWriter : public Writer {
+	static_assert(TBlockCount >= 2, "at least one block to fill while another one is drained");
+
+public:
+	/**
+	 * Producer side: each call is one record, a record is either stored completely or dropped.
+	 * Records are allowed to span a block boundary.
+	 * @return count, or zero if the record was dropped
+	 */
+	size_t write(const char* buffer, size_t count) override {
+		if (count > getFreeSpace()) {
+			m_droppedRecords++;
+			return 0;
+		}
+
+		size_t remaining = count;
+		while (remaining) {
+			Block& block = m_blocks[m_published.load(std::memory_order_relaxed) % TBlockCount];
+			size_t chunk = TBlockSize - block.size;
+			if (chunk > remaining) {
+				chunk = remaining;
+			}
+			memcpy(block.data + block.size, buffer, chunk);
+			block.size += chunk;
+			buffer += chunk;
+			remaining -= chunk;
+
+			if (block.size == TBlockSize) {
+				publish();
+			}
+		}
+
+		return count;
+	}
+
+	/**
+	 * Producer side: hands over a partially filled block, for example before closing the file
+	 */
+	size_t flush() override {
+		Block& block = m_blocks[m_published.load(std::memory_order_relaxed) % TBlockCount];
+		size_t size = block.size;
+		if (size > 0 && getUsedBlocks() < TBlockCount) {
+			publish();
+		}
+		return size;
+	}
+
+	/**
+	 * Consumer side
+	 * @return oldest block which was handed over by the producer, nullptr if none
+	 */
+	const char* getReadyBlock(size_t& size) const {
+		uint32_t consumed = m_consumed.load(std::memory_order_relaxed);
+		if (m_published.load(std::memory_order_acquire) == consumed) {
+			return nullptr;
+		}
+		const Block& block = m_blocks[consumed % TBlockCount];
+		size = block.size;
+		return block.data;
+	}
+
+	bool hasReadyBlock() const {
+		return m_published.load(std::memory_order_acquire) != m_consumed.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Consumer side: the block returned by getReadyBlock() could be reused by producer
+	 */
+	void releaseBlock() {
+		uint32_t consumed = m_consumed.load(std::memory_order_relaxed);
+		m_blocks[consumed % TBlockCount].size = 0;
+		m_consumed.store(consumed + 1, std::memory_order_release);
+	}
+
+	uint32_t getDroppedRecords() const {
+		return m_droppedRecords;
+	}
+
+	/**
+	 * Highest number of blocks which were waiting for the consumer at the same time
+	 */
+	size_t getMaxReadyBlocks() const {
+		return m_maxReadyBlocks;
+	}
+
+private:
+	struct Block {
+		char data[TBlockSize];
+		size_t size = 0;
+	};
+
+	size_t getUsedBlocks() const {
+		return m_published.load(std::memory_order_relaxed) - m_consumed.load(std::memory_order_acquire);
+	}
+
+	size_t getFreeSpace() const {
+		size_t used = getUsedBlocks();
+		if (used >= TBlockCount) {
+			// all blocks are waiting for the consumer, nothing to fill
+			return 0;
+		}
+		const Block& current = m_blocks[m_published.load(std::memory_order_relaxed) % TBlockCount];
+		return (TBlockSize - current.size) + (TBlockCount - 1 - used) * TBlockSize;
+	}
+
+	void publish() {
+		uint32_t published = m_published.load(std::memory_order_relaxed) + 1;
+		// block content has to be visible to consumer before the block itself
+		m_published.store(published, std::memory_order_release);
+
+		size_t ready = published - m_consumed.load(std::memory_order_acquire);
+		if (ready > m_maxReadyBlocks) {
+			m_maxReadyBlocks = ready;
+		}
+	}
+
+	Block m_blocks[TBlockCount];
+	// number of blocks ever handed over to consumer, written by producer only
+	std::atomic<uint32_t> m_published{0};
+	// number of blocks ever released by consumer, written by consumer only
+	std::atomic<uint32_t> m_consumed{0};
+
+	uint32_t m_droppedRecords = 0;
+	size_t m_maxReadyBlocks = 0;
+};
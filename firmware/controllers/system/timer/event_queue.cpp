@@ -3,7 +3,7 @@
  * This is a data structure which keeps track of all pending events
  * Implemented as a linked list, which is fine since the number of
  * pending events is pretty low
- * todo: MAYBE migrate to a better data structure, but that's low priority
+ * See TimerWheel for an alternative with flat insert cost, EFI_EVENT_QUEUE_TIMER_WHEEL
  *
  * this data structure is NOT thread safe
  *
@@ -52,7 +52,7 @@ bool EventQueue::insertTask(scheduling_s *scheduling, efitime_t timeX, action_s
 
 	if (head == NULL || timeX < head->momentX) {
 		// here we insert into head of the linked list
-		LL_PREPEND2(head, scheduling, nextScheduling_s);
+		link(&head, scheduling);
 #if EFI_UNIT_TEST
 		assertListIsSorted();
 #endif /* EFI_UNIT_TEST */
@@ -64,8 +64,7 @@ bool EventQueue::insertTask(scheduling_s *scheduling, efitime_t timeX, action_s
 			insertPosition = insertPosition->nextScheduling_s;
 		}
 
-		scheduling->nextScheduling_s = insertPosition->nextScheduling_s;
-		insertPosition->nextScheduling_s = scheduling;
+		link(&insertPosition->nextScheduling_s, scheduling);
 #if EFI_UNIT_TEST
 		assertListIsSorted();
 #endif /* EFI_UNIT_TEST */
@@ -73,6 +72,42 @@ bool EventQueue::insertTask(scheduling_s *scheduling, efitime_t timeX, action_s
 	}
 }
 
+/**
+ * O(1) - we know where the element is linked from
+ * @return true if element was pending
+ */
+bool EventQueue::cancel(scheduling_s *scheduling) {
+	if (!scheduling->action) {
+		// not scheduled or already executed
+		return false;
+	}
+
+	unlink(scheduling);
+	scheduling->action = {};
+#if EFI_UNIT_TEST
+	assertListIsSorted();
+#endif /* EFI_UNIT_TEST */
+	return true;
+}
+
+void EventQueue::link(scheduling_s **link, scheduling_s *scheduling) {
+	scheduling->nextScheduling_s = *link;
+	scheduling->pprevScheduling_s = link;
+	if (*link) {
+		(*link)->pprevScheduling_s = &scheduling->nextScheduling_s;
+	}
+	*link = scheduling;
+}
+
+void EventQueue::unlink(scheduling_s *scheduling) {
+	*scheduling->pprevScheduling_s = scheduling->nextScheduling_s;
+	if (scheduling->nextScheduling_s) {
+		scheduling->nextScheduling_s->pprevScheduling_s = scheduling->pprevScheduling_s;
+	}
+	scheduling->nextScheduling_s = nullptr;
+	scheduling->pprevScheduling_s = nullptr;
+}
+
 /**
  * On this layer it does not matter which units are used - us, ms ot nt.
  *
@@ -153,16 +188,22 @@ bool EventQueue::executeOne(efitime_t now) {
 		UNIT_TEST_BUSY_WAIT_CALLBACK();
 	}
 
+#if ENABLE_PERF_TRACE
+	// 'now' is when this batch has started, previous callbacks of the batch make us later than that
+	perfTraceOnEventExecuted(getTimeNowNt() - current->momentX);
+#endif /* ENABLE_PERF_TRACE */
+
 	// step the head forward, unlink this element, clear scheduled flag
-	head = current->nextScheduling_s;
-	current->nextScheduling_s = nullptr;
+	unlink(current);
 
 	// Grab the action but clear it in the event so we can reschedule from the action's execution
 	auto action = current->action;
 	current->action = {};
 
 #if EFI_UNIT_TEST
-	printf("QUEUE: execute current=%d param=%d\r\n", (long)current, (long)action.getArgument());
+	if (verboseMode) {
+		printf("QUEUE: execute current=%d param=%d\r\n", (long)current, (long)action.getArgument());
+	}
 #endif
 
 	// Execute the current element
@@ -224,6 +265,7 @@ void EventQueue::clear(void) {
 		// Reset this element
 		x->momentX = 0;
 		x->nextScheduling_s = nullptr;
+		x->pprevScheduling_s = nullptr;
 		x->action = {};
 	}
 
@@ -11,31 +11,6 @@
 
 #pragma once
 
-#define QUEUE_LENGTH_LIMIT 1000
-
-// templates do not accept field names so we use a macro here
-#define assertNotInListMethodBody(T, head, element, field)                  \
-	/* this code is just to validate state, no functional load*/            \
-	T * current;                                                            \
-	int counter = 0;                                                        \
-	LL_FOREACH2(head, current, field) {                                     \
-		if (++counter > QUEUE_LENGTH_LIMIT) {                               \
-			firmwareError(CUSTOM_ERR_LOOPED_QUEUE, "Looped queue?");        \
-			return false;                                                   \
-		}                                                                   \
-		if (current == element) {                                           \
-			/**                                                                                     \
-			 * for example, this might happen in case of sudden RPM change if event                 \
-			 * was not scheduled by angle but was scheduled by time. In case of scheduling          \
-			 * by time with slow RPM the whole next fast revolution might be within the wait period \
-			 */                                                                                     \
-			warning(CUSTOM_RE_ADDING_INTO_EXECUTION_QUEUE, "re-adding element into event_queue");   \
-			return true;                                                    \
-		} \
-	} \
-	return false;
-
-
 /**
  * Execution sorted linked list
  */
@@ -50,6 +25,7 @@ public:
 	 * O(size) - linear search in sorted linked list
 	 */
 	bool insertTask(scheduling_s *scheduling, efitime_t timeX, action_s action);
+	bool cancel(scheduling_s *scheduling);
 
 	int executeAll(efitime_t now);
 	bool executeOne(efitime_t now);
@@ -61,6 +37,8 @@ public:
 	scheduling_s * getHead();
 	void assertListIsSorted() const;
 private:
+	static void link(scheduling_s **link, scheduling_s *scheduling);
+	static void unlink(scheduling_s *scheduling);
 	/**
 	 * this list is sorted
 	 */
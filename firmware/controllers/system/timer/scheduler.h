@@ -57,6 +57,11 @@ struct scheduling_s {
 	 * Scheduler implementation uses a sorted linked list of these scheduling records.
 	 */
 	scheduling_s *nextScheduling_s = nullptr;
+	/**
+	 * Points to whichever pointer points at us - previous element's nextScheduling_s or list head.
+	 * This is what makes O(1) cancel possible.
+	 */
+	scheduling_s **pprevScheduling_s = nullptr;
 
 	action_s action;
 };
@@ -69,4 +74,12 @@ struct ExecutorInterface {
 	virtual void scheduleByTimestamp(scheduling_s *scheduling, efitimeus_t timeUs, action_s action) = 0;
 	virtual void scheduleByTimestampNt(scheduling_s *scheduling, efitime_t timeUs, action_s action) = 0;
 	virtual void scheduleForLater(scheduling_s *scheduling, int delayUs, action_s action) = 0;
+	/**
+	 * Removes pending event, does nothing if the event is not pending
+	 */
+	virtual void cancel(scheduling_s *scheduling) = 0;
+	/**
+	 * cancel() and scheduleByTimestampNt() as one step, so that the event cannot fire at the old time in between
+	 */
+	virtual void rescheduleByTimestampNt(scheduling_s *scheduling, efitime_t timeNt, action_s action) = 0;
 };
@@ -96,4 +96,19 @@ void SleepExecutor::scheduleForLater(scheduling_s *scheduling, int delayUs, acti
 	doScheduleForLater(scheduling, delayUs, action);
 }
 
+void SleepExecutor::cancel(scheduling_s *scheduling) {
+	chibios_rt::CriticalSectionLocker csl;
+
+	if (chVTIsArmedI(&scheduling->timer)) {
+		chVTResetI(&scheduling->timer);
+	}
+	scheduling->action = {};
+}
+
+void SleepExecutor::rescheduleByTimestampNt(scheduling_s *scheduling, efitick_t timeNt, action_s action) {
+	// simulator only, no need to be precise about atomicity here
+	cancel(scheduling);
+	scheduleByTimestampNt(scheduling, timeNt, action);
+}
+
 #endif /* EFI_SIGNAL_EXECUTOR_SLEEP */
@@ -14,4 +14,6 @@ public:
 	void scheduleByTimestamp(scheduling_s *scheduling, efitimeus_t timeUs, action_s action) override;
 	void scheduleByTimestampNt(scheduling_s *scheduling, efitick_t timeNt, action_s action) override;
 	void scheduleForLater(scheduling_s *scheduling, int delayUs, action_s action) override;
+	void cancel(scheduling_s *scheduling) override;
+	void rescheduleByTimestampNt(scheduling_s *scheduling, efitick_t timeNt, action_s action) override;
 };
@@ -45,7 +45,13 @@ void globalTimerCallback() {
 
 SingleTimerExecutor::SingleTimerExecutor()
 	// 8us is roughly the cost of the interrupt + overhead of a single timer event
+#if EFI_EVENT_QUEUE_TIMER_WHEEL
+	// 2^14 ticks is about 100us per slot at 168MHz, so the near level covers about 3ms
+	// and the far level about 100ms ahead
+	: queue(US2NT(8), 14)
+#else
 	: queue(US2NT(8))
+#endif /* EFI_EVENT_QUEUE_TIMER_WHEEL */
 {
 }
 
@@ -94,6 +100,24 @@ void SingleTimerExecutor::scheduleByTimestampNt(scheduling_s* scheduling, efitim
 	}
 }
 
+/**
+ * Hardware timer is left as is even if we have just removed the soonest event - spurious timer callback
+ * would find nothing to execute and schedule itself for the next pending event.
+ */
+void SingleTimerExecutor::cancel(scheduling_s *scheduling) {
+	chibios_rt::CriticalSectionLocker csl;
+
+	queue.cancel(scheduling);
+}
+
+void SingleTimerExecutor::rescheduleByTimestampNt(scheduling_s *scheduling, efitime_t nt, action_s action) {
+	// one lock for both, nested lock inside scheduleByTimestampNt is fine
+	chibios_rt::CriticalSectionLocker csl;
+
+	queue.cancel(scheduling);
+	scheduleByTimestampNt(scheduling, nt, action);
+}
+
 void SingleTimerExecutor::onTimerCallback() {
 	timerCallbackCounter++;
 
@@ -9,6 +9,7 @@
 
 #include "scheduler.h"
 #include "event_queue.h"
+#include "timer_wheel.h"
 
 class SingleTimerExecutor final : public ExecutorInterface {
 public:
@@ -16,6 +17,8 @@ public:
 	void scheduleByTimestamp(scheduling_s *scheduling, efitimeus_t timeUs, action_s action) override;
 	void scheduleByTimestampNt(scheduling_s *scheduling, efitime_t timeNt, action_s action) override;
 	void scheduleForLater(scheduling_s *scheduling, int delayUs, action_s action) override;
+	void cancel(scheduling_s *scheduling) override;
+	void rescheduleByTimestampNt(scheduling_s *scheduling, efitime_t timeNt, action_s action) override;
 	void onTimerCallback();
 	int timerCallbackCounter = 0;
 	int scheduleCounter = 0;
@@ -23,7 +26,11 @@ public:
 	int executeCounter;
 	int executeAllPendingActionsInvocationCounter = 0;
 private:
+#if EFI_EVENT_QUEUE_TIMER_WHEEL
+	TimerWheel queue;
+#else
 	EventQueue queue;
+#endif /* EFI_EVENT_QUEUE_TIMER_WHEEL */
 	bool reentrantFlag = false;
 	void executeAllPendingActions();
 	void scheduleTimerCallback();
@@ -0,0 +1,361 @@
+/**
+ * @file timer_wheel.cpp
+ * Pending events bucketed by time, see timer_wheel.h
+ *
+ * Compared to the EventQueue sorted list insert is proportional to the number of events in the same slot
+ * rather than to the number of all pending events, and any element is unlinked in O(1).
+ *
+ * this data structure is NOT thread safe
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2020
+ */
+
+#include "global.h"
+#include "os_access.h"
+#include "timer_wheel.h"
+#include "efitime.h"
+#include "perf_trace.h"
+
+#if EFI_UNIT_TEST
+extern int timeNowUs;
+#endif /* EFI_UNIT_TEST */
+
+#define SLOT_MASK (TIMER_WHEEL_SLOT_COUNT - 1)
+
+static_assert(TIMER_WHEEL_SLOT_COUNT == (1 << TIMER_WHEEL_GROUP_SHIFT), "slot count vs group shift");
+static_assert(TIMER_WHEEL_SLOT_COUNT == 8 * sizeof(uint32_t), "one mask bit per slot");
+
+static int firstSetBit(uint32_t mask) {
+	return __builtin_ctz(mask);
+}
+
+static uint32_t rotateRight(uint32_t value, int shift) {
+	shift &= SLOT_MASK;
+	return (value >> shift) | (value << ((TIMER_WHEEL_SLOT_COUNT - shift) & SLOT_MASK));
+}
+
+static void linkAt(scheduling_s **link, scheduling_s *scheduling) {
+	scheduling->nextScheduling_s = *link;
+	scheduling->pprevScheduling_s = link;
+	if (*link) {
+		(*link)->pprevScheduling_s = &scheduling->nextScheduling_s;
+	}
+	*link = scheduling;
+}
+
+/**
+ * equal timestamps are executed in the order they were inserted
+ */
+static void linkSorted(scheduling_s **link, scheduling_s *scheduling) {
+	while (*link && (*link)->momentX <= scheduling->momentX) {
+		link = &(*link)->nextScheduling_s;
+	}
+	linkAt(link, scheduling);
+}
+
+static void unlinkNode(scheduling_s *scheduling) {
+	*scheduling->pprevScheduling_s = scheduling->nextScheduling_s;
+	if (scheduling->nextScheduling_s) {
+		scheduling->nextScheduling_s->pprevScheduling_s = scheduling->pprevScheduling_s;
+	}
+	scheduling->nextScheduling_s = nullptr;
+	scheduling->pprevScheduling_s = nullptr;
+}
+
+bool TimerWheel::insertTask(scheduling_s *scheduling, efitime_t timeX, action_s action) {
+	ScopePerf perf(PE::EventQueueInsertTask);
+
+	efiAssert(CUSTOM_ERR_ASSERT, action.getCallback() != NULL, "NULL callback", false);
+
+	if (scheduling->action) {
+		// already scheduled, same as EventQueue
+		return false;
+	}
+
+	scheduling_s *previousHead = getHead();
+
+	scheduling->momentX = timeX;
+	scheduling->action = action;
+	link(scheduling);
+	count++;
+
+	return previousHead == nullptr || timeX < previousHead->momentX;
+}
+
+bool TimerWheel::cancel(scheduling_s *scheduling) {
+	if (!scheduling->action) {
+		// not scheduled or already executed
+		return false;
+	}
+
+	unlink(scheduling);
+	count--;
+	scheduling->action = {};
+	return true;
+}
+
+void TimerWheel::link(scheduling_s *scheduling) {
+	efitime_t slot = scheduling->momentX >> slotShift;
+	if (slot < cursor) {
+		// we are late, this one goes into the current slot which is the soonest one
+		slot = cursor;
+	}
+	efitime_t groupDelta = (slot >> TIMER_WHEEL_GROUP_SHIFT) - (cursor >> TIMER_WHEEL_GROUP_SHIFT);
+
+	if (groupDelta == 0) {
+		int index = slot & SLOT_MASK;
+		linkSorted(&nearSlots[index], scheduling);
+		nearMask |= 1u << index;
+	} else if (groupDelta <= TIMER_WHEEL_SLOT_COUNT) {
+		int index = (slot >> TIMER_WHEEL_GROUP_SHIFT) & SLOT_MASK;
+		linkSorted(&farSlots[index], scheduling);
+		farMask |= 1u << index;
+	} else {
+		linkSorted(&overflow, scheduling);
+	}
+}
+
+void TimerWheel::unlink(scheduling_s *scheduling) {
+	scheduling_s **link = scheduling->pprevScheduling_s;
+	unlinkNode(scheduling);
+
+	if (*link != nullptr) {
+		return;
+	}
+	// we might have just emptied a slot
+	if (link >= nearSlots && link < nearSlots + TIMER_WHEEL_SLOT_COUNT) {
+		nearMask &= ~(1u << (link - nearSlots));
+	} else if (link >= farSlots && link < farSlots + TIMER_WHEEL_SLOT_COUNT) {
+		farMask &= ~(1u << (link - farSlots));
+	}
+}
+
+scheduling_s *TimerWheel::getHead() const {
+	if (nearMask) {
+		// nothing is ever linked below the cursor so lowest index is the soonest
+		return nearSlots[firstSetBit(nearMask)];
+	}
+	if (farMask) {
+		// far slots are a ring starting right after the current group
+		int start = ((cursor >> TIMER_WHEEL_GROUP_SHIFT) + 1) & SLOT_MASK;
+		return farSlots[(start + firstSetBit(rotateRight(farMask, start))) & SLOT_MASK];
+	}
+	return overflow;
+}
+
+/**
+ * Moves the cursor towards 'now' over empty slots, pulling far and overflow elements closer as we go.
+ */
+void TimerWheel::advance(efitime_t now) {
+	efitime_t target = now >> slotShift;
+
+	while (cursor < target) {
+		int index = cursor & SLOT_MASK;
+		uint32_t ahead = nearMask >> index;
+		if (ahead & 1) {
+			// current slot still has something pending
+			return;
+		}
+		if (ahead) {
+			efitime_t nextOccupied = cursor + firstSetBit(ahead);
+			cursor = nextOccupied < target ? nextOccupied : target;
+			continue;
+		}
+
+		// current group is done, where is the next pending one?
+		efitime_t group = cursor >> TIMER_WHEEL_GROUP_SHIFT;
+		efitime_t nextGroup;
+		if (farMask) {
+			int start = (group + 1) & SLOT_MASK;
+			nextGroup = group + 1 + firstSetBit(rotateRight(farMask, start));
+		} else if (overflow) {
+			nextGroup = (overflow->momentX >> slotShift) >> TIMER_WHEEL_GROUP_SHIFT;
+		} else {
+			cursor = target;
+			return;
+		}
+
+		efitime_t nextGroupStart = nextGroup << TIMER_WHEEL_GROUP_SHIFT;
+		if (nextGroupStart > target) {
+			cursor = target;
+			migrateOverflow();
+			return;
+		}
+
+		cursor = nextGroupStart;
+		cascade(nextGroup);
+		migrateOverflow();
+	}
+}
+
+/**
+ * Moves one far slot into the near slots, near slots are all empty at this point
+ */
+void TimerWheel::cascade(efitime_t group) {
+	int farIndex = group & SLOT_MASK;
+	scheduling_s *current = farSlots[farIndex];
+	farSlots[farIndex] = nullptr;
+	farMask &= ~(1u << farIndex);
+
+	// far list is sorted so each element goes to the tail of its near slot
+	scheduling_s *previous = nullptr;
+	int previousIndex = -1;
+	while (current) {
+		scheduling_s *next = current->nextScheduling_s;
+		current->nextScheduling_s = nullptr;
+
+		int index = (current->momentX >> slotShift) & SLOT_MASK;
+		linkAt(index == previousIndex ? &previous->nextScheduling_s : &nearSlots[index], current);
+		nearMask |= 1u << index;
+
+		previous = current;
+		previousIndex = index;
+		current = next;
+	}
+}
+
+void TimerWheel::migrateOverflow() {
+	efitime_t lastFarGroup = (cursor >> TIMER_WHEEL_GROUP_SHIFT) + TIMER_WHEEL_SLOT_COUNT;
+
+	while (overflow && ((overflow->momentX >> slotShift) >> TIMER_WHEEL_GROUP_SHIFT) <= lastFarGroup) {
+		scheduling_s *current = overflow;
+		unlinkNode(current);
+		link(current);
+	}
+}
+
+/**
+ * On this layer it does not matter which units are used - us, ms or nt.
+ */
+expected<efitime_t> TimerWheel::getNextEventTime(efitime_t nowX) const {
+	scheduling_s *head = getHead();
+	if (head == nullptr) {
+		return unexpected;
+	}
+	if (head->momentX <= nowX) {
+		// see EventQueue::getNextEventTime
+		return nowX + lateDelay;
+	}
+	return head->momentX;
+}
+
+int TimerWheel::executeAll(efitime_t now) {
+	ScopePerf perf(PE::EventQueueExecuteAll);
+
+	int executionCounter = 0;
+
+	bool didExecute;
+	do {
+		didExecute = executeOne(now);
+		executionCounter += didExecute ? 1 : 0;
+	} while (didExecute);
+
+	return executionCounter;
+}
+
+bool TimerWheel::executeOne(efitime_t now) {
+	advance(now);
+
+	// Read the head every time - a previously executed event could
+	// have inserted something sooner
+	scheduling_s *current = getHead();
+
+	if (!current) {
+		return false;
+	}
+
+	// see EventQueue::executeOne about lateDelay
+	if (current->momentX > now + lateDelay) {
+		return false;
+	}
+
+	// near future - spin wait for the event to happen
+	while (current->momentX > getTimeNowNt()) {
+		UNIT_TEST_BUSY_WAIT_CALLBACK();
+	}
+
+#if ENABLE_PERF_TRACE
+	// see EventQueue::executeOne about lateness
+	perfTraceOnEventExecuted(getTimeNowNt() - current->momentX);
+#endif /* ENABLE_PERF_TRACE */
+
+	unlink(current);
+	count--;
+
+	// Grab the action but clear it in the event so we can reschedule from the action's execution
+	auto action = current->action;
+	current->action = {};
+
+	{
+		ScopePerf perf2(PE::EventQueueExecuteCallback);
+		action.execute();
+	}
+
+	return true;
+}
+
+int TimerWheel::size() const {
+	return count;
+}
+
+static scheduling_s *elementAtIndex(scheduling_s *head, int& index) {
+	for (scheduling_s *current = head; current; current = current->nextScheduling_s) {
+		if (index == 0) {
+			return current;
+		}
+		index--;
+	}
+	return nullptr;
+}
+
+scheduling_s *TimerWheel::getElementAtIndexForUnitText(int index) {
+	// all lists are sorted and levels do not overlap in time, so walking them in order gives sorted order
+	for (int i = 0; i < TIMER_WHEEL_SLOT_COUNT; i++) {
+		if (scheduling_s *result = elementAtIndex(nearSlots[i], index)) {
+			return result;
+		}
+	}
+	int start = (cursor >> TIMER_WHEEL_GROUP_SHIFT) + 1;
+	for (int i = 0; i < TIMER_WHEEL_SLOT_COUNT; i++) {
+		if (scheduling_s *result = elementAtIndex(farSlots[(start + i) & SLOT_MASK], index)) {
+			return result;
+		}
+	}
+	if (scheduling_s *result = elementAtIndex(overflow, index)) {
+		return result;
+	}
+#if EFI_UNIT_TEST
+	firmwareError(OBD_PCM_Processor_Fault, "getForUnitText: null");
+#endif /* EFI_UNIT_TEST */
+	return nullptr;
+}
+
+void TimerWheel::clearList(scheduling_s *head) {
+	while (head) {
+		auto x = head;
+		head = x->nextScheduling_s;
+
+		// Reset this element
+		x->momentX = 0;
+		x->nextScheduling_s = nullptr;
+		x->pprevScheduling_s = nullptr;
+		x->action = {};
+	}
+}
+
+void TimerWheel::clear() {
+	// Flush everything, resetting all scheduling_s as though we'd executed them
+	for (int i = 0; i < TIMER_WHEEL_SLOT_COUNT; i++) {
+		clearList(nearSlots[i]);
+		nearSlots[i] = nullptr;
+		clearList(farSlots[i]);
+		farSlots[i] = nullptr;
+	}
+	clearList(overflow);
+	overflow = nullptr;
+
+	nearMask = 0;
+	farMask = 0;
+	count = 0;
+}
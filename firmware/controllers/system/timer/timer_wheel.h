@@ -0,0 +1,83 @@
+/**
+ * @file timer_wheel.h
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2020
+ */
+
+#pragma once
+
+#include "scheduler.h"
+#include "expected.h"
+
+/**
+ * one bit per slot in an uint32_t occupancy mask
+ */
+#define TIMER_WHEEL_SLOT_COUNT 32
+#define TIMER_WHEEL_GROUP_SHIFT 5
+
+/**
+ * 2^7 = 128 units per slot is a good fit for microsecond timestamps
+ */
+#define TIMER_WHEEL_DEFAULT_SLOT_SHIFT 7
+
+/**
+ * Two-level timer wheel, same contract as EventQueue but insert and removal cost does not depend on
+ * the total number of pending events.
+ *
+ * 'near' level: one sorted list per slot of (1 << slotShift) time units, covering the group of
+ * TIMER_WHEEL_SLOT_COUNT slots the cursor is in.
+ * 'far' level: one sorted list per group, covering the next TIMER_WHEEL_SLOT_COUNT groups. A group is moved into the
+ * near level once the cursor reaches it.
+ * Anything further into the future sits in a sorted overflow list.
+ *
+ * this data structure is NOT thread safe
+ */
+class TimerWheel {
+public:
+	// see comment in EventQueue about lateDelay
+	TimerWheel(efitime_t lateDelay = 0, int slotShift = TIMER_WHEEL_DEFAULT_SLOT_SHIFT)
+		: lateDelay(lateDelay), slotShift(slotShift) {}
+
+	/**
+	 * @return true if the new element is the soonest one, same as EventQueue
+	 */
+	bool insertTask(scheduling_s *scheduling, efitime_t timeX, action_s action);
+	/**
+	 * O(1)
+	 * @return true if element was pending
+	 */
+	bool cancel(scheduling_s *scheduling);
+
+	int executeAll(efitime_t now);
+	bool executeOne(efitime_t now);
+
+	expected<efitime_t> getNextEventTime(efitime_t nowX) const;
+	void clear();
+	int size() const;
+	scheduling_s *getElementAtIndexForUnitText(int index);
+	/**
+	 * @return soonest pending element
+	 */
+	scheduling_s *getHead() const;
+private:
+	void link(scheduling_s *scheduling);
+	void unlink(scheduling_s *scheduling);
+	void advance(efitime_t now);
+	void cascade(efitime_t group);
+	void migrateOverflow();
+	void clearList(scheduling_s *head);
+
+	scheduling_s *nearSlots[TIMER_WHEEL_SLOT_COUNT] = {};
+	scheduling_s *farSlots[TIMER_WHEEL_SLOT_COUNT] = {};
+	scheduling_s *overflow = nullptr;
+	uint32_t nearMask = 0;
+	uint32_t farMask = 0;
+	/**
+	 * slot number (time >> slotShift) the wheel is at, never passes a pending element
+	 */
+	efitime_t cursor = 0;
+	int count = 0;
+	const efitime_t lateDelay;
+	const int slotShift;
+};
@@ -17,7 +17,10 @@
 
 // TX higher priority than RX because the ECU is generally the one transmitting the highest priority messages
 #define PRIO_CAN_TX (NORMALPRIO + 7)
-#define PRIO_CAN_RX (NORMALPRIO + 6)
+// CAN RX thread only timestamps and queues frames, it should not wait for decoding of previous ones
+#define PRIO_CAN_RX (NORMALPRIO + 7)
+// Decoding of received frames, same priority CAN RX had before it was split
+#define PRIO_CAN_RX_PROCESS (NORMALPRIO + 6)
 
 // Less critical harware
 #define PRIO_SERVO (NORMALPRIO + 5)
@@ -32,6 +35,8 @@
 
 // Less important things
 #define PRIO_MMC (NORMALPRIO - 1)
+// SD log sampling should not wait for the card, see mmc_card.cpp
+#define PRIO_MMC_SAMPLER NORMALPRIO
 
 // These can get starved without too much adverse effect
 #define PRIO_AUX_SERIAL NORMALPRIO
@@ -9,6 +9,7 @@ DEV_SRC_CPP = $(DEVELOPMENT_DIR)/hw_layer/poten.cpp \
 	$(DEVELOPMENT_DIR)/engine_emulator.cpp \
 	$(DEVELOPMENT_DIR)/engine_sniffer.cpp \
 	$(DEVELOPMENT_DIR)/logic_analyzer.cpp \
+	$(DEVELOPMENT_DIR)/perf_stats.cpp \
 	$(DEVELOPMENT_DIR)/development/perf_trace.cpp
 	
 DEV_SIMULATOR_SRC_CPP = $(DEVELOPMENT_DIR)/engine_sniffer.cpp
\ No newline at end of file
@@ -37,6 +37,8 @@
 #include "status_loop.h"
 #include "perf_trace.h"
 
+#include <cstring>
+
 #define CHART_DELIMETER	'!'
 
 EXTERN_ENGINE;
@@ -54,6 +56,39 @@ extern uint32_t maxLockedDuration;
 
 static char WAVE_LOGGING_BUFFER[WAVE_LOGGING_SIZE] CCM_OPTIONAL;
 
+/**
+ * Binary records of one chart, a bit more than engineChartSize events since some carry a value
+ */
+#if EFI_PROD_CODE
+#define WAVE_RECORD_COUNT 512
+#else
+#define WAVE_RECORD_COUNT 4096
+#endif
+
+static uint32_t WAVE_RECORDS[2][WAVE_RECORD_COUNT] CCM_OPTIONAL;
+
+/**
+ * Record time unit is the largest power of two number of ticks which is not above ENGINE_SNIFFER_UNIT_US,
+ * that way producers only shift
+ */
+static constexpr int getTimeShift() {
+	int shift = 0;
+	while ((2 << shift) <= US_TO_NT_MULTIPLIER * ENGINE_SNIFFER_UNIT_US) {
+		shift++;
+	}
+	return shift;
+}
+
+#define ENGINE_SNIFFER_TIME_SHIFT getTimeShift()
+
+uint32_t encodeSnifferRecord(uint8_t channel, bool isUp, uint32_t time) {
+	return ((uint32_t)channel << 24) | ((uint32_t)isUp << ENGINE_SNIFFER_TIME_BITS) | (time & ENGINE_SNIFFER_TIME_MASK);
+}
+
+uint32_t encodeSnifferValue(uint32_t value) {
+	return ((uint32_t)ENGINE_SNIFFER_VALUE_CHANNEL << 24) | (value & 0xFFFFFF);
+}
+
 int waveChartUsedSize;
 
 //#define DEBUG_WAVE 1
@@ -72,6 +107,10 @@ static void resetNow(void) {
 #endif // EFI_UNIT_TEST
 
 WaveChart::WaveChart() : logging("wave chart", WAVE_LOGGING_BUFFER, sizeof(WAVE_LOGGING_BUFFER)) {
+	for (int i = 0; i < 2; i++) {
+		buffers[i].records = WAVE_RECORDS[i];
+		memset(buffers[i].channelNames, 0, sizeof(buffers[i].channelNames));
+	}
 }
 
 void WaveChart::init() {
@@ -81,13 +120,34 @@ void WaveChart::init() {
 
 void WaveChart::reset() {
 #if DEBUG_WAVE
-	efiPrintf("reset while at ", counter);
+	efiPrintf("reset while at %d", getSize());
 #endif /* DEBUG_WAVE */
 	logging.reset();
-	counter = 0;
+	swapBuffers();
 	startTimeNt = 0;
 	collectingData = false;
-	logging.appendPrintf( "%s%s", PROTOCOL_ENGINE_SNIFFER, DELIMETER);
+	logging.appendFast(PROTOCOL_ENGINE_SNIFFER DELIMETER);
+}
+
+/**
+ * Clears the inactive buffer together with its channel table and makes it the one producers write to
+ * @return buffer producers were writing to so far
+ */
+SnifferRecordBuffer *WaveChart::swapBuffers() {
+	int retiredIndex = activeBuffer.load(std::memory_order_relaxed);
+	SnifferRecordBuffer *fresh = &buffers[retiredIndex ^ 1];
+
+	// only what was used last time could be dirty
+	uint32_t dirty = minI(fresh->used.load(std::memory_order_relaxed), WAVE_RECORD_COUNT);
+	memset(fresh->records, 0, dirty * sizeof(uint32_t));
+	fresh->used.store(0, std::memory_order_relaxed);
+	fresh->eventCount.store(0, std::memory_order_relaxed);
+	uint32_t channels = minI(fresh->channelCount.load(std::memory_order_relaxed), ENGINE_SNIFFER_MAX_CHANNELS);
+	memset(fresh->channelNames, 0, channels * sizeof(fresh->channelNames[0]));
+	fresh->channelCount.store(0, std::memory_order_relaxed);
+
+	activeBuffer.store(retiredIndex ^ 1, std::memory_order_release);
+	return &buffers[retiredIndex];
 }
 
 void WaveChart::startDataCollection() {
@@ -105,18 +165,30 @@ bool WaveChart::isStartedTooLongAgo() const {
 	return startTimeNt != 0 && NT2US(chartDurationNt) > engineConfiguration->engineChartSize * 1000000 / 20;
 }
 
+/**
+ * Events which carry a value take two records, a chart with these ends a bit earlier
+ */
+int WaveChart::getMaxSize() {
+	return WAVE_RECORD_COUNT;
+}
+
 bool WaveChart::isFull() const {
-	return counter >= CONFIG(engineChartSize);
+	const SnifferRecordBuffer *buffer = &buffers[activeBuffer.load(std::memory_order_acquire)];
+	return buffer->eventCount.load(std::memory_order_relaxed) >= (uint32_t)minI(CONFIG(engineChartSize), getMaxSize())
+		|| buffer->used.load(std::memory_order_relaxed) >= WAVE_RECORD_COUNT;
 }
 
 int WaveChart::getSize() {
-	return counter;
+	return buffers[activeBuffer.load(std::memory_order_acquire)].eventCount.load(std::memory_order_relaxed);
 }
 
 #if ! EFI_UNIT_TEST
 static void printStatus(void) {
 	efiPrintf("engine chart: %s", boolToString(engineConfiguration->isEngineChartEnabled));
 	efiPrintf("engine chart size=%d", engineConfiguration->engineChartSize);
+	if ((int)engineConfiguration->engineChartSize > WaveChart::getMaxSize()) {
+		efiPrintf("engine chart size is limited to %d", WaveChart::getMaxSize());
+	}
 }
 
 static void setChartActive(int value) {
@@ -131,7 +203,7 @@ void setChartSize(int newSize) {
 	if (newSize < 5) {
 		return;
 	}
-	engineConfiguration->engineChartSize = newSize;
+	engineConfiguration->engineChartSize = minI(newSize, WaveChart::getMaxSize());
 	printStatus();
 }
 #endif // EFI_UNIT_TEST
@@ -143,8 +215,73 @@ void WaveChart::publishIfFull() {
 	}
 }
 
+/**
+ * Turns binary records into console text protocol: name!msg!time! where time is in ENGINE_SNIFFER_UNIT_US
+ * since the first event of the chart
+ */
+void WaveChart::decode(const SnifferRecordBuffer *buffer) {
+	uint32_t used = minI(buffer->used.load(std::memory_order_acquire), WAVE_RECORD_COUNT);
+	uint32_t knownChannels = minI(buffer->channelCount.load(std::memory_order_acquire), ENGINE_SNIFFER_MAX_CHANNELS);
+	char valueBuffer[_MAX_FILLER + 2];
+
+	bool hasFirstTime = false;
+	uint32_t firstTime = 0;
+
+	for (uint32_t i = 0; i < used; i++) {
+		uint32_t record = buffer->records[i];
+		uint32_t channel = record >> 24;
+		// zero is a slot reserved by a producer which did not finish in time for this chart
+		// value records are taken together with their event
+		if (record == 0 || channel == ENGINE_SNIFFER_VALUE_CHANNEL || channel > knownChannels) {
+			continue;
+		}
+		const char *name = buffer->channelNames[channel - 1];
+		if (name == nullptr) {
+			continue;
+		}
+
+		if (logging.remainingSize() <= 35) {
+			break;
+		}
+
+		const char *msg;
+		if (i + 1 < used && (buffer->records[i + 1] >> 24) == ENGINE_SNIFFER_VALUE_CHANNEL) {
+			itoa10(valueBuffer, buffer->records[i + 1] & 0xFFFFFF);
+			msg = valueBuffer;
+		} else {
+			msg = (record >> ENGINE_SNIFFER_TIME_BITS) & 1 ? PROTOCOL_ES_UP : PROTOCOL_ES_DOWN;
+		}
+
+		uint32_t time = record & ENGINE_SNIFFER_TIME_MASK;
+		if (!hasFirstTime) {
+			firstTime = time;
+			hasFirstTime = true;
+		}
+		// producers may have been preempted between reserving a slot and taking a timestamp, so
+		// a record could be a bit older than the first one
+		int32_t delta = (int32_t)(((time - firstTime) & ENGINE_SNIFFER_TIME_MASK) << (32 - ENGINE_SNIFFER_TIME_BITS)) >> (32 - ENGINE_SNIFFER_TIME_BITS);
+		if (delta < 0) {
+			delta = 0;
+		}
+		uint32_t time100 = ((uint64_t)delta << ENGINE_SNIFFER_TIME_SHIFT) / (US_TO_NT_MULTIPLIER * ENGINE_SNIFFER_UNIT_US);
+
+		/**
+		 * printf is a heavy method, append is used here as a performance optimization
+		 */
+		logging.appendFast(name);
+		logging.appendChar(CHART_DELIMETER);
+		logging.appendFast(msg);
+		logging.appendChar(CHART_DELIMETER);
+		itoa10(timeBuffer, time100);
+		logging.appendFast(timeBuffer);
+		logging.appendChar(CHART_DELIMETER);
+		logging.terminate();
+	}
+}
+
 void WaveChart::publish() {
-	logging.appendPrintf( DELIMETER);
+	decode(swapBuffers());
+	logging.appendFast(DELIMETER);
 	waveChartUsedSize = logging.loggingSize();
 #if DEBUG_WAVE
 	Logging *l = &chart->logging;
@@ -186,48 +323,76 @@ void WaveChart::addEvent3(const char *name, const char * msg) {
 
 	efiAssertVoid(CUSTOM_ERR_6653, isInitialized, "chart not initialized");
 #if DEBUG_WAVE
-	efiPrintf("current", chart->counter);
+	efiPrintf("current %d", getSize());
 #endif /* DEBUG_WAVE */
 	if (isFull()) {
 		return;
 	}
 
-	// we have multiple threads writing to the same output buffer
-	chibios_rt::CriticalSectionLocker csl;
+	addRecords(name, msg, nowNt);
+#endif /* EFI_TEXT_LOGGING */
+}
 
-	if (counter == 0) {
-		startTimeNt = nowNt;
+/**
+ * Channel ids are handed out on first use. Names are kept by pointer, all of them are static or pin names,
+ * so pointer comparison finds them without looking at the text
+ * @return zero if there is no room for another channel
+ */
+uint8_t WaveChart::getChannelId(SnifferRecordBuffer *buffer, const char *name) {
+	uint32_t count = minI(buffer->channelCount.load(std::memory_order_acquire), ENGINE_SNIFFER_MAX_CHANNELS);
+	for (uint32_t i = 0; i < count; i++) {
+		if (buffer->channelNames[i] == name) {
+			return i + 1;
+		}
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		if (buffer->channelNames[i] != nullptr && strcmp(buffer->channelNames[i], name) == 0) {
+			return i + 1;
+		}
 	}
-	counter++;
 
-	/**
-	 * We want smaller times within a chart in order to reduce packet size.
-	 */
-	/**
-	 * todo: migrate to binary fractions in order to eliminate
-	 * this division? I do not like division
-	 *
-	 * at least that's 32 bit division now
-	 */
-	uint32_t diffNt = nowNt - startTimeNt;
-	uint32_t time100 = NT2US(diffNt / ENGINE_SNIFFER_UNIT_US);
+	// two producers could register the same name at the same time, that's just one extra channel
+	uint32_t index = buffer->channelCount.fetch_add(1, std::memory_order_acq_rel);
+	if (index >= ENGINE_SNIFFER_MAX_CHANNELS) {
+		return 0;
+	}
+	buffer->channelNames[index] = name;
+	return index + 1;
+}
 
-	if (logging.remainingSize() > 35) {
-		/**
-		 * printf is a heavy method, append is used here as a performance optimization
-		 */
-		logging.appendFast(name);
-		logging.appendChar(CHART_DELIMETER);
-		logging.appendFast(msg);
-		logging.appendChar(CHART_DELIMETER);
-//		time100 -= startTime100;
+/**
+ * Lock-free, may be invoked from any thread or interrupt
+ */
+void WaveChart::addRecords(const char *name, const char *msg, efitick_t nowNt) {
+	SnifferRecordBuffer *buffer = &buffers[activeBuffer.load(std::memory_order_acquire)];
+	uint8_t channel = getChannelId(buffer, name);
 
-		itoa10(timeBuffer, time100);
-		logging.appendFast(timeBuffer);
-		logging.appendChar(CHART_DELIMETER);
-		logging.terminate();
+	// anything but an edge is a number, see TDC rpm
+	bool hasValue = msg[0] >= '0' && msg[0] <= '9';
+	uint32_t size = hasValue ? 2 : 1;
+
+	uint32_t index = buffer->used.fetch_add(size, std::memory_order_relaxed);
+	if (channel == 0 || index + size > WAVE_RECORD_COUNT) {
+		droppedCount++;
+		return;
 	}
-#endif /* EFI_TEXT_LOGGING */
+
+	if (index == 0) {
+		startTimeNt = nowNt;
+	}
+
+	if (hasValue) {
+		uint32_t value = 0;
+		for (const char *c = msg; *c >= '0' && *c <= '9'; c++) {
+			value = value * 10 + (*c - '0');
+		}
+		// value has to be in place before its event becomes visible
+		buffer->records[index + 1] = encodeSnifferValue(value);
+	}
+
+	uint32_t time = (uint32_t)(nowNt >> ENGINE_SNIFFER_TIME_SHIFT);
+	buffer->records[index] = encodeSnifferRecord(channel, msg[0] == PROTOCOL_ES_UP[0], time);
+	buffer->eventCount.fetch_add(1, std::memory_order_relaxed);
 }
 
 void initWaveChart(WaveChart *chart) {
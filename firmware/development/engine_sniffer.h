@@ -13,6 +13,41 @@
 #if EFI_ENGINE_SNIFFER
 #include "datalogging.h"
 
+#include <atomic>
+
+/**
+ * Producers never format text: each event is stored as a binary record, {channel id:8, edge:1, time:23},
+ * time in units of (1 << ENGINE_SNIFFER_TIME_SHIFT) ticks modulo 2^23.
+ * An event which carries a number instead of an edge, like TDC rpm, is followed by a record of
+ * ENGINE_SNIFFER_VALUE_CHANNEL with the 24 bit value.
+ * Channel ids start from 1 so that zero is never a valid record.
+ *
+ * Records are turned into the console text protocol on the publishing thread, see WaveChart::publish()
+ */
+#define ENGINE_SNIFFER_VALUE_CHANNEL 0xFF
+#define ENGINE_SNIFFER_MAX_CHANNELS 64
+
+#define ENGINE_SNIFFER_TIME_BITS 23
+#define ENGINE_SNIFFER_TIME_MASK ((1 << ENGINE_SNIFFER_TIME_BITS) - 1)
+
+uint32_t encodeSnifferRecord(uint8_t channel, bool isUp, uint32_t time);
+uint32_t encodeSnifferValue(uint32_t value);
+
+/**
+ * Lock-free buffer of one chart worth of records. Any number of producers reserve space with
+ * a single atomic add, a reserved slot reads as zero until its producer has written it.
+ * Channel ids are only valid within the buffer, each chart starts with an empty channel table
+ * so that renamed or no longer used channels do not take room forever.
+ */
+struct SnifferRecordBuffer {
+	uint32_t *records;
+	std::atomic<uint32_t> used{0};
+	std::atomic<uint32_t> eventCount{0};
+
+	const char *channelNames[ENGINE_SNIFFER_MAX_CHANNELS];
+	std::atomic<uint32_t> channelCount{0};
+};
+
 /**
  * @brief	rusEfi console sniffer data buffer
  */
@@ -29,14 +64,39 @@ public:
 	void publish();
 	bool isFull() const;
 	bool isStartedTooLongAgo() const;
+	/**
+	 * engineChartSize is capped by the size of record buffers
+	 */
+	static int getMaxSize();
 	// looks like this is only used by functional tests on real hardware
 	efitick_t pauseEngineSnifferUntilNt = 0;
 	int getSize();
+	/**
+	 * Events which did not fit into record buffer
+	 */
+	uint32_t getDroppedCount() const {
+		return droppedCount;
+	}
+#if EFI_UNIT_TEST
+	const char *getTextForUnitTest() const {
+		return logging.buffer;
+	}
+#endif /* EFI_UNIT_TEST */
 
 private:
+	uint8_t getChannelId(SnifferRecordBuffer *buffer, const char *name);
+	void addRecords(const char *name, const char *msg, efitick_t nowNt);
+	SnifferRecordBuffer *swapBuffers();
+	void decode(const SnifferRecordBuffer *buffer);
+
 	Logging logging;
 	char timeBuffer[_MAX_FILLER + 2];
-	uint32_t counter = 0;
+
+	SnifferRecordBuffer buffers[2];
+	// buffer producers write to, the other one is being decoded or waiting to be activated
+	std::atomic<int> activeBuffer{0};
+
+	uint32_t droppedCount = 0;
 	/**
 	 * We want to avoid visual jitter thus we want the left edge to be aligned
 	 * https://github.com/rusefi/rusefi/issues/780
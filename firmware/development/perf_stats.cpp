@@ -0,0 +1,88 @@
+/**
+ * @file perf_stats.cpp
+ * @brief Always-on duration statistics for each PE scope, see perf_stats.h
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2020
+ */
+
+#include "global.h"
+#include "perf_stats.h"
+
+#if EFI_PERF_STATS
+
+#include <cstring>
+
+static perf_stats_s perfStats;
+
+// Same critical section as in perf trace: a scope which is also used from an ISR could end while a thread
+// is updating the same counters
+#if EFI_PROD_CODE
+#define PERF_STATS_LOCK() uint32_t prim = __get_PRIMASK(); __disable_irq();
+#define PERF_STATS_UNLOCK() if (!prim) { __enable_irq(); }
+#else
+#define PERF_STATS_LOCK()
+#define PERF_STATS_UNLOCK()
+#endif /* EFI_PROD_CODE */
+
+int perfStatsGetBucketIndex(uint32_t durationNt) {
+	if (durationNt < (1u << PERF_STATS_FIRST_BUCKET_SHIFT)) {
+		return 0;
+	}
+	// index of highest set bit
+	int log2 = 31 - __builtin_clz(durationNt);
+	int index = log2 - PERF_STATS_FIRST_BUCKET_SHIFT + 1;
+	return index < PERF_STATS_BUCKET_COUNT ? index : PERF_STATS_BUCKET_COUNT - 1;
+}
+
+void perfStatsAdd(PE event, uint32_t durationNt) {
+	size_t eventIndex = (size_t)event;
+	if (eventIndex >= PERF_STATS_EVENT_COUNT) {
+		return;
+	}
+	int bucketIndex = perfStatsGetBucketIndex(durationNt);
+
+	perf_event_stats_s *stats = &perfStats.events[eventIndex];
+
+	PERF_STATS_LOCK();
+	if (stats->count == 0 || durationNt < stats->minNt) {
+		stats->minNt = durationNt;
+	}
+	if (durationNt > stats->maxNt) {
+		stats->maxNt = durationNt;
+	}
+	stats->count++;
+	stats->buckets[bucketIndex]++;
+	PERF_STATS_UNLOCK();
+}
+
+const perf_stats_s *getPerfStats() {
+	return &perfStats;
+}
+
+void perfStatsReset() {
+	PERF_STATS_LOCK();
+	memset(&perfStats, 0, sizeof(perfStats));
+	PERF_STATS_UNLOCK();
+}
+
+uint32_t perfStatsGetPercentileNt(PE event, int percent) {
+	const perf_event_stats_s *stats = &perfStats.events[(size_t)event];
+	if (stats->count == 0) {
+		return 0;
+	}
+
+	// rank of the sample we are looking for, rounded up
+	uint64_t rank = ((uint64_t)stats->count * percent + 99) / 100;
+	uint64_t seen = 0;
+	for (int i = 0; i < PERF_STATS_BUCKET_COUNT - 1; i++) {
+		seen += stats->buckets[i];
+		if (seen >= rank) {
+			uint32_t upperBound = (1u << (i + PERF_STATS_FIRST_BUCKET_SHIFT)) - 1;
+			return upperBound < stats->maxNt ? upperBound : stats->maxNt;
+		}
+	}
+	return stats->maxNt;
+}
+
+#endif /* EFI_PERF_STATS */
@@ -0,0 +1,48 @@
+/**
+ * @file perf_stats.h
+ * @brief Always-on duration statistics for each PE scope
+ *
+ * Unlike perf trace which records a short window of raw begin/end entries, these are accumulated forever with
+ * constant memory: count, min, max and a log2 bucket histogram of ScopePerf durations per PE value.
+ * Raw statistics are exposed via TS_GET_STRUCT so that a tool can compute percentiles.
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2020
+ */
+
+#pragma once
+
+#include "perf_trace.h"
+
+/**
+ * Bucket 0 holds durations below 2^PERF_STATS_FIRST_BUCKET_SHIFT ticks, bucket N holds
+ * [2^(N + PERF_STATS_FIRST_BUCKET_SHIFT - 1), 2^(N + PERF_STATS_FIRST_BUCKET_SHIFT)) ticks and the last bucket
+ * is open ended. At 168MHz that is from 0.2us to 3ms and above.
+ */
+#define PERF_STATS_BUCKET_COUNT 16
+#define PERF_STATS_FIRST_BUCKET_SHIFT 5
+
+#define PERF_STATS_EVENT_COUNT ((size_t)PE::Count)
+
+struct perf_event_stats_s {
+	uint32_t count;
+	uint32_t minNt;
+	uint32_t maxNt;
+	uint32_t buckets[PERF_STATS_BUCKET_COUNT];
+};
+
+/**
+ * Indexed by PE value
+ */
+struct perf_stats_s {
+	perf_event_stats_s events[PERF_STATS_EVENT_COUNT];
+};
+
+const perf_stats_s *getPerfStats();
+void perfStatsReset();
+
+int perfStatsGetBucketIndex(uint32_t durationNt);
+/**
+ * @return upper bound of the histogram bucket where given percentile falls, never above max
+ */
+uint32_t perfStatsGetPercentileNt(PE event, int percent);
@@ -11,6 +11,9 @@
 #include "perf_trace.h"
 #include "efitime.h"
 #include "os_util.h"
+#include "efilib.h"
+
+#include <algorithm>
 
 #ifndef ENABLE_PERF_TRACE
 #error ENABLE_PERF_TRACE must be defined!
@@ -47,11 +50,27 @@ struct TraceEntry
 static_assert(sizeof(TraceEntry) == 8);
 
 // This buffer stores a trace - we write the full buffer once, then disable tracing
+// In continuous mode we keep going around until triggered
 static TraceEntry s_traceBuffer[TRACE_BUFFER_LENGTH];
 static size_t s_nextIdx = 0;
+// entries of s_traceBuffer which belong to the last finished trace
+static size_t s_capturedEntries = 0;
 
 static bool s_isTracing = false;
 
+// continuous mode state
+static bool s_isContinuous = false;
+static bool s_hasWrapped = false;
+static uint8_t s_triggers = 0;
+static uint32_t s_lateThresholdNt = 0;
+static size_t s_postTriggerEntries = 0;
+// how many more entries to record before freezing, zero if not triggered yet
+static size_t s_remainingEntries = 0;
+
+// Same critical section as in perfEventImpl
+#define PERF_TRACE_LOCK() uint32_t prim = __get_PRIMASK(); __disable_irq();
+#define PERF_TRACE_UNLOCK() if (!prim) { __enable_irq(); }
+
 static void perfEventImpl(PE event, EPhase phase)
 {
 	// Bail if we aren't allowed to trace
@@ -76,19 +95,27 @@ static void perfEventImpl(PE event, EPhase phase)
 	// In addition, if we want to trace lock/unlock events, we can't
 	// be locking ourselves from the trace functionality.
 	{
-		uint32_t prim = __get_PRIMASK();
-		__disable_irq();
+		PERF_TRACE_LOCK();
 
 		idx = s_nextIdx++;
 		if (s_nextIdx >= TRACE_BUFFER_LENGTH) {
 			s_nextIdx = 0;
-			s_isTracing = false;
+			s_hasWrapped = true;
+			if (!s_isContinuous) {
+				s_isTracing = false;
+			}
 		}
 
-		// Restore previous interrupt state - don't restore if they weren't enabled
-		if (!prim) {
-			__enable_irq();
+		if (s_remainingEntries > 0) {
+			s_remainingEntries--;
+			if (s_remainingEntries == 0) {
+				// post-trigger history is complete
+				s_isTracing = false;
+			}
 		}
+
+		// Restore previous interrupt state - don't restore if they weren't enabled
+		PERF_TRACE_UNLOCK();
 	}
 
 	// We can safely write data out of the lock, our spot is reserved
@@ -124,12 +151,80 @@ void perfEventInstantGlobal(PE event) {
 }
 
 void perfTraceEnable() {
+	PERF_TRACE_LOCK();
+	s_isContinuous = false;
+	s_remainingEntries = 0;
+	s_nextIdx = 0;
+	s_hasWrapped = false;
+	s_capturedEntries = 0;
+	s_isTracing = true;
+	PERF_TRACE_UNLOCK();
+}
+
+void perfTraceArm(uint8_t triggers, size_t postTriggerEntries, uint32_t lateThresholdUs) {
+	PERF_TRACE_LOCK();
+	s_triggers = triggers;
+	s_lateThresholdNt = US2NT(lateThresholdUs);
+	// at least the trigger marker itself, and some pre-trigger history
+	s_postTriggerEntries = clampI(1, postTriggerEntries, TRACE_BUFFER_LENGTH - 1);
+	s_remainingEntries = 0;
+	s_nextIdx = 0;
+	s_hasWrapped = false;
+	s_capturedEntries = 0;
+	s_isContinuous = true;
 	s_isTracing = true;
+	PERF_TRACE_UNLOCK();
+}
+
+void perfTraceTrigger(uint8_t trigger) {
+	if (!s_isContinuous || !s_isTracing || (s_triggers & trigger) == 0) {
+		return;
+	}
+
+	bool isFirst;
+	{
+		PERF_TRACE_LOCK();
+		isFirst = s_remainingEntries == 0;
+		if (isFirst) {
+			s_remainingEntries = s_postTriggerEntries;
+		}
+		PERF_TRACE_UNLOCK();
+	}
+
+	if (isFirst) {
+		// mark the spot, this is also the first post-trigger entry
+		perfEventInstantGlobal(PE::PerfTraceTrigger);
+	}
+}
+
+void perfTraceOnEventExecuted(int32_t lateNt) {
+	if (lateNt > 0 && (uint32_t)lateNt > s_lateThresholdNt) {
+		perfTraceTrigger(PERF_TRACE_TRIGGER_LATE_EVENT);
+	}
 }
 
 const TraceBufferResult perfTraceGetBuffer() {
+	if (s_isContinuous && s_isTracing) {
+		// not triggered yet, nothing to show
+		return {reinterpret_cast<const uint8_t*>(s_traceBuffer), 0};
+	}
+
 	// stop tracing if you try to get the buffer early
 	s_isTracing = false;
 
-	return {reinterpret_cast<const uint8_t*>(s_traceBuffer), sizeof(s_traceBuffer)};
+	if (s_hasWrapped) {
+		if (s_isContinuous) {
+			// oldest entry goes first, same as one-shot trace
+			std::rotate(s_traceBuffer, s_traceBuffer + s_nextIdx, s_traceBuffer + TRACE_BUFFER_LENGTH);
+		}
+		s_capturedEntries = TRACE_BUFFER_LENGTH;
+	} else if (s_nextIdx != 0) {
+		// anything past s_nextIdx is left over from an older trace
+		s_capturedEntries = s_nextIdx;
+	}
+	// repeated query returns the same trace
+	s_nextIdx = 0;
+	s_hasWrapped = false;
+
+	return {reinterpret_cast<const uint8_t*>(s_traceBuffer), s_capturedEntries * sizeof(TraceEntry)};
 }
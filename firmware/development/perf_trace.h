@@ -65,9 +65,13 @@ enum class PE : uint8_t {
 	SoftwareKnockProcess,
 	LogTriggerTooth,
 	LuaTickFunction,
+	ScheduleAngleBasedEvents,
+	PerfTraceTrigger,
 	// enum_end_tag
 	// The tag above is consumed by PerfTraceTool.java
 	// please note that the tool requires a comma at the end of last value
+	// not an event: number of values above, keep it last
+	Count,
 };
 
 void perfEventBegin(PE event);
@@ -77,36 +81,74 @@ void perfEventInstantGlobal(PE event);
 // Enable one buffer's worth of perf tracing, and retrieve the buffer size in bytes
 void perfTraceEnable();
 
+// Continuous trace trigger conditions, bit mask
+#define PERF_TRACE_TRIGGER_ERROR 1
+#define PERF_TRACE_TRIGGER_WARNING 2
+#define PERF_TRACE_TRIGGER_LATE_EVENT 4
+
+/**
+ * Continuous mode: keep tracing into a circular buffer until one of the 'triggers' conditions happens,
+ * then record 'postTriggerEntries' more entries and freeze. The rest of the buffer holds pre-trigger history.
+ * @param lateThresholdUs how late an event queue callback has to be for PERF_TRACE_TRIGGER_LATE_EVENT
+ */
+void perfTraceArm(uint8_t triggers, size_t postTriggerEntries, uint32_t lateThresholdUs);
+// Freeze armed continuous trace if 'trigger' is one of the armed conditions
+void perfTraceTrigger(uint8_t trigger);
+// Invoked by event queues for each executed callback
+void perfTraceOnEventExecuted(int32_t lateNt);
+
 struct TraceBufferResult
 {
 	const uint8_t* const Buffer;
 	const size_t Size;
 };
 
-// Retrieve the trace buffer
+// Retrieve the trace buffer, oldest entry first
+// Size covers only entries recorded by the last trace, full buffer size means it has wrapped
+// Empty while continuous trace is armed and not triggered yet
 const TraceBufferResult perfTraceGetBuffer();
 
-#if ENABLE_PERF_TRACE
+// Accumulates one ScopePerf duration into the per-event statistics, see perf_stats.h
+void perfStatsAdd(PE event, uint32_t durationNt);
+
+#if ENABLE_PERF_TRACE || EFI_PERF_STATS
+// defined in efitime.h, repeated here to keep this header light
+extern "C" uint32_t getTimeNowLowerNt(void);
+
 class ScopePerf
 {
 public:
 	ScopePerf(PE event) : m_event(event) {
+#if EFI_PERF_STATS
+		m_start = getTimeNowLowerNt();
+#endif /* EFI_PERF_STATS */
+#if ENABLE_PERF_TRACE
 		perfEventBegin(event);
+#endif /* ENABLE_PERF_TRACE */
 	}
 
 	~ScopePerf()
 	{
+#if ENABLE_PERF_TRACE
 		perfEventEnd(m_event);
+#endif /* ENABLE_PERF_TRACE */
+#if EFI_PERF_STATS
+		// unsigned math takes care of timer wrap-around
+		perfStatsAdd(m_event, getTimeNowLowerNt() - m_start);
+#endif /* EFI_PERF_STATS */
 	}
 
 private:
 	const PE m_event;
+#if EFI_PERF_STATS
+	uint32_t m_start;
+#endif /* EFI_PERF_STATS */
 };
 
-#else /* if ENABLE_PERF_TRACE */
+#else /* ENABLE_PERF_TRACE || EFI_PERF_STATS */
 
 struct ScopePerf {
 	ScopePerf(PE) {}
 };
 
-#endif /* ENABLE_PERF_TRACE */
+#endif /* ENABLE_PERF_TRACE || EFI_PERF_STATS */
@@ -3,7 +3,7 @@
 #include "adc_inputs.h"
 #include "engine.h"
 #include "perf_trace.h"
-#include "biquad.h"
+#include "biquad_bank.h"
 
 EXTERN_ENGINE;
 
@@ -18,16 +18,21 @@ void AdcSubscription::SubscribeSensor(FunctionalSensor &sensor,
 
 #else
 
+#define ADC_SUBSCRIPTION_COUNT 16
+
 struct AdcSubscriptionEntry {
 	FunctionalSensor *Sensor;
 	float VoltsPerAdcVolt;
 	adc_channel_e Channel;
-	Biquad Filter;
 	bool HasUpdated = false;
 };
 
 static size_t s_nextEntry = 0;
-static AdcSubscriptionEntry s_entries[16];
+static AdcSubscriptionEntry s_entries[ADC_SUBSCRIPTION_COUNT];
+
+// Filter of entry i is channel i of the bank
+static BiquadBank<ADC_SUBSCRIPTION_COUNT> s_filters;
+static float s_sensorVolts[ADC_SUBSCRIPTION_COUNT];
 
 void AdcSubscription::SubscribeSensor(FunctionalSensor &sensor,
 									  adc_channel_e channel,
@@ -63,7 +68,7 @@ void AdcSubscription::SubscribeSensor(FunctionalSensor &sensor,
 	entry.Sensor = &sensor;
 	entry.VoltsPerAdcVolt = voltsPerAdcVolt;
 	entry.Channel = channel;
-	entry.Filter.configureLowpass(SLOW_ADC_RATE, lowpassCutoff);
+	s_filters.configureLowpass(s_nextEntry, SLOW_ADC_RATE, lowpassCutoff);
 
 	s_nextEntry++;
 }
@@ -81,13 +86,18 @@ void AdcSubscription::UpdateSubscribers(efitick_t nowNt) {
 		// seeing this value for a long time.  This prevents a slow ramp-up
 		// towards the correct value just after startup
 		if (!entry.HasUpdated) {
-			entry.Filter.cookSteadyState(sensorVolts);
+			s_filters.cookSteadyState(i, sensorVolts);
 			entry.HasUpdated = true;
 		}
 
-		float filtered = entry.Filter.filter(sensorVolts);
+		s_sensorVolts[i] = sensorVolts;
+	}
 
-		entry.Sensor->postRawValue(filtered, nowNt);
+	// All channels in one go, filtered in place
+	s_filters.filter(s_sensorVolts, s_sensorVolts, s_nextEntry);
+
+	for (size_t i = 0; i < s_nextEntry; i++) {
+		s_entries[i].Sensor->postRawValue(s_sensorVolts[i], nowNt);
 	}
 }
 
@@ -25,6 +25,7 @@
 #include "mpu_util.h"
 #include "engine.h"
 #include "thread_priority.h"
+#include "spsc_queue.h"
 
 EXTERN_ENGINE;
 
@@ -131,6 +132,23 @@ static const CANConfig canConfig1000 = {
 
 static const CANConfig *canConfig = &canConfig500;
 
+struct CanRxQueueEntry {
+	CANRxFrame frame;
+	// time of arrival, not time of processing
+	efitick_t nowNt;
+};
+
+#ifndef CAN_RX_QUEUE_SIZE
+#define CAN_RX_QUEUE_SIZE 32
+#endif
+
+static SpscQueue<CanRxQueueEntry, CAN_RX_QUEUE_SIZE> canRxQueue CCM_OPTIONAL;
+static chibios_rt::BinarySemaphore canRxQueueSemaphore(/* taken =*/ true);
+
+/**
+ * Only takes frames out of hardware mailboxes and timestamps them, so that a burst of frames
+ * does not wait for decoding of previous ones and every frame gets its own arrival time.
+ */
 class CanRead final : public ThreadController<UTILITY_THREAD_STACK_SIZE> {
 public:
 	CanRead()
@@ -148,24 +166,54 @@ public:
 
 		while (true) {
 			// Block until we get a message
-			msg_t result = canReceiveTimeout(device, CAN_ANY_MAILBOX, &m_buffer, TIME_INFINITE);
+			msg_t result = canReceiveTimeout(device, CAN_ANY_MAILBOX, &m_entry.frame, TIME_INFINITE);
 
 			if (result != MSG_OK) {
 				continue;
 			}
+			m_entry.nowNt = getTimeNowNt();
 
-			// Process the message
 			canReadCounter++;
 
-			processCanRxMessage(m_buffer, getTimeNowNt());
+			// if the queue is full the frame is dropped and counted, see canInfo
+			if (!canRxQueue.push(m_entry)) {
+				// shows up in warning codes, unlike the counter it is not lost once debug mode is changed
+				warning(CUSTOM_ERR_CAN_RX_OVERRUN, "CAN RX queue overrun, %d frames dropped", canRxQueue.getOverrunCount());
+			}
+			canRxQueueSemaphore.signal();
+		}
+	}
+
+private:
+	CanRxQueueEntry m_entry;
+};
+
+/**
+ * Decodes queued frames in batches, each one with the time it was received
+ */
+class CanRxProcess final : public ThreadController<UTILITY_THREAD_STACK_SIZE> {
+public:
+	CanRxProcess()
+		: ThreadController("CAN RX process", PRIO_CAN_RX_PROCESS)
+	{
+	}
+
+	void ThreadTask() override {
+		while (true) {
+			canRxQueueSemaphore.wait();
+
+			while (canRxQueue.pop(m_entry)) {
+				processCanRxMessage(m_entry.frame, m_entry.nowNt);
+			}
 		}
 	}
 
 private:
-	CANRxFrame m_buffer;
+	CanRxQueueEntry m_entry;
 };
 
 static CanRead canRead CCM_OPTIONAL;
+static CanRxProcess canRxProcess CCM_OPTIONAL;
 static CanWrite canWrite CCM_OPTIONAL;
 
 static void canInfo(void) {
@@ -181,6 +229,9 @@ static void canInfo(void) {
 			engineConfiguration->canSleepPeriodMs);
 
 	efiPrintf("CAN rx_cnt=%d/tx_ok=%d/tx_not_ok=%d", canReadCounter, canWriteOk, canWriteNotOk);
+	efiPrintf("CAN rx queue overruns=%d high water=%d/%d", canRxQueue.getOverrunCount(),
+			canRxQueue.getHighWaterMark(), canRxQueue.getSize());
+	printCanTxStats();
 }
 
 void setCanType(int type) {
@@ -193,6 +244,10 @@ void postCanState(TunerStudioOutputChannels *tsOutputChannels) {
 	tsOutputChannels->debugIntField1 = isCanEnabled ? canReadCounter : -1;
 	tsOutputChannels->debugIntField2 = isCanEnabled ? canWriteOk : -1;
 	tsOutputChannels->debugIntField3 = isCanEnabled ? canWriteNotOk : -1;
+	tsOutputChannels->debugIntField4 = isCanEnabled ? canRxQueue.getOverrunCount() : -1;
+	tsOutputChannels->debugIntField5 = isCanEnabled ? canRxQueue.getHighWaterMark() : -1;
+	tsOutputChannels->debugFloatField1 = getCanTxBusLoad();
+	tsOutputChannels->debugFloatField2 = getCanTxMaxEncodeUs();
 }
 #endif /* EFI_TUNER_STUDIO */
 
@@ -285,6 +340,7 @@ void initCan(void) {
 	}
 
 	if (CONFIG(canReadEnabled)) {
+		canRxProcess.Start();
 		canRead.Start();
 	}
 }
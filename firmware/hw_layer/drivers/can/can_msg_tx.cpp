@@ -20,6 +20,16 @@ EXTERN_CONFIG
 extern int canWriteOk;
 extern int canWriteNotOk;
 
+/**
+ * Bits on the wire of all frames sent, without bit stuffing: SOF, arbitration, control, CRC, ACK, EOF
+ * and interframe space add up to 47 bits for standard and 67 bits for extended frames.
+ */
+uint32_t canWriteBits = 0;
+
+static uint32_t getFrameBits(bool isExtended, uint8_t dlc) {
+	return (isExtended ? 67 : 47) + 8 * dlc;
+}
+
 /*static*/ CANDriver* CanTxMessage::s_device = nullptr;
 
 /*static*/ void CanTxMessage::setDevice(CANDriver* device) {
@@ -68,6 +78,11 @@ CanTxMessage::~CanTxMessage() {
 	msg_t msg = canTransmit(device, CAN_ANY_MAILBOX, &m_frame, TIME_MS2I(100));
 	if (msg == MSG_OK) {
 		canWriteOk++;
+#ifndef STM32H7XX
+		canWriteBits += getFrameBits(m_frame.IDE == CAN_IDE_EXT, m_frame.DLC);
+#else /* if STM32H7XX */
+		canWriteBits += getFrameBits(m_frame.common.XTD, m_frame.DLC);
+#endif
 	} else {
 		canWriteNotOk++;
 	}
@@ -25,7 +25,8 @@
 #include "hardware.h"
 #include "engine_configuration.h"
 #include "status_loop.h"
-#include "buffered_writer.h"
+#include "log_recovery.h"
+#include "block_ring_writer.h"
 #include "mass_storage_init.h"
 #include "thread_priority.h"
 
@@ -47,14 +48,54 @@ static bool fs_ready = false;
 
 EXTERN_ENGINE;
 
-// at about 20Hz we write about 2Kb per second, looks like we flush once every ~2 seconds
-#define F_SYNC_FREQUENCY 10
+/**
+ * Samples are collected into a ring of blocks by the sampler thread, and the writer thread
+ * stores whole blocks so that a slow card delays the file but not the samples.
+ * Ring is DMA source so it lives in NO_CACHE memory, which is only 16k on F7 and 32k on H7 and is shared
+ * with FATFS and ADC buffers, these get smaller blocks.
+ */
+#ifndef SD_LOG_BLOCK_SIZE
+#if defined(STM32F7XX) || defined(STM32H7XX)
+#define SD_LOG_BLOCK_SIZE 1024
+#else
+#define SD_LOG_BLOCK_SIZE 4096
+#endif
+#endif
+#ifndef SD_LOG_BLOCK_COUNT
+#define SD_LOG_BLOCK_COUNT 3
+#endif
+
+/**
+ * Sampler hands over a partially filled block at least this often, so that power loss costs about this much
+ * of the log rather than a whole block
+ */
+#define SD_LOG_FLUSH_PERIOD_MS 1000
+
+/**
+ * f_sync once every this many blocks.
+ * At about 20Hz we write about 2Kb per second, that's one f_sync every ~8 seconds.
+ * See 'sdinfo' for measured f_write and f_sync latency.
+ */
+#define F_SYNC_FREQUENCY 4
+
+/**
+ * New log files get one contiguous region of this size up front so that f_write never has to walk and extend
+ * the FAT chain, which is where most of write latency variance on cheap cards comes from.
+ * File is truncated to actual data on unmount, see recoverPreallocatedLogs() for the power loss case.
+ * Zero to disable.
+ */
+#ifndef SD_LOG_PREALLOCATE_SIZE
+#define SD_LOG_PREALLOCATE_SIZE (32 * 1024 * 1024)
+#endif
 
 int totalLoggedBytes = 0;
 static int fileCreatedCounter = 0;
 static int writeCounter = 0;
 static int totalWritesCounter = 0;
 static int totalSyncCounter = 0;
+static uint32_t maxWriteUs = 0;
+static uint32_t maxSyncUs = 0;
+static uint32_t totalSyncUs = 0;
 
 /**
  * on't re-read SD card spi device after boot - it could change mid transaction (TS thread could preempt),
@@ -71,7 +112,8 @@ spi_device_e mmcSpiDevice = SPI_NONE;
 #define LS_RESPONSE "ls_result"
 #define FILE_LIST_MAX_COUNT 20
 
-static THD_WORKING_AREA(mmcThreadStack, 3 * UTILITY_THREAD_STACK_SIZE);		// MMC monitor thread
+static THD_WORKING_AREA(mmcThreadStack, 3 * UTILITY_THREAD_STACK_SIZE);		// MMC monitor and writer thread
+static THD_WORKING_AREA(mmcSamplerThreadStack, 2 * UTILITY_THREAD_STACK_SIZE);
 
 #if HAL_USE_MMC_SPI
 /**
@@ -95,6 +137,7 @@ static NO_CACHE FATFS MMC_FS;
 static int fatFsErrors = 0;
 
 static void mmcUnMount(void);
+static void sdLogStatistics();
 
 static void setSdCardReady(bool value) {
 	fs_ready = value;
@@ -112,6 +155,28 @@ static void printError(const char *str, FRESULT f_error) {
 
 static FIL FDLogFile NO_CACHE;
 static FIL FDCurrFile NO_CACHE;
+// true if FDLogFile size is the preallocated size rather than size of the data
+static bool isLogFilePreallocated = false;
+
+#if SD_LOG_PREALLOCATE_SIZE > 0
+/**
+ * Preallocated region is not erased, it could hold blocks of an older log which happen to continue our rolling
+ * counter. Bytes right after our data are always overwritten with this, 0xFF is not a data block type so
+ * findLogDataEnd() stops there.
+ */
+static NO_CACHE char logEndMarker[MAX_RECOVERY_BLOCK_SIZE];
+
+static bool writeLogEndMarker(FSIZE_t position) {
+	if (position + sizeof(logEndMarker) > SD_LOG_PREALLOCATE_SIZE) {
+		// do not grow the file past the region
+		return true;
+	}
+	UINT bytesWritten = 0;
+	return f_lseek(&FDLogFile, position) == FR_OK
+		&& f_write(&FDLogFile, logEndMarker, sizeof(logEndMarker), &bytesWritten) == FR_OK
+		&& bytesWritten == sizeof(logEndMarker);
+}
+#endif /* SD_LOG_PREALLOCATE_SIZE */
 
 // 10 because we want at least 4 character name
 #define MIN_FILE_INDEX 10
@@ -134,6 +199,7 @@ static void sdStatistics(void) {
 	if (isSdCardAlive()) {
 		efiPrintf("filename=%s size=%d", logName, totalLoggedBytes);
 	}
+	sdLogStatistics();
 }
 
 static void incLogFileName(void) {
@@ -208,12 +274,31 @@ static void createLogFile(void) {
 		return;
 	}
 
-	err = f_lseek(&FDLogFile, f_size(&FDLogFile)); // Move to end of the file to append data
-	if (err) {
-		sdStatus = SD_STATE_SEEK_FAILED;
-		warning(CUSTOM_ERR_SD_SEEK_FAILED, "SD: seek failed");
-		printError("Seek error", err);
-		return;
+	isLogFilePreallocated = false;
+#if SD_LOG_PREALLOCATE_SIZE > 0
+	if (f_size(&FDLogFile) == 0) {
+		// we stay at the start of the region and overwrite it sequentially
+		err = f_expand(&FDLogFile, SD_LOG_PREALLOCATE_SIZE, /* allocate now */ 1);
+		if (err == FR_OK) {
+			memset(logEndMarker, 0xFF, sizeof(logEndMarker));
+			// stale header would make an older log look like ours
+			isLogFilePreallocated = writeLogEndMarker(0) && f_lseek(&FDLogFile, 0) == FR_OK;
+		}
+		if (!isLogFilePreallocated) {
+			// not enough contiguous space, fall back to a regular growing file
+			printError("Preallocate error", err);
+		}
+	}
+#endif /* SD_LOG_PREALLOCATE_SIZE */
+
+	if (!isLogFilePreallocated) {
+		err = f_lseek(&FDLogFile, f_size(&FDLogFile)); // Move to end of the file to append data
+		if (err) {
+			sdStatus = SD_STATE_SEEK_FAILED;
+			warning(CUSTOM_ERR_SD_SEEK_FAILED, "SD: seek failed");
+			printError("Seek error", err);
+			return;
+		}
 	}
 	f_sync(&FDLogFile);
 	setSdCardReady(true);						// everything Ok
@@ -293,6 +378,10 @@ static void mmcUnMount(void) {
 		efiPrintf("Error: No File system is mounted. \"mountsd\" first");
 		return;
 	}
+	if (isLogFilePreallocated) {
+		f_truncate(&FDLogFile);					// drop unused part of preallocated region
+		isLogFilePreallocated = false;
+	}
 	f_close(&FDLogFile);						// close file
 	f_sync(&FDLogFile);							// sync ALL
 
@@ -391,6 +480,53 @@ static BaseBlockDevice* initializeMmcBlockDevice() {
 }
 #endif /* EFI_SDC_DEVICE */
 
+#if SD_LOG_PREALLOCATE_SIZE > 0
+struct FatFsLogReader final : public LogReader {
+	FIL *file;
+
+	size_t read(size_t offset, char* buffer, size_t count) override {
+		UINT result = 0;
+		if (f_lseek(file, offset) != FR_OK || f_read(file, buffer, count, &result) != FR_OK) {
+			return 0;
+		}
+		return result;
+	}
+};
+
+/**
+ * A log which is still exactly the preallocated size was not truncated on unmount, most likely we've lost power.
+ * Find the end of valid data using the block rolling counter and drop the stale rest of the region.
+ */
+static void recoverPreallocatedLogs() {
+	DIR dir;
+	if (f_opendir(&dir, "/") != FR_OK) {
+		return;
+	}
+
+	FILINFO fno;
+	while (f_readdir(&dir, &fno) == FR_OK && fno.fname[0] != 0) {
+		if ((fno.fattrib & AM_DIR) || fno.fsize != SD_LOG_PREALLOCATE_SIZE
+				|| mystrncasecmp(RUSEFI_LOG_PREFIX, fno.fname, sizeof(RUSEFI_LOG_PREFIX) - 1)) {
+			continue;
+		}
+
+		memset(&FDCurrFile, 0, sizeof(FIL));
+		if (f_open(&FDCurrFile, fno.fname, FA_READ | FA_WRITE) != FR_OK) {
+			continue;
+		}
+		FatFsLogReader reader;
+		reader.file = &FDCurrFile;
+		size_t dataEnd = findLogDataEnd(reader, fno.fsize);
+		if (dataEnd < fno.fsize && f_lseek(&FDCurrFile, dataEnd) == FR_OK) {
+			f_truncate(&FDCurrFile);
+			efiPrintf("Recovered %s: %d bytes", fno.fname, dataEnd);
+		}
+		f_close(&FDCurrFile);
+	}
+	f_closedir(&dir);
+}
+#endif /* SD_LOG_PREALLOCATE_SIZE */
+
 // Initialize and mount the SD card.
 // Returns true if the filesystem was successfully mounted for writing.
 static bool mountMmc() {
@@ -425,6 +561,9 @@ static bool mountMmc() {
 	memset(&MMC_FS, 0, sizeof(FATFS));
 	if (f_mount(&MMC_FS, "/", 1) == FR_OK) {
 		sdStatus = SD_STATE_MOUNTED;
+#if SD_LOG_PREALLOCATE_SIZE > 0
+		recoverPreallocatedLogs();
+#endif /* SD_LOG_PREALLOCATE_SIZE */
 		incLogFileName();
 		createLogFile();
 		fileCreatedCounter++;
@@ -436,55 +575,84 @@ static bool mountMmc() {
 	}
 }
 
-struct SdLogBufferWriter final : public BufferedWriter<512> {
-	bool failed = false;
-
-	size_t writeInternal(const char* buffer, size_t count) override {
-		size_t bytesWritten;
+static NO_CACHE BlockRingWriter<SD_LOG_BLOCK_SIZE, SD_LOG_BLOCK_COUNT> logRing;
+static chibios_rt::BinarySemaphore logBlockReadySemaphore(/* taken =*/ true);
+// set by writer thread, sampler stops once it sees this
+static volatile bool logFailed = false;
+
+static void sdLogStatistics() {
+	efiPrintf("SD log: writes=%d syncs=%d dropped records=%d max ready blocks=%d/%d",
+			totalWritesCounter, totalSyncCounter, logRing.getDroppedRecords(),
+			logRing.getMaxReadyBlocks(), SD_LOG_BLOCK_COUNT);
+	efiPrintf("SD log: max f_write %dus max f_sync %dus average f_sync %dus",
+			maxWriteUs, maxSyncUs, totalSyncCounter == 0 ? 0 : totalSyncUs / totalSyncCounter);
+}
 
-		totalLoggedBytes += count;
+static bool writeLogBlock(const char* buffer, size_t count) {
+#if SD_LOG_PREALLOCATE_SIZE > 0
+	if (isLogFilePreallocated) {
+		// marker goes first, so that on power loss stale blocks never directly follow our data
+		FSIZE_t position = f_tell(&FDLogFile);
+		if (!writeLogEndMarker(position + count) || f_lseek(&FDLogFile, position) != FR_OK) {
+			printError("end marker error", FR_DISK_ERR);
+			mmcUnMount();
+			return false;
+		}
+	}
+#endif /* SD_LOG_PREALLOCATE_SIZE */
 
-		FRESULT err = f_write(&FDLogFile, buffer, count, &bytesWritten);
+	size_t bytesWritten;
 
-		if (bytesWritten != count) {
-			printError("write error or disk full", err);
+	efitimeus_t start = getTimeNowUs();
+	FRESULT err = f_write(&FDLogFile, buffer, count, &bytesWritten);
+	uint32_t writeUs = getTimeNowUs() - start;
+	if (writeUs > maxWriteUs) {
+		maxWriteUs = writeUs;
+	}
 
-			// Close file and unmount volume
-			mmcUnMount();
-			failed = true;
-			return 0;
-		} else {
-			writeCounter++;
-			totalWritesCounter++;
-			if (writeCounter >= F_SYNC_FREQUENCY) {
-				/**
-				 * Performance optimization: not f_sync after each line, f_sync is probably a heavy operation
-				 * todo: one day someone should actually measure the relative cost of f_sync
-				 */
-				f_sync(&FDLogFile);
-				totalSyncCounter++;
-				writeCounter = 0;
-			}
-		}
+	if (bytesWritten != count) {
+		printError("write error or disk full", err);
 
-		return bytesWritten;
+		// Close file and unmount volume
+		mmcUnMount();
+		return false;
 	}
-};
 
-static NO_CACHE SdLogBufferWriter logBuffer;
+	totalLoggedBytes += count;
+	writeCounter++;
+	totalWritesCounter++;
+	if (writeCounter >= F_SYNC_FREQUENCY) {
+		/**
+		 * Performance optimization: not f_sync after each block, f_sync updates directory entry and FAT
+		 */
+		start = getTimeNowUs();
+		f_sync(&FDLogFile);
+		uint32_t syncUs = getTimeNowUs() - start;
+		if (syncUs > maxSyncUs) {
+			maxSyncUs = syncUs;
+		}
+		totalSyncUs += syncUs;
+		totalSyncCounter++;
+		writeCounter = 0;
+	}
+	return true;
+}
 
-static THD_FUNCTION(MMCmonThread, arg) {
+/**
+ * Producer: snapshots one log record at a fixed rate, never touches the card
+ */
+static THD_FUNCTION(MMCSamplerThread, arg) {
 	(void)arg;
-	chRegSetThreadName("MMC Card Logger");
+	chRegSetThreadName("MMC Card Sampler");
 
-	if (!mountMmc()) {
-		// no card present (or mounted via USB), don't do internal logging
-		return;
-	}
+	efitick_t lastFlushNt = getTimeNowNt();
 
-	while (true) {
+	while (!logFailed) {
 		// if the SPI device got un-picked somehow, cancel SD card
 		if (CONFIG(sdCardSpiDevice) == SPI_NONE) {
+			// whatever we have sampled still goes into the file
+			logRing.flush();
+			logBlockReadySemaphore.signal();
 			return;
 		}
 
@@ -493,13 +661,21 @@ static THD_FUNCTION(MMCmonThread, arg) {
 			tsOutputChannels.debugIntField2 = totalWritesCounter;
 			tsOutputChannels.debugIntField3 = totalSyncCounter;
 			tsOutputChannels.debugIntField4 = fileCreatedCounter;
+			tsOutputChannels.debugIntField5 = logRing.getDroppedRecords();
+			tsOutputChannels.debugFloatField1 = maxWriteUs / 1000.0f;
+			tsOutputChannels.debugFloatField2 = maxSyncUs / 1000.0f;
 		}
 
-		writeLogLine(logBuffer);
+		writeLogLine(logRing);
 
-		// Something went wrong (already handled), so cancel further writes
-		if (logBuffer.failed) {
-			return;
+		efitick_t nowNt = getTimeNowNt();
+		if (nowNt - lastFlushNt >= MS2NT(SD_LOG_FLUSH_PERIOD_MS)) {
+			logRing.flush();
+			lastFlushNt = nowNt;
+		}
+
+		if (logRing.hasReadyBlock()) {
+			logBlockReadySemaphore.signal();
 		}
 
 		auto period = CONFIG(sdCardPeriodMs);
@@ -509,6 +685,34 @@ static THD_FUNCTION(MMCmonThread, arg) {
 	}
 }
 
+static THD_FUNCTION(MMCmonThread, arg) {
+	(void)arg;
+	chRegSetThreadName("MMC Card Logger");
+
+	if (!mountMmc()) {
+		// no card present (or mounted via USB), don't do internal logging
+		return;
+	}
+
+	chThdCreateStatic(mmcSamplerThreadStack, sizeof(mmcSamplerThreadStack), PRIO_MMC_SAMPLER, (tfunc_t)(void*) MMCSamplerThread, NULL);
+
+	// Consumer: stores whole blocks, however long the card takes
+	while (true) {
+		logBlockReadySemaphore.wait();
+
+		size_t size;
+		const char* block;
+		while ((block = logRing.getReadyBlock(size))) {
+			if (!writeLogBlock(block, size)) {
+				// Something went wrong (already handled), so cancel further writes
+				logFailed = true;
+				return;
+			}
+			logRing.releaseBlock();
+		}
+	}
+}
+
 bool isSdCardAlive(void) {
 	return fs_ready;
 }
@@ -0,0 +1,91 @@
+/**
+ * @file	spsc_queue.h
+ * @brief	Lock-free queue between exactly one producer and exactly one consumer
+ *
+ * Producer never waits: when the queue is full the new element is dropped and counted as overrun.
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+template <typename T, size_t TSize>
+class SpscQueue {
+	static_assert(TSize > 0 && (TSize & (TSize - 1)) == 0, "size has to be a power of two");
+
+public:
+	/**
+	 * Producer side
+	 * @return false if the queue was full and the element was dropped
+	 */
+	bool push(const T& element) {
+		uint32_t head = m_head.load(std::memory_order_relaxed);
+		uint32_t used = head - m_tail.load(std::memory_order_acquire);
+		if (used >= TSize) {
+			m_overrunCount++;
+			return false;
+		}
+
+		m_elements[head & (TSize - 1)] = element;
+		// element content has to be visible to consumer before the new head
+		m_head.store(head + 1, std::memory_order_release);
+
+		if (used + 1 > m_highWaterMark) {
+			m_highWaterMark = used + 1;
+		}
+		return true;
+	}
+
+	/**
+	 * Consumer side
+	 * @return false if there was nothing to take
+	 */
+	bool pop(T& element) {
+		uint32_t tail = m_tail.load(std::memory_order_relaxed);
+		if (m_head.load(std::memory_order_acquire) == tail) {
+			return false;
+		}
+
+		element = m_elements[tail & (TSize - 1)];
+		m_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	size_t getCount() const {
+		return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * Number of elements dropped because consumer did not keep up
+	 */
+	uint32_t getOverrunCount() const {
+		return m_overrunCount;
+	}
+
+	/**
+	 * Highest number of elements which were waiting for the consumer at the same time
+	 */
+	size_t getHighWaterMark() const {
+		return m_highWaterMark;
+	}
+
+	static constexpr size_t getSize() {
+		return TSize;
+	}
+
+private:
+	T m_elements[TSize];
+	// number of elements ever pushed, written by producer only
+	std::atomic<uint32_t> m_head{0};
+	// number of elements ever popped, written by consumer only
+	std::atomic<uint32_t> m_tail{0};
+
+	// producer side statistics
+	uint32_t m_overrunCount = 0;
+	size_t m_highWaterMark = 0;
+};
@@ -10,6 +10,70 @@
 #include "efilib.h"
 #include "interpolation.h"
 
+void TableAxisCache::beginPass(int configVersion) {
+	if (m_passDepth.fetch_add(1) != 0) {
+		// nested pass, the interrupted one keeps the cache
+		return;
+	}
+
+	if (configVersion != m_configVersion) {
+		// bins could have moved or changed kind, start over
+		m_configVersion = configVersion;
+		m_count = 0;
+		return;
+	}
+
+	for (int i = 0; i < m_count; i++) {
+		Entry& entry = m_entries[i];
+		entry.isResolved = false;
+
+		const Entry& shared = m_entries[entry.sharedIndex];
+		if (entry.sharedIndex != i && memcmp(entry.bins, shared.bins, entry.byteSize) != 0) {
+			// bins were changed since last time
+			entry.sharedIndex = findShared(i);
+		}
+	}
+}
+
+void TableAxisCache::endPass() {
+	m_passDepth.fetch_sub(1);
+}
+
+/**
+ * @return index of the first entry which has same bins as entry 'index', or 'index' itself
+ */
+int TableAxisCache::findShared(int index) const {
+	const Entry& entry = m_entries[index];
+	for (int i = 0; i < index; i++) {
+		const Entry& other = m_entries[i];
+		if (other.sharedIndex == i && other.kind == entry.kind && memcmp(entry.bins, other.bins, entry.byteSize) == 0) {
+			return i;
+		}
+	}
+	return index;
+}
+
+int TableAxisCache::findOrAdd(const void* bins, const void* kind, size_t byteSize) {
+	for (int i = 0; i < m_count; i++) {
+		if (m_entries[i].bins == bins && m_entries[i].kind == kind) {
+			return i;
+		}
+	}
+	if (m_count == TABLE_AXIS_CACHE_SIZE) {
+		return -1;
+	}
+
+	int index = m_count++;
+	Entry& entry = m_entries[index];
+	entry.bins = bins;
+	entry.kind = kind;
+	entry.byteSize = byteSize;
+	entry.isResolved = false;
+	entry.hint = 0;
+	entry.sharedIndex = findShared(index);
+	return index;
+}
+
 void setRpmBin(float array[], int size, float idleRpm, float topRpm) {
 	array[0] = idleRpm - 150;
 	int rpmStep = (int)(efiRound((topRpm - idleRpm) / (size - 2), 50) - 150);
@@ -14,12 +14,110 @@
 #include "efi_ratio.h"
 #include "scaled_channel.h"
 
+#include <atomic>
+
 // popular left edge of CLT-based correction curves
 #define CLT_CURVE_RANGE_FROM -40
 
+#ifndef TABLE_AXIS_CACHE_SIZE
+#define TABLE_AXIS_CACHE_SIZE 16
+#endif
+
+/**
+ * Resolves table axes once per pass over the tables: tables which have identical axis bins and are looked
+ * up with the same value share one BinResult, so the table lookup itself is just four loads and three lerps.
+ *
+ * Each table has its own bin arrays in the configuration, so sharing is detected by comparing bin values.
+ * Bins could be changed by online tuning at any moment, that's why shared axes are compared again on each
+ * beginPass(). Within a pass axes stay as they were resolved at first use.
+ *
+ * Lookups are only cached between beginPass() and endPass(), anything else resolves axes directly: lookups
+ * outside of a pass, and a pass which has interrupted another one, like the fast callback invoked by the
+ * trigger callback while the fast callback thread is in the middle of its own pass.
+ * This data structure is NOT thread safe: while a pass is in progress, lookups from any other thread are
+ * not allowed. It belongs to EngineState::periodicFastCallback.
+ */
+class TableAxisCache {
+public:
+	/**
+	 * Forgets resolved values
+	 * @param configVersion all entries are dropped if configuration version has changed since previous pass
+	 */
+	void beginPass(int configVersion);
+	void endPass();
+
+	template<class TBin, int TSize>
+	priv::BinResult get(float value, const TBin* bins) {
+		if (m_passDepth.load(std::memory_order_relaxed) != 1) {
+			// not in a pass, or in a nested one
+			return priv::getBinPtr<TBin, TSize>(value, bins);
+		}
+
+		int index = findOrAdd(bins, getAxisKind<TBin, TSize>(), sizeof(TBin) * TSize);
+		if (index < 0) {
+			// out of entries
+			return priv::getBinPtr<TBin, TSize>(value, bins);
+		}
+
+		Entry& resolved = m_entries[m_entries[index].sharedIndex];
+		if (resolved.isResolved && resolved.value == value) {
+			m_hitCounter++;
+			return resolved.result;
+		}
+
+		resolved.result = priv::getBinPtr<TBin, TSize>(value, bins, resolved.hint);
+		resolved.value = value;
+		resolved.isResolved = true;
+		return resolved.result;
+	}
+
+	int getHitCounter() const {
+		return m_hitCounter;
+	}
+
+private:
+	// unique address for each bin type and size
+	template<class TBin, int TSize>
+	static const void* getAxisKind() {
+		static const char kind = 0;
+		return &kind;
+	}
+
+	int findOrAdd(const void* bins, const void* kind, size_t byteSize);
+	int findShared(int index) const;
+
+	struct Entry {
+		const void* bins;
+		const void* kind;
+		size_t byteSize;
+		/**
+		 * index of the entry with same bin values which holds resolved value for both, could be self
+		 */
+		uint8_t sharedIndex;
+		bool isResolved;
+		float value;
+		size_t hint;
+		priv::BinResult result;
+	};
+
+	Entry m_entries[TABLE_AXIS_CACHE_SIZE];
+	int m_count = 0;
+	int m_hitCounter = 0;
+	int m_configVersion = 0;
+	// passes in progress, more than one only while a nested pass is running
+	std::atomic<int> m_passDepth{0};
+};
+
 class ValueProvider3D {
 public:
 	virtual float getValue(float xColumn, float yRow) const = 0;
+
+	/**
+	 * Same value as getValue, with axes resolved via the cache
+	 */
+	virtual float getValueWithAxisCache(float xColumn, float yRow, TableAxisCache& /*cache*/) const {
+		return getValue(xColumn, yRow);
+	}
 };
 
 
@@ -53,9 +151,25 @@ public:
 			return 0;
 		}
 		
-		auto row = priv::getBinPtr<kType, TRowNum>(yRow, m_rowBins);
-		auto col = priv::getBinPtr<kType, TColNum>(xColumn, m_columnBins);
+		auto row = priv::getBinPtr<kType, TRowNum>(yRow, m_rowBins, m_rowHint);
+		auto col = priv::getBinPtr<kType, TColNum>(xColumn, m_columnBins, m_columnHint);
 
+		return getValue(row, col);
+	}
+
+	float getValueWithAxisCache(float xColumn, float yRow, TableAxisCache& cache) const override {
+		if (!m_values) {
+			// not initialized, return 0
+			return 0;
+		}
+
+		return getValue(cache.get<kType, TRowNum>(yRow, m_rowBins), cache.get<kType, TColNum>(xColumn, m_columnBins));
+	}
+
+	/**
+	 * Table lookup with both axes already resolved
+	 */
+	float getValue(const priv::BinResult& row, const priv::BinResult& col) const {
 		// Orient the table such that (0, 0) is the bottom left corner,
 		// then the following variable names will make sense
 		float lowerLeft = getValueAtPosition(row.Idx, col.Idx);
@@ -100,6 +214,12 @@ private:
 
 	const kType *m_rowBins = nullptr;
 	const kType *m_columnBins = nullptr;
+
+	/**
+	 * Bins found by previous getValue(), only used as a starting point for the next lookup
+	 */
+	mutable size_t m_rowHint = 0;
+	mutable size_t m_columnHint = 0;
 };
 
 typedef Map3D<FUEL_RPM_COUNT, FUEL_LOAD_COUNT, uint8_t, float, efi::ratio<1, PACK_MULT_LAMBDA_CFG>> lambda_Map3D_t;
@@ -63,6 +63,22 @@ float Biquad::filter(float input) {
 	return result;
 }
 
+void Biquad::filterBlock(const float* input, float* output, size_t count) {
+	float localZ1 = z1;
+	float localZ2 = z2;
+
+	for (size_t i = 0; i < count; i++) {
+		float in = input[i];
+		float result = in * a0 + localZ1;
+		localZ1 = in * a1 + localZ2 - b1 * result;
+		localZ2 = in * a2 - b2 * result;
+		output[i] = result;
+	}
+
+	z1 = localZ1;
+	z2 = localZ2;
+}
+
 void Biquad::cookSteadyState(float steadyStateInput) {
     float Y = steadyStateInput * (a0 + a1 + a2) / (1 + b1 + b2);
 
@@ -7,11 +7,18 @@
 
 #pragma once
 
+#include <cstddef>
+
 class Biquad {
 public:
 	Biquad();
 
 	float filter(float input);
+	/**
+	 * Same as calling filter() for each sample, bit for bit, with filter state kept in registers
+	 * output may be the same buffer as input
+	 */
+	void filterBlock(const float* input, float* output, size_t count);
 	void reset();
 	void cookSteadyState(float steadyStateInput);
 
@@ -22,6 +29,10 @@ public:
 	void configureLowpass(float samplingFrequency, float cutoffFrequency, float Q = 0.54f);
 
 private:
+	// takes coefficients from a configured Biquad
+	template <size_t TChannels>
+	friend class BiquadBank;
+
 	float a0, a1, a2, b1, b2;
 	float z1, z2;
 };
@@ -46,14 +46,58 @@ struct BinResult
 };
 
 /**
- * @brief Finds the location of a value in the bin array.
- * 
- * @param value The value to find in the bins.
- * @return A result containing the index to the left of the value,
- * and how far from (idx) to (idx + 1) the value is located.
+ * Axes up to this size are searched linearly, longer ones with binary search
+ */
+#ifndef BIN_LINEAR_SEARCH_MAX_SIZE
+#define BIN_LINEAR_SEARCH_MAX_SIZE 8
+#endif
+
+/**
+ * @return the last index such that bins[idx] <= value
+ * Caller makes sure that bins[0] < value < bins[TSize - 1]
  */
 template<class TBin, int TSize>
-BinResult getBinPtr(float value, const TBin* bins) {
+size_t findBinIndexLinear(float value, const TBin* bins) {
+	size_t idx;
+	for (idx = 0; idx < TSize - 1; idx++) {
+		if (bins[idx + 1] > value) {
+			break;
+		}
+	}
+	return idx;
+}
+
+/**
+ * Same contract as findBinIndexLinear. Branchless: number of iterations only depends on TSize
+ * so the compiler unrolls the loop into a chain of conditional moves.
+ */
+template<class TBin, int TSize>
+size_t findBinIndexBinary(float value, const TBin* bins) {
+	const TBin* base = bins;
+	size_t n = TSize - 1;
+	while (n > 1) {
+		size_t half = n / 2;
+		base = (base[half] <= value) ? base + half : base;
+		n -= half;
+	}
+	return base - bins;
+}
+
+template<class TBin, int TSize>
+size_t findBinIndex(float value, const TBin* bins) {
+	if constexpr (TSize <= BIN_LINEAR_SEARCH_MAX_SIZE) {
+		return findBinIndexLinear<TBin, TSize>(value, bins);
+	} else {
+		return findBinIndexBinary<TBin, TSize>(value, bins);
+	}
+}
+
+/**
+ * @brief Handles NaN and off-scale values
+ * @return true if result is final and no search is needed
+ */
+template<class TBin, int TSize>
+bool getBinOffScale(float value, const TBin* bins, BinResult& result) {
 	// Enforce numeric only (int, float, uintx_t, etc)
 	static_assert(std::is_arithmetic_v<TBin>, "Table bins must be an arithmetic type");
 
@@ -62,40 +106,84 @@ BinResult getBinPtr(float value, const TBin* bins) {
 
 	// Handle NaN
 	if (cisnan(value)) {
-		return { 0, 0.0f };
+		result = { 0, 0.0f };
+		return true;
 	}
 
 	// Handle off-scale low
 	if (value <= bins[0]) {
-		return { 0, 0.0f };
+		result = { 0, 0.0f };
+		return true;
 	}
 
 	// Handle off-scale high
 	if (value >= bins[TSize - 1]) {
-		return { TSize - 2, 1.0f };
+		result = { TSize - 2, 1.0f };
+		return true;
 	}
 
-	size_t idx = 0;
-
-	// Find the last index less than the searched value
-	// Linear search for now, maybe binary search in future
-	// after collecting real perf data
-	for (idx = 0; idx < TSize - 1; idx++) {
-		if (bins[idx + 1] > value) {
-			break;
-		}
-	}
+	return false;
+}
 
+template<class TBin>
+BinResult getBinFraction(float value, const TBin* bins, size_t idx) {
 	float low = bins[idx];
 	float high = bins[idx + 1];
 
 	// Compute how far along the bin we are
 	// (0.0f = left side, 1.0f = right side)
 	float fraction = (value - low) / (high - low);
-	
+
 	return { idx, fraction };
 }
 
+/**
+ * @brief Finds the location of a value in the bin array.
+ * 
+ * @param value The value to find in the bins.
+ * @return A result containing the index to the left of the value,
+ * and how far from (idx) to (idx + 1) the value is located.
+ */
+template<class TBin, int TSize>
+BinResult getBinPtr(float value, const TBin* bins) {
+	BinResult result;
+	if (getBinOffScale<TBin, TSize>(value, bins, result)) {
+		return result;
+	}
+
+	return getBinFraction(value, bins, findBinIndex<TBin, TSize>(value, bins));
+}
+
+/**
+ * Same as above, with 'hint' being the index found by previous invocation. RPM and load do not move much
+ * between consecutive invocations so we check that bin and its neighbours before searching.
+ */
+template<class TBin, int TSize>
+BinResult getBinPtr(float value, const TBin* bins, size_t& hint) {
+	BinResult result;
+	if (getBinOffScale<TBin, TSize>(value, bins, result)) {
+		return result;
+	}
+
+	size_t idx = hint;
+	if (idx < TSize - 1 && bins[idx] <= value) {
+		if (value < bins[idx + 1]) {
+			// same bin as last time
+		} else if (idx + 2 < TSize && value < bins[idx + 2]) {
+			idx++;
+		} else {
+			idx = findBinIndex<TBin, TSize>(value, bins);
+		}
+	} else if (idx > 0 && idx < TSize && bins[idx - 1] <= value && value < bins[idx]) {
+		idx--;
+	} else {
+		idx = findBinIndex<TBin, TSize>(value, bins);
+	}
+	hint = idx;
+
+	return getBinFraction(value, bins, idx);
+}
+
 template<class TBin, int TSize>
 BinResult getBin(float value, const TBin (&bins)[TSize]) {
 	return getBinPtr<TBin, TSize>(value, &bins[0]);
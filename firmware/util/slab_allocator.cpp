@@ -0,0 +1,167 @@
+/**
+ * @file	slab_allocator.cpp
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#include "slab_allocator.h"
+
+#include <cstring>
+
+static const uint8_t sizeClasses[SLAB_SIZE_CLASS_COUNT] = { 8, 16, 24, 32, 48, 64 };
+
+static_assert(SLAB_MAX_BLOCK_SIZE == 64, "last size class");
+
+int getSlabSizeClass(size_t size) {
+	for (int i = 0; i < SLAB_SIZE_CLASS_COUNT; i++) {
+		if (size <= sizeClasses[i]) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+SlabAllocator::SlabAllocator(FallbackAlloc fallbackAlloc, FallbackFree fallbackFree)
+	: m_fallbackAlloc(fallbackAlloc)
+	, m_fallbackFree(fallbackFree)
+{
+	reset();
+}
+
+void SlabAllocator::reset() {
+	memset(m_freeLists, 0, sizeof(m_freeLists));
+	memset(&m_stats, 0, sizeof(m_stats));
+}
+
+int SlabAllocator::getSlabFragmentationPercent() const {
+	if (m_stats.slabBytes == 0) {
+		return 0;
+	}
+	return 100 * m_stats.slabFreeBytes / m_stats.slabBytes;
+}
+
+bool SlabAllocator::addPage(int sizeClass) {
+	uint8_t* page = reinterpret_cast<uint8_t*>(m_fallbackAlloc(SLAB_PAGE_SIZE));
+	if (!page) {
+		return false;
+	}
+
+	size_t blockSize = sizeClasses[sizeClass];
+	for (size_t offset = 0; offset + blockSize <= SLAB_PAGE_SIZE; offset += blockSize) {
+		FreeBlock* block = reinterpret_cast<FreeBlock*>(page + offset);
+		block->next = m_freeLists[sizeClass];
+		m_freeLists[sizeClass] = block;
+	}
+
+	m_stats.slabBytes += SLAB_PAGE_SIZE;
+	m_stats.slabFreeBytes += SLAB_PAGE_SIZE;
+	return true;
+}
+
+void* SlabAllocator::allocate(size_t size) {
+	int sizeClass = getSlabSizeClass(size);
+	if (sizeClass < 0) {
+		void* ptr = m_fallbackAlloc(size);
+		if (ptr) {
+			m_stats.largeBytes += size;
+		}
+		return ptr;
+	}
+
+	if (!m_freeLists[sizeClass] && !addPage(sizeClass)) {
+		return nullptr;
+	}
+
+	FreeBlock* block = m_freeLists[sizeClass];
+	m_freeLists[sizeClass] = block->next;
+	m_stats.slabFreeBytes -= sizeClasses[sizeClass];
+	return block;
+}
+
+void SlabAllocator::release(void* ptr, size_t size) {
+	int sizeClass = getSlabSizeClass(size);
+	if (sizeClass < 0) {
+		m_fallbackFree(ptr);
+		m_stats.largeBytes -= size;
+		return;
+	}
+
+	FreeBlock* block = reinterpret_cast<FreeBlock*>(ptr);
+	block->next = m_freeLists[sizeClass];
+	m_freeLists[sizeClass] = block;
+	m_stats.slabFreeBytes += sizeClasses[sizeClass];
+}
+
+void SlabAllocator::keepShrunk(size_t oldSize, size_t newSize) {
+	int oldClass = getSlabSizeClass(oldSize);
+	int newClass = getSlabSizeClass(newSize);
+
+	if (oldClass < 0) {
+		// large block joins slab blocks for good, rest of it is lost
+		m_stats.largeBytes -= oldSize;
+		m_stats.slabBytes += sizeClasses[newClass];
+	} else {
+		m_stats.slabBytes -= sizeClasses[oldClass] - sizeClasses[newClass];
+	}
+	m_stats.inPlaceCount++;
+}
+
+void* SlabAllocator::reallocate(void* ptr, size_t oldSize, size_t newSize) {
+	if (!ptr) {
+		// Lua passes object type here
+		oldSize = 0;
+	}
+
+	if (newSize == 0) {
+		if (ptr) {
+			release(ptr, oldSize);
+			m_stats.usedBytes -= oldSize;
+		}
+		return nullptr;
+	}
+
+	void* newPtr = nullptr;
+	if (ptr) {
+		int oldClass = getSlabSizeClass(oldSize);
+		bool sameClass = oldClass == getSlabSizeClass(newSize);
+
+		if (sameClass && oldClass >= 0) {
+			// same slot still fits
+			m_stats.inPlaceCount++;
+			newPtr = ptr;
+		} else if (sameClass && newSize <= oldSize) {
+			// large block shrinks in place, it is freed without looking at its size
+			m_stats.largeBytes -= oldSize - newSize;
+			m_stats.inPlaceCount++;
+			newPtr = ptr;
+		}
+	}
+
+	if (!newPtr) {
+		newPtr = allocate(newSize);
+
+		if (!newPtr) {
+			if (ptr && newSize < oldSize) {
+				// a shrink must not fail, see keepShrunk()
+				keepShrunk(oldSize, newSize);
+				m_stats.usedBytes -= oldSize - newSize;
+				return ptr;
+			}
+			m_stats.failedCount++;
+			return nullptr;
+		}
+
+		if (ptr) {
+			memcpy(newPtr, ptr, oldSize < newSize ? oldSize : newSize);
+			release(ptr, oldSize);
+		}
+	}
+
+	m_stats.usedBytes += newSize;
+	m_stats.usedBytes -= oldSize;
+	if (m_stats.usedBytes > m_stats.peakUsedBytes) {
+		m_stats.peakUsedBytes = m_stats.usedBytes;
+	}
+	return newPtr;
+}
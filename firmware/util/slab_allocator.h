@@ -0,0 +1,91 @@
+/**
+ * @file	slab_allocator.h
+ * @brief	Size-class allocator for many small short-lived blocks, larger blocks go to a fallback heap
+ *
+ * Small blocks are carved from SLAB_PAGE_SIZE pages taken from the fallback heap, each page serves one
+ * size class and each class keeps a free list, so allocation and free are O(1) and small blocks do not
+ * fragment the fallback heap. Pages are never given back.
+ *
+ * Caller passes size of the block on free and realloc, same contract as lua_Alloc, so blocks need no header.
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#define SLAB_MAX_BLOCK_SIZE 64
+#define SLAB_SIZE_CLASS_COUNT 6
+// multiple of each size class
+#define SLAB_PAGE_SIZE 384
+
+struct SlabAllocatorStats {
+	// as requested by the client
+	size_t usedBytes;
+	size_t peakUsedBytes;
+	// taken from fallback heap for slab pages
+	size_t slabBytes;
+	// free blocks within slab pages
+	size_t slabFreeBytes;
+	// blocks above SLAB_MAX_BLOCK_SIZE, as requested by the client
+	size_t largeBytes;
+	// reallocations done without moving the block
+	uint32_t inPlaceCount;
+	uint32_t failedCount;
+};
+
+class SlabAllocator {
+public:
+	using FallbackAlloc = void* (*)(size_t size);
+	using FallbackFree = void (*)(void* ptr);
+
+	SlabAllocator(FallbackAlloc fallbackAlloc, FallbackFree fallbackFree);
+
+	/**
+	 * lua_Alloc semantics: frees if newSize is zero, allocates if ptr is null, old block is intact on failure
+	 * @param oldSize size ptr was allocated with, ignored if ptr is null
+	 */
+	void* reallocate(void* ptr, size_t oldSize, size_t newSize);
+
+	const SlabAllocatorStats& getStats() const {
+		return m_stats;
+	}
+
+	/**
+	 * @return percentage of slab page bytes sitting in free lists
+	 */
+	int getSlabFragmentationPercent() const;
+
+	/**
+	 * Forgets all blocks, only to be used once fallback heap was reset too
+	 */
+	void reset();
+
+private:
+	struct FreeBlock {
+		FreeBlock* next;
+	};
+
+	void* allocate(size_t size);
+	void release(void* ptr, size_t size);
+	bool addPage(int sizeClass);
+	/**
+	 * Block which could not be moved on shrink stays where it is and is known by its new size from now on,
+	 * that is a smaller slab class
+	 */
+	void keepShrunk(size_t oldSize, size_t newSize);
+
+	FallbackAlloc m_fallbackAlloc;
+	FallbackFree m_fallbackFree;
+
+	FreeBlock* m_freeLists[SLAB_SIZE_CLASS_COUNT];
+	SlabAllocatorStats m_stats;
+};
+
+/**
+ * @return index of the smallest size class which fits, -1 for blocks above SLAB_MAX_BLOCK_SIZE
+ */
+int getSlabSizeClass(size_t size);
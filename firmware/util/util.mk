@@ -19,6 +19,7 @@ UTILSRC_CPP = \
 	$(PROJECT_DIR)/util/cli_registry.cpp \
 	$(PROJECT_DIR)/util/efilib.cpp \
 	$(PROJECT_DIR)/util/timer.cpp \
+	$(PROJECT_DIR)/util/slab_allocator.cpp \
 	
 	
 UTIL_INC = \
@@ -63,6 +63,11 @@ public class BinaryProtocol {
      * todo: finish this feature, assuming we even need it.
      */
     public static boolean PLAIN_PROTOCOL = Boolean.getBoolean(USE_PLAIN_PROTOCOL_PROPERTY);
+    /**
+     * Only changed output channel bytes are transferred, helps gauge refresh rate over slow links
+     * @see OutputChannelsDelta
+     */
+    public static boolean OUTPUT_DELTA = Boolean.getBoolean("protocol.output_delta");
 
     private final LinkManager linkManager;
     private final IoStream stream;
@@ -70,6 +75,7 @@ public class BinaryProtocol {
     private boolean isBurnPending;
 
     private BinaryProtocolState state = new BinaryProtocolState();
+    private final OutputChannelsDelta outputChannelsDelta = new OutputChannelsDelta();
 
     // todo: this ioLock needs better documentation!
     private final Object ioLock = new Object();
@@ -112,6 +118,8 @@ public class BinaryProtocol {
                 return "WRITE_CHUNK";
             case Fields.TS_OUTPUT_COMMAND:
                 return "TS_OUTPUT_COMMAND";
+            case Fields.TS_OUTPUT_DELTA_COMMAND:
+                return "TS_OUTPUT_DELTA_COMMAND";
             case Fields.TS_RESPONSE_OK:
                 return "TS_RESPONSE_OK";
             default:
@@ -608,9 +616,14 @@ public class BinaryProtocol {
         if (isClosed)
             return false;
 
-        byte[] packet = GetOutputsCommand.createRequest();
-
-        byte[] response = executeCommand(packet, "output channels", false);
+        byte[] response;
+        if (OUTPUT_DELTA) {
+            byte[] packet = outputChannelsDelta.createRequest();
+            response = outputChannelsDelta.apply(executeCommand(packet, "output channels delta", false));
+        } else {
+            byte[] packet = GetOutputsCommand.createRequest();
+            response = executeCommand(packet, "output channels", false);
+        }
         if (response == null || response.length != (Fields.TS_OUTPUT_SIZE + 1) || response[0] != Fields.TS_RESPONSE_OK)
             return false;
 
@@ -0,0 +1,91 @@
+package com.rusefi.binaryprotocol;
+
+import com.rusefi.config.generated.Fields;
+
+import static com.rusefi.binaryprotocol.IoHelper.putShort;
+import static com.rusefi.binaryprotocol.IoHelper.swap16;
+
+/**
+ * Client side of delta compressed output channels, see ts_output_delta.h in firmware for wire format
+ *
+ * @see Fields#TS_OUTPUT_DELTA_COMMAND
+ */
+public class OutputChannelsDelta {
+    public static final int KEYFRAME = 1;
+    private static final int HEADER_SIZE = 2;
+
+    /**
+     * Same layout as TS_OUTPUT_COMMAND response: response code followed by output channels
+     */
+    private final byte[] image = new byte[1 + Fields.TS_OUTPUT_SIZE];
+    private boolean hasImage;
+    private int lastSequence;
+
+    private int keyframeCount;
+    private int deltaCount;
+
+    public byte[] createRequest() {
+        byte[] packet = new byte[6];
+        packet[0] = Fields.TS_OUTPUT_DELTA_COMMAND;
+        putShort(packet, 1, 0); // offset
+        putShort(packet, 3, swap16(Fields.TS_OUTPUT_SIZE));
+        // anything but the sequence of the last frame makes controller send a keyframe
+        packet[5] = (byte) (hasImage ? lastSequence : lastSequence + 1);
+        return packet;
+    }
+
+    /**
+     * @param response including response code
+     * @return current outputs in TS_OUTPUT_COMMAND response layout, null if response could not be applied
+     */
+    public byte[] apply(byte[] response) {
+        if (response == null || response.length < 1 + HEADER_SIZE || response[0] != Fields.TS_RESPONSE_OK)
+            return null;
+        int flags = response[1];
+        lastSequence = response[2] & 0xFF;
+        int position = 1 + HEADER_SIZE;
+
+        if ((flags & KEYFRAME) != 0) {
+            if (response.length != position + Fields.TS_OUTPUT_SIZE) {
+                hasImage = false;
+                return null;
+            }
+            image[0] = Fields.TS_RESPONSE_OK;
+            System.arraycopy(response, position, image, 1, Fields.TS_OUTPUT_SIZE);
+            hasImage = true;
+            keyframeCount++;
+            return image.clone();
+        }
+
+        if (!hasImage)
+            return null;
+
+        int index = 0;
+        while (position < response.length) {
+            if (position + 2 > response.length) {
+                hasImage = false;
+                return null;
+            }
+            int skip = response[position++] & 0xFF;
+            int length = response[position++] & 0xFF;
+            index += skip;
+            if (index + length > Fields.TS_OUTPUT_SIZE || position + length > response.length) {
+                hasImage = false;
+                return null;
+            }
+            System.arraycopy(response, position, image, 1 + index, length);
+            position += length;
+            index += length;
+        }
+        deltaCount++;
+        return image.clone();
+    }
+
+    public int getKeyframeCount() {
+        return keyframeCount;
+    }
+
+    public int getDeltaCount() {
+        return deltaCount;
+    }
+}
@@ -0,0 +1,69 @@
+package com.rusefi.binaryprotocol.test;
+
+import com.rusefi.binaryprotocol.OutputChannelsDelta;
+import com.rusefi.config.generated.Fields;
+import org.junit.Test;
+
+import static org.junit.Assert.*;
+
+public class OutputChannelsDeltaTest {
+    private static byte[] keyframe(int sequence, byte[] outputs) {
+        byte[] response = new byte[3 + outputs.length];
+        response[0] = Fields.TS_RESPONSE_OK;
+        response[1] = OutputChannelsDelta.KEYFRAME;
+        response[2] = (byte) sequence;
+        System.arraycopy(outputs, 0, response, 3, outputs.length);
+        return response;
+    }
+
+    private static byte[] delta(int sequence, int... runs) {
+        byte[] response = new byte[3 + runs.length];
+        response[0] = Fields.TS_RESPONSE_OK;
+        response[2] = (byte) sequence;
+        for (int i = 0; i < runs.length; i++)
+            response[3 + i] = (byte) runs[i];
+        return response;
+    }
+
+    @Test
+    public void keyframeThenDelta() {
+        OutputChannelsDelta dut = new OutputChannelsDelta();
+
+        // nothing to apply a delta to
+        assertNull(dut.apply(delta(1, 0, 1, 7)));
+
+        byte[] outputs = new byte[Fields.TS_OUTPUT_SIZE];
+        outputs[0] = 10;
+        outputs[300] = 20;
+        byte[] image = dut.apply(keyframe(5, outputs));
+        assertNotNull(image);
+        assertEquals(Fields.TS_OUTPUT_SIZE + 1, image.length);
+        assertEquals(Fields.TS_RESPONSE_OK, image[0]);
+        assertEquals(10, image[1]);
+        assertEquals(20, image[301]);
+        // acknowledges the keyframe
+        assertEquals(5, dut.createRequest()[5]);
+
+        // skip 255, nothing, skip 45, two bytes
+        image = dut.apply(delta(6, 255, 0, 45, 2, 21, 22));
+        assertNotNull(image);
+        assertEquals(10, image[1]);
+        assertEquals(21, image[301]);
+        assertEquals(22, image[302]);
+        assertEquals(6, dut.createRequest()[5]);
+        assertEquals(1, dut.getKeyframeCount());
+        assertEquals(1, dut.getDeltaCount());
+    }
+
+    @Test
+    public void brokenDeltaRequestsKeyframe() {
+        OutputChannelsDelta dut = new OutputChannelsDelta();
+        dut.apply(keyframe(5, new byte[Fields.TS_OUTPUT_SIZE]));
+
+        // beyond the end of outputs
+        assertNull(dut.apply(delta(6, 255, 0, 255, 1, 1)));
+        // anything but the last sequence
+        assertTrue(dut.createRequest()[5] != 6);
+        assertNull(dut.apply(delta(7, 0, 1, 1)));
+    }
+}
@@ -1046,6 +1046,7 @@ public class Fields {
 	public static final int LDS_ETB_PID_STATE_INDEX = 7;
 	public static final int LDS_FUEL_TRIM_STATE_INDEX = 4;
 	public static final int LDS_IDLE_PID_STATE_INDEX = 8;
+	public static final int LDS_PERF_STATS_INDEX = 12;
 	public static final int LDS_SPEED_DENSITY_STATE_INDEX = 2;
 	public static final int LDS_TPS_TPS_ENEICHMENT_STATE_INDEX = 5;
 	public static final int LDS_TRIGGER_CENTRAL_STATE_INDEX = 6;
@@ -1554,8 +1555,10 @@ public class Fields {
 	public static final char TS_IO_TEST_COMMAND = 'Z';
 	public static final char TS_ONLINE_PROTOCOL = 'z';
 	public static final char TS_OUTPUT_COMMAND = 'O';
+	public static final char TS_OUTPUT_DELTA_COMMAND = 'd';
 	public static final int TS_OUTPUT_SIZE = 340;
 	public static final char TS_PAGE_COMMAND = 'P';
+	public static final char TS_PERF_TRACE_ARM = 'a';
 	public static final char TS_PERF_TRACE_BEGIN = '_';
 	public static final char TS_PERF_TRACE_GET_BUFFER = 'b';
 	public static final String TS_PROTOCOL = "001";
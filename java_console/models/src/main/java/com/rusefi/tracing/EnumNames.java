@@ -52,5 +52,8 @@ public class EnumNames {
 	"GlobalUnlock",
 	"SoftwareKnockProcess",
 	"LogTriggerTooth",
+	"LuaTickFunction",
+	"ScheduleAngleBasedEvents",
+	"PerfTraceTrigger",
 	};
 }
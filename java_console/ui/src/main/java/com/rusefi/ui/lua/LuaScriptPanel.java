@@ -14,12 +14,20 @@ import javax.swing.border.Border;
 import java.awt.*;
 import java.awt.event.ActionEvent;
 import java.awt.event.ActionListener;
+import java.io.File;
+import java.io.IOException;
 import java.nio.ByteBuffer;
 import java.nio.charset.Charset;
 import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
 import java.util.Arrays;
 
 public class LuaScriptPanel {
+    /**
+     * Start of precompiled Lua bytecode container, see lua_bytecode.h and misc/lua_precompile
+     */
+    private static final byte[] LUA_BYTECODE_MAGIC = {0x1b, 'E', 'F', 'I'};
+
     private final UIContext context;
     private final JPanel mainPanel = new JPanel(new BorderLayout());
     private final AnyCommand command;
@@ -34,14 +42,17 @@ public class LuaScriptPanel {
 
         JButton readButton = new JButton("Read from ECU");
         JButton writeButton = new JButton("Write to ECU");
+        JButton writeBytecodeButton = new JButton("Write bytecode file to ECU");
         JButton resetButton = new JButton("Reset/Reload Lua");
 
         readButton.addActionListener(e -> read());
         writeButton.addActionListener(e -> write());
+        writeBytecodeButton.addActionListener(e -> writeBytecode());
         resetButton.addActionListener(e -> resetLua());
 
         upperPanel.add(readButton);
         upperPanel.add(writeButton);
+        upperPanel.add(writeBytecodeButton);
         upperPanel.add(resetButton);
         upperPanel.add(this.command.getContent());
 
@@ -91,6 +102,11 @@ public class LuaScriptPanel {
         byte scriptArr[] = new byte[Fields.LUA_SCRIPT_SIZE];
         luaScriptBuffer.get(scriptArr);
 
+        if (isBytecode(scriptArr)) {
+            scriptText.setText("-- precompiled bytecode, source is not available");
+            return;
+        }
+
         int i;
         // Find the null terminator
         for (i = 0; i < scriptArr.length && scriptArr[i] != 0; i++) ;
@@ -98,12 +114,39 @@ public class LuaScriptPanel {
     }
 
     void write() {
-        BinaryProtocol bp = this.context.getLinkManager().getCurrentStreamState();
-
         String script = scriptText.getText();
 
+        writeScript(script.getBytes(StandardCharsets.US_ASCII));
+    }
+
+    void writeBytecode() {
+        JFileChooser fileChooser = new JFileChooser();
+        if (fileChooser.showOpenDialog(mainPanel) != JFileChooser.APPROVE_OPTION)
+            return;
+        File file = fileChooser.getSelectedFile();
+        byte[] bytecode;
+        try {
+            bytecode = Files.readAllBytes(file.toPath());
+        } catch (IOException e) {
+            JOptionPane.showMessageDialog(mainPanel, "Error reading " + file + ": " + e);
+            return;
+        }
+        if (!isBytecode(bytecode) || bytecode.length > Fields.LUA_SCRIPT_SIZE) {
+            JOptionPane.showMessageDialog(mainPanel, file + " is not lua_precompile output of up to " + Fields.LUA_SCRIPT_SIZE + " bytes");
+            return;
+        }
+        writeScript(bytecode);
+    }
+
+    private static boolean isBytecode(byte[] data) {
+        return data.length >= LUA_BYTECODE_MAGIC.length
+                && Arrays.equals(Arrays.copyOf(data, LUA_BYTECODE_MAGIC.length), LUA_BYTECODE_MAGIC);
+    }
+
+    private void writeScript(byte[] scriptBytes) {
+        BinaryProtocol bp = this.context.getLinkManager().getCurrentStreamState();
+
         byte paddedScript[] = new byte[Fields.LUA_SCRIPT_SIZE];
-        byte scriptBytes[] = script.getBytes(StandardCharsets.US_ASCII);
         System.arraycopy(scriptBytes, 0, paddedScript, 0, scriptBytes.length);
 
         int idx = 0;
@@ -0,0 +1,62 @@
+/**
+ * @file lua_precompile.cpp
+ *
+ * Host tool which compiles a Lua script into stripped bytecode for 'luaScript' configuration field,
+ * firmware skips compilation on each Lua reset. Bytecode is wrapped into the container described in
+ * lua_bytecode.h, firmware refuses bytecode with a wrong checksum or Lua version.
+ * Same luaconf.h as in firmware is used so that bytecode header matches.
+ *
+ * usage: lua_precompile script.lua script.luac
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#include "lua.hpp"
+#include "lua_bytecode.h"
+#include "rusefi_generated.h"
+
+#include <cstdio>
+#include <vector>
+
+static int writer(lua_State* /*l*/, const void* p, size_t size, void* ud) {
+	auto output = reinterpret_cast<std::vector<char>*>(ud);
+	auto bytes = reinterpret_cast<const char*>(p);
+	output->insert(output->end(), bytes, bytes + size);
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	if (argc != 3) {
+		fprintf(stderr, "usage: %s script.lua script.luac\n", argv[0]);
+		return 1;
+	}
+
+	lua_State* l = luaL_newstate();
+	if (0 != luaL_loadfile(l, argv[1])) {
+		fprintf(stderr, "%s\n", lua_tostring(l, -1));
+		return 2;
+	}
+
+	// room for the header, it is filled once bytecode is known
+	std::vector<char> bytecode(LUA_BYTECODE_HEADER_SIZE);
+	// debug information is stripped, we do not have room for it
+	lua_dump(l, writer, &bytecode, 1);
+	lua_close(l);
+
+	if (bytecode.size() > LUA_SCRIPT_SIZE) {
+		fprintf(stderr, "bytecode is %d bytes while luaScript is only %d\n", (int)bytecode.size(), LUA_SCRIPT_SIZE);
+		return 3;
+	}
+	setLuaBytecodeHeader(bytecode.data(), bytecode.size() - LUA_BYTECODE_HEADER_SIZE);
+
+	FILE* output = fopen(argv[2], "wb");
+	if (!output || fwrite(bytecode.data(), 1, bytecode.size(), output) != bytecode.size()) {
+		fprintf(stderr, "error writing %s\n", argv[2]);
+		return 4;
+	}
+	fclose(output);
+
+	printf("%s: %d bytes of bytecode\n", argv[2], (int)bytecode.size());
+	return 0;
+}
@@ -18,6 +18,7 @@
 #define EFI_ENABLE_MOCK_ADC TRUE
 
 #define ENABLE_PERF_TRACE FALSE
+#define EFI_PERF_STATS FALSE
 
 #define EFI_PRINTF_FUEL_DETAILS FALSE
 #define EFI_ENABLE_CRITICAL_ENGINE_STOP TRUE
@@ -21,6 +21,8 @@
 
 #define ENABLE_PERF_TRACE FALSE
 
+#define EFI_PERF_STATS TRUE
+
 #define EFI_TOOTH_LOGGER TRUE
 
 #define EFI_LAUNCH_CONTROL TRUE
@@ -60,6 +62,7 @@
 
 #define EFI_SIGNAL_EXECUTOR_ONE_TIMER FALSE
 #define EFI_SIGNAL_EXECUTOR_SLEEP FALSE
+#define EFI_EVENT_QUEUE_TIMER_WHEEL FALSE
 
 #define EFI_SHAFT_POSITION_INPUT TRUE
 #define EFI_ENGINE_CONTROL TRUE
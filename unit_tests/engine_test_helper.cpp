@@ -291,27 +291,11 @@ scheduling_s * EngineTestHelper::assertEvent5(const char *msg, int index, void *
 	return event;
 }
 
-// todo: reduce code duplication with another 'getElementAtIndexForUnitText'
-static AngleBasedEvent * getElementAtIndexForUnitText(int index, Engine *engine) {
-	AngleBasedEvent * current;
-
-	LL_FOREACH2(engine->angleBasedEventsHead, current, nextToothEvent)
-	{
-		if (index == 0)
-			return current;
-		index--;
-	}
-#if EFI_UNIT_TEST
-	firmwareError(OBD_PCM_Processor_Fault, "getElementAtIndexForUnitText: null");
-#endif /* EFI_UNIT_TEST */
-	return nullptr;
-}
-
 AngleBasedEvent * EngineTestHelper::assertTriggerEvent(const char *msg,
 		int index, AngleBasedEvent *expected,
 		void *callback,
 		int triggerEventIndex, angle_t angleOffsetFromTriggerEvent) {
-	AngleBasedEvent * event = getElementAtIndexForUnitText(index, &engine);
+	AngleBasedEvent * event = engine.angleBasedEvents.getElementAtIndexForUnitText(index);
 
 	assertEqualsM4(msg, " callback up/down", (void*)event->action.getCallback() == (void*) callback, 1);
 
@@ -28,7 +28,9 @@ void TestExecutor::scheduleForLater(scheduling_s *scheduling, int delayUs, actio
 }
 
 int TestExecutor::executeAll(efitime_t now) {
-	return schedulingQueue.executeAll(now);
+	int executed = schedulingQueue.executeAll(now);
+	executedCounter += executed;
+	return executed;
 }
 
 void TestExecutor::clear() {
@@ -57,6 +59,7 @@ void TestExecutor::scheduleByTimestamp(scheduling_s *scheduling, efitimeus_t tim
 		return;
 	}
 
+	scheduledCounter++;
 	schedulingQueue.insertTask(scheduling, timeUs, action);
 }
 
@@ -69,6 +72,25 @@ void TestExecutor::scheduleByTimestampNt(scheduling_s* scheduling, efitick_t tim
 	scheduleByTimestamp(scheduling, NT2US(timeNt), action);
 }
 
+void TestExecutor::cancel(scheduling_s* scheduling) {
+	if (m_mockExecutor) {
+		m_mockExecutor->cancel(scheduling);
+		return;
+	}
+
+	schedulingQueue.cancel(scheduling);
+}
+
+void TestExecutor::rescheduleByTimestampNt(scheduling_s* scheduling, efitick_t timeNt, action_s action) {
+	if (m_mockExecutor) {
+		m_mockExecutor->rescheduleByTimestampNt(scheduling, timeNt, action);
+		return;
+	}
+
+	schedulingQueue.cancel(scheduling);
+	scheduleByTimestampNt(scheduling, timeNt, action);
+}
+
 void TestExecutor::setMockExecutor(ExecutorInterface* exec) {
 	m_mockExecutor = exec;
 }
@@ -9,6 +9,7 @@
 
 #include "scheduler.h"
 #include "event_queue.h"
+#include "timer_wheel.h"
 
 class TestExecutor : public ExecutorInterface {
 public:
@@ -17,6 +18,8 @@ public:
 	void scheduleByTimestamp(scheduling_s *scheduling, efitimeus_t timeUs, action_s action) override;
 	void scheduleByTimestampNt(scheduling_s *scheduling, efitick_t timeNt, action_s action) override;
 	void scheduleForLater(scheduling_s *scheduling, int delayUs, action_s action) override;
+	void cancel(scheduling_s *scheduling) override;
+	void rescheduleByTimestampNt(scheduling_s *scheduling, efitick_t timeNt, action_s action) override;
 	void clear();
 	int executeAll(efitime_t now);
 	int size();
@@ -24,7 +27,20 @@ public:
 	scheduling_s * getForUnitTest(int index);
 
 	void setMockExecutor(ExecutorInterface* exec);
+
+	int getScheduledCounter() const {
+		return scheduledCounter;
+	}
+	int getExecutedCounter() const {
+		return executedCounter;
+	}
 private:
+#if EFI_EVENT_QUEUE_TIMER_WHEEL
+	TimerWheel schedulingQueue;
+#else
 	EventQueue schedulingQueue;
+#endif /* EFI_EVENT_QUEUE_TIMER_WHEEL */
 	ExecutorInterface* m_mockExecutor = nullptr;
+	int scheduledCounter = 0;
+	int executedCounter = 0;
 };
@@ -8,9 +8,13 @@
 #include "map_resize.h"
 #include "engine_math.h"
 #include "engine_test_helper.h"
+#include "tunerstudio_outputs.h"
 
 bool verboseMode = false;
 
+// firmware has it in tunerstudio.cpp, binary log fields point here
+TunerStudioOutputChannels tsOutputChannels;
+
 int timeNowUs = 0;
 
 efitimeus_t getTimeNowUs(void) {
@@ -8,6 +8,68 @@
 #include "engine_test_helper.h"
 #include "logicdata_csv_reader.h"
 
+#include <chrono>
+#include <new>
+
+// only set while a ScopedAllocationCounter of this thread is alive
+static thread_local long *activeAllocationCounter = nullptr;
+
+/**
+ * Replacement of global operator new is necessarily global, so apart from counting in scope
+ * it behaves exactly as the default one
+ */
+void* operator new(size_t size) {
+	if (activeAllocationCounter != nullptr) {
+		(*activeAllocationCounter)++;
+	}
+	void *result = malloc(size == 0 ? 1 : size);
+	if (result == nullptr) {
+		throw std::bad_alloc();
+	}
+	return result;
+}
+
+void operator delete(void *ptr) noexcept {
+	free(ptr);
+}
+
+void operator delete(void *ptr, size_t /*size*/) noexcept {
+	free(ptr);
+}
+
+ScopedAllocationCounter::ScopedAllocationCounter()
+	: m_previous(activeAllocationCounter)
+{
+	activeAllocationCounter = &m_count;
+}
+
+ScopedAllocationCounter::~ScopedAllocationCounter() {
+	activeAllocationCounter = m_previous;
+}
+
+template<typename TFunc>
+static void measureStage(CsvReplayStage *stage, TestExecutor& executor, TFunc func) {
+	if (stage == nullptr) {
+		func();
+		return;
+	}
+
+	int scheduledBefore = executor.getScheduledCounter();
+	int executedBefore = executor.getExecutedCounter();
+	ScopedAllocationCounter allocations;
+	auto start = std::chrono::steady_clock::now();
+
+	func();
+
+	long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+	stage->calls++;
+	stage->totalNs += ns;
+	stage->maxNs = std::max(stage->maxNs, ns);
+	stage->allocations += allocations.getCount();
+	stage->scheduled += executor.getScheduledCounter() - scheduledBefore;
+	stage->executed += executor.getExecutedCounter() - executedBefore;
+}
+
 static char* trim(char *str) {
 	while (str != nullptr && str[0] == ' ') {
 		str++;
@@ -50,18 +112,22 @@ void CsvReader::processLine(EngineTestHelper *eth) {
 		newState[columnIndeces[1]] = secondToken[0] == '1';
 	}
 
-	double timeStamp = std::stod(timeStampstr);
+	double timeStamp = std::stod(timeStampstr) / m_speed;
 
 	timeStamp += m_timestampOffset;
 
-	eth->setTimeAndInvokeEventsUs(1'000'000 * timeStamp);
+	measureStage(m_stats ? &m_stats->events : nullptr, engine->executor, [&] {
+		eth->setTimeAndInvokeEventsUs(1'000'000 * timeStamp);
+	});
 	for (int index = 0; index < m_triggerCount; index++) {
 		if (currentState[index] == newState[index]) {
 			continue;
 		}
 
 		efitick_t nowNt = getTimeNowNt();
-		hwHandleShaftSignal(index, newState[index], nowNt PASS_ENGINE_PARAMETER_SUFFIX);
+		measureStage(m_stats ? &m_stats->trigger : nullptr, engine->executor, [&] {
+			hwHandleShaftSignal(index, newState[index], nowNt PASS_ENGINE_PARAMETER_SUFFIX);
+		});
 
 		currentState[index] = newState[index];
 	}
@@ -4,15 +4,61 @@
  * @date Jun 26, 2021
  * @author Andrey Belomutskiy, (c) 2012-2021
  */
+struct CsvReplayStage {
+	int calls = 0;
+	long totalNs = 0;
+	long maxNs = 0;
+	long allocations = 0;
+	// events put into the executor queue
+	int scheduled = 0;
+	// events executed by the executor queue
+	int executed = 0;
+};
+
+/**
+ * Optional per-stage measurements, see test_trigger_replay_benchmark.cpp
+ */
+struct CsvReplayStats {
+	// hwHandleShaftSignal: trigger decoder, mainTriggerCallback and scheduling
+	CsvReplayStage trigger;
+	// executor invoking whatever is due before the next edge
+	CsvReplayStage events;
+};
+
+/**
+ * Counts operator new invocations of the current thread while in scope, trigger path is not supposed to allocate
+ */
+class ScopedAllocationCounter {
+public:
+	ScopedAllocationCounter();
+	~ScopedAllocationCounter();
+
+	long getCount() const {
+		return m_count;
+	}
+
+private:
+	long m_count = 0;
+	long *m_previous;
+};
+
 class CsvReader {
 public:
 	CsvReader(size_t triggerCount) : CsvReader(triggerCount, 0.0) {}
-	CsvReader(size_t triggerCount, double timestampOffset)
+	/**
+	 * @param speed 2 would replay the capture twice as fast as it was recorded
+	 */
+	CsvReader(size_t triggerCount, double timestampOffset, double speed = 1)
 		: m_triggerCount(triggerCount)
 		, m_timestampOffset(timestampOffset)
+		, m_speed(speed)
 	{
 	}
 
+	void setStats(CsvReplayStats *stats) {
+		m_stats = stats;
+	}
+
 	void open(const char *fileName, const int* columnIndeces);
 	bool haveMore();
 	void processLine(EngineTestHelper *eth);
@@ -25,6 +71,8 @@ public:
 private:
 	const size_t m_triggerCount;
 	const double m_timestampOffset;
+	const double m_speed;
+	CsvReplayStats *m_stats = nullptr;
 
 	FILE *fp;
 	char buffer[255];
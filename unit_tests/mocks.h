@@ -57,6 +57,8 @@ public:
 	MOCK_METHOD(void, scheduleByTimestamp, (scheduling_s *scheduling, efitimeus_t timeUs, action_s action), (override));
 	MOCK_METHOD(void, scheduleByTimestampNt, (scheduling_s *scheduling, efitime_t timeUs, action_s action), (override));
 	MOCK_METHOD(void, scheduleForLater, (scheduling_s *scheduling, int delayUs, action_s action), (override));
+	MOCK_METHOD(void, cancel, (scheduling_s *scheduling), (override));
+	MOCK_METHOD(void, rescheduleByTimestampNt, (scheduling_s *scheduling, efitime_t timeNt, action_s action), (override));
 };
 
 class MockAirmass : public AirmassVeModelBase {
@@ -278,3 +278,35 @@ TEST(TableBinsBig, RightMiddle)
 {
     EXPECT_BINRESULT(priv::getBin(25.0f, bigBins), 1, 0.5f);
 }
+
+static const float longBins[] = { 500, 700, 1000, 1000, 1500, 2000, 2500, 3000, 3500, 4000, 4500, 5000, 5500, 6000, 6500, 7000 };
+
+TEST(TableBinsLong, BinaryMatchesLinear)
+{
+	for (float value = 501; value < 7000; value += 7.3f) {
+		EXPECT_EQ((priv::findBinIndexLinear<float, 16>(value, longBins)), (priv::findBinIndexBinary<float, 16>(value, longBins))) << value;
+	}
+	// exact bin values, including repeated one
+	for (float value : longBins) {
+		if (value > longBins[0] && value < longBins[15]) {
+			EXPECT_EQ((priv::findBinIndexLinear<float, 16>(value, longBins)), (priv::findBinIndexBinary<float, 16>(value, longBins))) << value;
+		}
+	}
+}
+
+TEST(TableBinsLong, HintMatchesNoHint)
+{
+	size_t hint = 0;
+	float values[] = { 800, 810, 1200, 6999, 7500, 6999, 1000, 999, 400, NAN, 3000, 2999, 3001, 3600, 3400 };
+	for (float value : values) {
+		auto expected = priv::getBin(value, longBins);
+		auto actual = priv::getBinPtr<float, 16>(value, longBins, hint);
+		EXPECT_EQ(expected.Idx, actual.Idx) << value;
+		EXPECT_FLOAT_EQ(expected.Frac, actual.Frac) << value;
+	}
+
+	// garbage hint is not a problem
+	hint = 1000;
+	EXPECT_BINRESULT((priv::getBinPtr<float, 16>(3250, longBins, hint)), 7, 0.5f);
+	EXPECT_EQ(7, hint);
+}
@@ -6,6 +6,7 @@
  */
 
 #include <stdlib.h>
+#include <chrono>
 
 #include "interpolation.h"
 #include "global.h"
@@ -112,3 +113,178 @@ TEST(misc, testInterpolate3d) {
 
 	newTestToComfirmInterpolation();
 }
+
+/**
+ * Bin lookup benchmark: realistic RPM/load sweeps through 16x16 and 32x32 axes, linear search vs
+ * binary search vs binary search with last bin hint. Results are compared and timings are printed.
+ */
+
+#define BENCH_LOOKUPS 200000
+
+template<int TSize>
+struct BinBench {
+	float rpmBins[TSize];
+	float loadBins[TSize];
+	float rpm[BENCH_LOOKUPS];
+	float load[BENCH_LOOKUPS];
+
+	BinBench() {
+		for (int i = 0; i < TSize; i++) {
+			rpmBins[i] = 500 + i * 7000.0f / (TSize - 1);
+			loadBins[i] = 10 + i * 240.0f / (TSize - 1);
+		}
+		// slow acceleration and deceleration with a bit of noise, and an occasional jump
+		srand(0);
+		for (int i = 0; i < BENCH_LOOKUPS; i++) {
+			float phase = i * 2 * 3.14159f / 20000;
+			rpm[i] = 4000 - 3400 * cosf(phase) + rand() % 50;
+			load[i] = 130 - 110 * cosf(phase * 3) + rand() % 5;
+			if (i % 5000 == 0) {
+				load[i] = rand() % 300;
+			}
+		}
+	}
+};
+
+static uint64_t readCycles() {
+#if defined(__x86_64__) || defined(__i386__)
+	return __builtin_ia32_rdtsc();
+#else
+	// no portable cycle counter, nanoseconds are close enough for comparison
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+enum class BinStrategy { Linear, Binary, BinaryWithHint };
+
+template<int TSize, BinStrategy strategy>
+static size_t runBinBench(const BinBench<TSize>& b, double *cyclesPerLookup) {
+	size_t rowHint = 0;
+	size_t columnHint = 0;
+	size_t checksum = 0;
+
+	uint64_t start = readCycles();
+	for (int i = 0; i < BENCH_LOOKUPS; i++) {
+		priv::BinResult row;
+		priv::BinResult col;
+		if constexpr (strategy == BinStrategy::Linear) {
+			row = priv::getBinFraction(b.load[i], b.loadBins, priv::findBinIndexLinear<float, TSize>(b.load[i], b.loadBins));
+			col = priv::getBinFraction(b.rpm[i], b.rpmBins, priv::findBinIndexLinear<float, TSize>(b.rpm[i], b.rpmBins));
+		} else if constexpr (strategy == BinStrategy::Binary) {
+			row = priv::getBinFraction(b.load[i], b.loadBins, priv::findBinIndexBinary<float, TSize>(b.load[i], b.loadBins));
+			col = priv::getBinFraction(b.rpm[i], b.rpmBins, priv::findBinIndexBinary<float, TSize>(b.rpm[i], b.rpmBins));
+		} else {
+			row = priv::getBinPtr<float, TSize>(b.load[i], b.loadBins, rowHint);
+			col = priv::getBinPtr<float, TSize>(b.rpm[i], b.rpmBins, columnHint);
+		}
+		checksum = checksum * 31 + row.Idx * TSize + col.Idx;
+	}
+	*cyclesPerLookup = (double)(readCycles() - start) / BENCH_LOOKUPS;
+	return checksum;
+}
+
+template<int TSize>
+static void runBinBenchmarks() {
+	// only values within the axes range so that all strategies do the search
+	static BinBench<TSize> b;
+	for (int i = 0; i < BENCH_LOOKUPS; i++) {
+		b.rpm[i] = clampF(b.rpmBins[0] + 1, b.rpm[i], b.rpmBins[TSize - 1] - 1);
+		b.load[i] = clampF(b.loadBins[0] + 1, b.load[i], b.loadBins[TSize - 1] - 1);
+	}
+
+	double linear, binary, hint;
+	size_t linearChecksum = runBinBench<TSize, BinStrategy::Linear>(b, &linear);
+	size_t binaryChecksum = runBinBench<TSize, BinStrategy::Binary>(b, &binary);
+	size_t hintChecksum = runBinBench<TSize, BinStrategy::BinaryWithHint>(b, &hint);
+
+	printf("BENCH bins %dx%d cycles per 2d lookup: linear=%.1f binary=%.1f binaryWithHint=%.1f\r\n",
+			TSize, TSize, linear, binary, hint);
+
+	EXPECT_EQ(linearChecksum, binaryChecksum);
+	EXPECT_EQ(linearChecksum, hintChecksum);
+}
+
+TEST(misc, benchmarkBinLookup) {
+	runBinBenchmarks<16>();
+	runBinBenchmarks<32>();
+}
+
+TEST(misc, tableAxisCache) {
+	float rpmBinsA[5] = { 100, 200, 300, 400, 500 };
+	float rpmBinsB[5] = { 100, 200, 300, 400, 500 };
+	float mafBinsB[4] = { 1, 2, 3, 4 };
+
+	Map3D<5, 4, float, float> a;
+	a.init(map, mafBins, rpmBinsA);
+	Map3D<5, 4, float, float> b;
+	b.init(map, mafBinsB, rpmBinsB);
+
+	TableAxisCache cache;
+	cache.beginPass(0);
+
+	EXPECT_NEAR_M4(a.getValue(335.3, 3.551), a.getValueWithAxisCache(335.3, 3.551, cache));
+	ASSERT_EQ(0, cache.getHitCounter());
+
+	// same bin values in different arrays: both axes are shared
+	EXPECT_NEAR_M4(b.getValue(335.3, 3.551), b.getValueWithAxisCache(335.3, 3.551, cache));
+	ASSERT_EQ(2, cache.getHitCounter());
+
+	// different value on one of the axes
+	EXPECT_NEAR_M4(b.getValue(335.3, 2.5), b.getValueWithAxisCache(335.3, 2.5, cache));
+	ASSERT_EQ(3, cache.getHitCounter());
+	cache.endPass();
+
+	// online tuning changes bins of one of the tables
+	rpmBinsB[4] = 600;
+	cache.beginPass(0);
+	EXPECT_NEAR_M4(a.getValue(450, 3), a.getValueWithAxisCache(450, 3, cache));
+	EXPECT_NEAR_M4(b.getValue(450, 3), b.getValueWithAxisCache(450, 3, cache));
+	// only load axis is shared now
+	ASSERT_EQ(4, cache.getHitCounter());
+	cache.endPass();
+
+	// values are forgotten on next pass
+	cache.beginPass(0);
+	EXPECT_NEAR_M4(a.getValue(450, 3), a.getValueWithAxisCache(450, 3, cache));
+	ASSERT_EQ(4, cache.getHitCounter());
+	cache.endPass();
+}
+
+TEST(misc, tableAxisCacheOutsideOfPass) {
+	float rpmBins[5] = { 100, 200, 300, 400, 500 };
+	Map3D<5, 4, float, float> a;
+	a.init(map, mafBins, rpmBins);
+
+	TableAxisCache cache;
+
+	// nothing is cached outside of a pass
+	EXPECT_NEAR_M4(a.getValue(335.3, 3.551), a.getValueWithAxisCache(335.3, 3.551, cache));
+	EXPECT_NEAR_M4(a.getValue(335.3, 3.551), a.getValueWithAxisCache(335.3, 3.551, cache));
+	ASSERT_EQ(0, cache.getHitCounter());
+
+	cache.beginPass(0);
+	EXPECT_NEAR_M4(a.getValue(335.3, 3.551), a.getValueWithAxisCache(335.3, 3.551, cache));
+	EXPECT_NEAR_M4(a.getValue(335.3, 3.551), a.getValueWithAxisCache(335.3, 3.551, cache));
+	ASSERT_EQ(2, cache.getHitCounter());
+
+	// nested pass neither uses nor forgets values of the interrupted one
+	cache.beginPass(0);
+	EXPECT_NEAR_M4(a.getValue(335.3, 3.551), a.getValueWithAxisCache(335.3, 3.551, cache));
+	ASSERT_EQ(2, cache.getHitCounter());
+	cache.endPass();
+
+	EXPECT_NEAR_M4(a.getValue(335.3, 3.551), a.getValueWithAxisCache(335.3, 3.551, cache));
+	ASSERT_EQ(4, cache.getHitCounter());
+	cache.endPass();
+
+	// bins changed by online tuning after the pass are seen right away by lookups outside of a pass
+	rpmBins[2] = 350;
+	EXPECT_NEAR_M4(a.getValue(335.3, 3.551), a.getValueWithAxisCache(335.3, 3.551, cache));
+	ASSERT_EQ(4, cache.getHitCounter());
+
+	// configuration change drops all entries
+	cache.beginPass(1);
+	EXPECT_NEAR_M4(a.getValue(335.3, 3.551), a.getValueWithAxisCache(335.3, 3.551, cache));
+	ASSERT_EQ(4, cache.getHitCounter());
+	cache.endPass();
+}
@@ -97,3 +97,129 @@ TEST(ignition, trailingSpark) {
 	EXPECT_EQ(enginePins.coils[0].getLogicValue(), false);
 	EXPECT_EQ(enginePins.trailingCoils[0].getLogicValue(), false);
 }
+
+TEST(ignition, angleBasedEventQueue) {
+	AngleBasedEventQueue queue;
+
+	AngleBasedEvent e1;
+	AngleBasedEvent e2;
+	AngleBasedEvent e3;
+	e1.position.triggerEventIndex = 5;
+	e2.position.triggerEventIndex = 2;
+	e3.position.triggerEventIndex = 5;
+
+	ASSERT_TRUE(queue.queue(&e1));
+	ASSERT_TRUE(queue.queue(&e2));
+	ASSERT_TRUE(queue.queue(&e3));
+	ASSERT_EQ(3, queue.size());
+
+	// already pending
+	ASSERT_FALSE(queue.queue(&e1));
+	ASSERT_EQ(3, queue.size());
+
+	// tooth order, same tooth in the order of queueing
+	ASSERT_EQ(&e2, queue.getElementAtIndexForUnitText(0));
+	ASSERT_EQ(&e1, queue.getElementAtIndexForUnitText(1));
+	ASSERT_EQ(&e3, queue.getElementAtIndexForUnitText(2));
+
+	// pending event follows its new angle
+	e3.position.triggerEventIndex = 7;
+	ASSERT_TRUE(queue.queue(&e3));
+	ASSERT_EQ(3, queue.size());
+
+	ASSERT_EQ(nullptr, queue.takeForTooth(4));
+	ASSERT_EQ(&e1, queue.takeForTooth(5));
+	ASSERT_EQ(nullptr, queue.takeForTooth(5));
+	ASSERT_FALSE(queue.isPending(&e1));
+	ASSERT_TRUE(queue.isPending(&e3));
+	ASSERT_EQ(&e3, queue.takeForTooth(7));
+	ASSERT_EQ(1, queue.size());
+
+	// taken events could be queued again
+	ASSERT_TRUE(queue.queue(&e1));
+	ASSERT_EQ(2, queue.size());
+}
+
+static int countEventsTouchedOnTooth(AngleBasedEventQueue *queue, uint32_t toothIndex) {
+	int counter = 0;
+	while (queue->takeForTooth(toothIndex)) {
+		counter++;
+	}
+	return counter;
+}
+
+TEST(ignition, angleBasedEventsWorkPerToothDoesNotDependOnCylinderCount) {
+	// 60-2 wheel, 116 teeth per engine cycle
+	int teethCount = 116;
+
+	for (int cylindersCount : { 4, 12 }) {
+		AngleBasedEventQueue queue;
+		AngleBasedEvent events[MAX_CYLINDER_COUNT];
+		int expectedPerTooth[PWM_PHASE_MAX_COUNT] = {};
+
+		for (int i = 0; i < cylindersCount; i++) {
+			int tooth = i * teethCount / cylindersCount;
+			events[i].position.triggerEventIndex = tooth;
+			expectedPerTooth[tooth]++;
+			ASSERT_TRUE(queue.queue(&events[i]));
+		}
+
+		// each tooth only touches its own events no matter how many other events are pending
+		for (int tooth = 0; tooth < teethCount; tooth++) {
+			int pendingBefore = queue.size();
+			ASSERT_EQ(expectedPerTooth[tooth], countEventsTouchedOnTooth(&queue, tooth)) << "tooth " << tooth;
+			ASSERT_EQ(pendingBefore - expectedPerTooth[tooth], queue.size());
+		}
+		ASSERT_EQ(0, queue.size());
+	}
+}
+
+TEST(ignition, toothPlan) {
+	ToothPlan plan;
+	ASSERT_EQ(0, plan.getCylinders(0));
+
+	plan.setTooth(0, 3);
+	plan.setTooth(2, 3);
+	plan.setTooth(11, 40);
+	ASSERT_EQ(0b101, plan.getCylinders(3));
+	ASSERT_EQ(1 << 11, plan.getCylinders(40));
+
+	// angle recalculated, cylinder moves to another tooth
+	plan.setTooth(2, 4);
+	ASSERT_EQ(0b001, plan.getCylinders(3));
+	ASSERT_EQ(0b100, plan.getCylinders(4));
+
+	ASSERT_EQ(0, plan.getCylinders(PWM_PHASE_MAX_COUNT));
+
+	plan.clear();
+	ASSERT_EQ(0, plan.getCylinders(3));
+	ASSERT_EQ(0, plan.getCylinders(40));
+}
+
+TEST(ignition, toothPlanMatchesEventPositions) {
+	WITH_ENGINE_TEST_HELPER(FORD_ASPIRE_1996);
+
+	setOperationMode(engineConfiguration, FOUR_STROKE_CRANK_SENSOR);
+	engineConfiguration->useOnlyRisingEdgeForTrigger = true;
+	eth.setTriggerType(TT_ONE PASS_ENGINE_PARAMETER_SUFFIX);
+
+	eth.fireTriggerEvents2(/* count */ 5, 25 /* ms */);
+	ASSERT_EQ( 1200,  GET_RPM()) << "RPM";
+	ASSERT_TRUE(ENGINE(injectionEvents.isReady));
+	ASSERT_TRUE(ENGINE(ignitionEvents.isReady));
+
+	for (uint32_t tooth = 0; tooth < ENGINE(engineCycleEventCount); tooth++) {
+		cylinder_mask_t fuel = 0;
+		cylinder_mask_t spark = 0;
+		for (size_t i = 0; i < CONFIG(specs.cylindersCount); i++) {
+			if (ENGINE(injectionEvents.elements[i]).injectionStart.triggerEventIndex == tooth) {
+				fuel |= 1 << i;
+			}
+			if (ENGINE(ignitionEvents.elements[i]).dwellPosition.triggerEventIndex == tooth) {
+				spark |= 1 << i;
+			}
+		}
+		ASSERT_EQ(fuel, ENGINE(injectionEvents.toothPlan).getCylinders(tooth)) << "fuel tooth " << tooth;
+		ASSERT_EQ(spark, ENGINE(ignitionEvents.toothPlan).getCylinders(tooth)) << "spark tooth " << tooth;
+	}
+}
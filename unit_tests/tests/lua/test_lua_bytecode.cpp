@@ -0,0 +1,69 @@
+#include "rusefi_lua.h"
+#include "lua.hpp"
+#include "lua_bytecode.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+static const char* script = R"(
+	function testFunc()
+		return 5.5
+	end
+)";
+
+static int appendBytecode(lua_State* /*l*/, const void* p, size_t size, void* ud) {
+	auto output = reinterpret_cast<std::vector<char>*>(ud);
+	auto bytes = reinterpret_cast<const char*>(p);
+	output->insert(output->end(), bytes, bytes + size);
+	return 0;
+}
+
+// same as misc/lua_precompile does
+static std::vector<char> precompile(const char* source) {
+	std::vector<char> buffer(LUA_BYTECODE_HEADER_SIZE);
+	lua_State* l = luaL_newstate();
+	EXPECT_EQ(0, luaL_loadstring(l, source));
+	lua_dump(l, appendBytecode, &buffer, 1);
+	lua_close(l);
+	setLuaBytecodeHeader(buffer.data(), buffer.size() - LUA_BYTECODE_HEADER_SIZE);
+	return buffer;
+}
+
+TEST(LuaBytecode, Valid) {
+	auto buffer = precompile(script);
+	EXPECT_EQ(buffer.size() - LUA_BYTECODE_HEADER_SIZE, getLuaBytecodeSize(buffer.data(), buffer.size()));
+	EXPECT_FLOAT_EQ(5.5f, testLuaBytecodeReturnsNumber(buffer.data(), buffer.size()));
+
+	// configuration field is larger than bytecode
+	buffer.resize(buffer.size() + 100, 0);
+	EXPECT_FLOAT_EQ(5.5f, testLuaBytecodeReturnsNumber(buffer.data(), buffer.size()));
+}
+
+TEST(LuaBytecode, Truncated) {
+	auto buffer = precompile(script);
+	EXPECT_EQ(0u, getLuaBytecodeSize(buffer.data(), buffer.size() - 1));
+	EXPECT_EQ(0u, getLuaBytecodeSize(buffer.data(), 3));
+}
+
+TEST(LuaBytecode, Corrupt) {
+	auto buffer = precompile(script);
+	buffer[buffer.size() / 2] ^= 0x10;
+	EXPECT_EQ(0u, getLuaBytecodeSize(buffer.data(), buffer.size()));
+	EXPECT_ANY_THROW(testLuaBytecodeReturnsNumber(buffer.data(), buffer.size()));
+}
+
+TEST(LuaBytecode, WrongLuaVersion) {
+	auto buffer = precompile(script);
+	// version byte follows LUA_SIGNATURE, checksum is fine
+	buffer[LUA_BYTECODE_HEADER_SIZE + 4] = 0x53;
+	setLuaBytecodeHeader(buffer.data(), buffer.size() - LUA_BYTECODE_HEADER_SIZE);
+	EXPECT_EQ(0u, getLuaBytecodeSize(buffer.data(), buffer.size()));
+	EXPECT_ANY_THROW(testLuaBytecodeReturnsNumber(buffer.data(), buffer.size()));
+}
+
+TEST(LuaBytecode, ChunkWithoutContainer) {
+	auto buffer = precompile(script);
+	buffer.erase(buffer.begin(), buffer.begin() + LUA_BYTECODE_HEADER_SIZE);
+	EXPECT_EQ(0u, getLuaBytecodeSize(buffer.data(), buffer.size()));
+	EXPECT_ANY_THROW(testLuaBytecodeReturnsNumber(buffer.data(), buffer.size()));
+}
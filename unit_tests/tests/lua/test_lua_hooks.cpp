@@ -36,3 +36,28 @@ TEST(LuaHooks, Table3d) {
 	setTable(config->fsioTable2, (uint8_t)14);
 	EXPECT_EQ(testLuaReturnsNumber(tableTest), 14);
 }
+
+static const char* findSensorTest = R"(
+local tps = findSensor("tps 1")
+
+function testFunc()
+	return getSensor(tps)
+end
+)";
+
+TEST(LuaHooks, FindSensor) {
+	Sensor::setMockValue(SensorType::Tps1, 25);
+	EXPECT_EQ(testLuaReturnsNumber(findSensorTest), 25);
+
+	EXPECT_EQ(testLuaReturnsInteger(R"(
+function testFunc()
+	return findSensor("CLT")
+end
+)"), static_cast<int>(SensorType::Clt));
+
+	EXPECT_EQ(testLuaReturnsNumberOrNil(R"(
+function testFunc()
+	return findSensor("no such sensor")
+end
+)"), unexpected);
+}
@@ -4,6 +4,8 @@
 
 #include <gtest/gtest.h>
 
+extern int timeNowUs;
+
 class SensorBasic : public ::testing::Test {
 protected:
 	void SetUp() override {
@@ -108,3 +110,91 @@ TEST_F(SensorBasic, HasSensorMock) {
 	// Now we should!
 	ASSERT_TRUE(Sensor::hasSensor(SensorType::Clt));
 }
+
+TEST_F(SensorBasic, SnapshotPublished) {
+	MockSensor dut(SensorType::Clt);
+
+	// Not registered - nothing published
+	dut.set(50);
+	EXPECT_FALSE(Sensor::getSnapshot(SensorType::Clt).valid);
+	EXPECT_EQ(0u, Sensor::getGeneration(SensorType::Clt));
+
+	// Registration picks up the value set before
+	ASSERT_TRUE(dut.Register());
+	EXPECT_TRUE(Sensor::getSnapshot(SensorType::Clt).valid);
+	EXPECT_FLOAT_EQ(50, Sensor::getSnapshot(SensorType::Clt).value);
+	uint32_t generation = Sensor::getGeneration(SensorType::Clt);
+
+	dut.set(75);
+	auto snapshot = Sensor::getSnapshot(SensorType::Clt);
+	EXPECT_TRUE(snapshot.valid);
+	EXPECT_FLOAT_EQ(75, snapshot.value);
+	EXPECT_EQ(getTimeNowNt(), snapshot.timestamp);
+	EXPECT_EQ(generation + 1, Sensor::getGeneration(SensorType::Clt));
+
+	// Invalid readings count as a new generation too
+	dut.invalidate();
+	EXPECT_FALSE(Sensor::getSnapshot(SensorType::Clt).valid);
+	EXPECT_FALSE(Sensor::get(SensorType::Clt).Valid);
+	EXPECT_EQ(generation + 2, Sensor::getGeneration(SensorType::Clt));
+
+	// Reset clears the snapshot
+	Sensor::resetRegistry();
+	EXPECT_EQ(0u, Sensor::getGeneration(SensorType::Clt));
+}
+
+TEST_F(SensorBasic, SnapshotSecondSensorIgnored) {
+	MockSensor dut(SensorType::Clt);
+	ASSERT_TRUE(dut.Register());
+	dut.set(75);
+
+	// Same type but not the registered one
+	MockSensor other(SensorType::Clt);
+	other.set(20);
+
+	EXPECT_FLOAT_EQ(75, Sensor::get(SensorType::Clt).value_or(0));
+	EXPECT_FLOAT_EQ(75, Sensor::getSnapshot(SensorType::Clt).value);
+}
+
+TEST_F(SensorBasic, SnapshotHasSensor) {
+	MockSensor dut(SensorType::Clt);
+	ASSERT_TRUE(dut.Register());
+	dut.set(75);
+
+	dut.setHasSensor(false);
+	EXPECT_FALSE(Sensor::get(SensorType::Clt).Valid);
+
+	dut.setHasSensor(true);
+	EXPECT_TRUE(Sensor::get(SensorType::Clt).Valid);
+}
+
+TEST_F(SensorBasic, SnapshotTimeout) {
+	MockSensor dut(SensorType::Clt);
+	ASSERT_TRUE(dut.Register());
+	dut.set(75);
+
+	// MockSensor times out after 50ms
+	timeNowUs += 49000;
+	EXPECT_TRUE(Sensor::get(SensorType::Clt).Valid);
+
+	timeNowUs += 2000;
+	EXPECT_FALSE(Sensor::get(SensorType::Clt).Valid);
+	// Registry and sensor agree
+	EXPECT_FALSE(dut.get().Valid);
+
+	// Snapshot itself keeps the last reading
+	EXPECT_TRUE(Sensor::getSnapshot(SensorType::Clt).valid);
+}
+
+TEST_F(SensorBasic, SnapshotMock) {
+	MockSensor dut(SensorType::Clt);
+	ASSERT_TRUE(dut.Register());
+	dut.set(75);
+
+	// Mock takes precedence over the published value
+	Sensor::setMockValue(SensorType::Clt, 25);
+	EXPECT_FLOAT_EQ(25, Sensor::get(SensorType::Clt).value_or(0));
+
+	Sensor::resetMockValue(SensorType::Clt);
+	EXPECT_FLOAT_EQ(75, Sensor::get(SensorType::Clt).value_or(0));
+}
@@ -17,16 +17,9 @@ struct MockSensor final : public StoredValueSensor
 		StoredValueSensor::invalidate();
 	}
 
-	bool hasSensor() const override {
-		return m_hasSensor;
-	}
-
 	void setHasSensor(bool h) {
-		m_hasSensor = h;
+		StoredValueSensor::setHasSensor(h);
 	}
 
 	void showInfo(const char* name) const override {}
-
-private:
-	bool m_hasSensor = true;
 };
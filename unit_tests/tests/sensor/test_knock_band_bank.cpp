@@ -0,0 +1,114 @@
+#include "knock_band_bank.h"
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+#define SAMPLE_RATE 218750
+#define VOLTS_PER_COUNT (3.3f / 4095.0f)
+
+// knock-ish burst at given frequency on top of vcc/2 and some noise
+static void makeSamples(uint16_t* samples, size_t count, float knockHz) {
+	uint32_t noise = 12345;
+	for (size_t i = 0; i < count; i++) {
+		noise = noise * 1103515245 + 12345;
+		float t = (float)i / SAMPLE_RATE;
+		float burst = i > count / 3 ? 400 * sinf(2 * M_PI * knockHz * t) * expf(-3.0f * i / count) : 0;
+		samples[i] = 2048 + burst + (int)((noise >> 16) % 64) - 32;
+	}
+}
+
+// what processLastKnockEvent did before band bank, one sample at a time
+static float scalarMeanSquares(const uint16_t* samples, size_t count, float bandHz) {
+	Biquad filter;
+	filter.configureBandpass(SAMPLE_RATE, bandHz, 3);
+	filter.cookSteadyState(3.3f / 2);
+
+	float sumSq = 0;
+	for (size_t i = 0; i < count; i++) {
+		float volts = VOLTS_PER_COUNT * samples[i];
+		float filtered = filter.filter(volts);
+		sumSq += filtered * filtered;
+	}
+	return sumSq / count;
+}
+
+TEST(KnockBandBank, Bands) {
+	KnockBandBank dut;
+	dut.configure(SAMPLE_RATE, 6500);
+	ASSERT_EQ(3, dut.getBandCount());
+	EXPECT_NEAR(6500, dut.getBandHz(0), 1);
+	EXPECT_NEAR(10783, dut.getBandHz(1), 1);
+	EXPECT_NEAR(13526, dut.getBandHz(2), 1);
+
+	// upper modes above Nyquist are dropped
+	dut.configure(20000, 6500);
+	EXPECT_EQ(1, dut.getBandCount());
+}
+
+TEST(KnockBandBank, BitExactWithScalarFilter) {
+	KnockBandBank dut;
+	dut.configure(SAMPLE_RATE, 6500);
+
+	static uint16_t samples[2000];
+	// odd sizes leave a partial last block
+	for (size_t count : { 100, 1000, 1337, 2000 }) {
+		makeSamples(samples, count, 6500);
+
+		float meanSquares[KNOCK_BAND_COUNT];
+		dut.process(samples, count, VOLTS_PER_COUNT, 3.3f / 2, meanSquares);
+
+		for (size_t band = 0; band < dut.getBandCount(); band++) {
+			float expected = scalarMeanSquares(samples, count, dut.getBandHz(band));
+			// exact, not near
+			EXPECT_EQ(0, memcmp(&expected, &meanSquares[band], sizeof(float))) << count << " band " << band
+				<< " " << expected << " vs " << meanSquares[band];
+		}
+	}
+}
+
+TEST(KnockBandBank, EnergyInMatchingBand) {
+	KnockBandBank dut;
+	dut.configure(SAMPLE_RATE, 6500);
+
+	uint16_t samples[1500];
+	float meanSquares[KNOCK_BAND_COUNT];
+
+	// knock at the second mode shows up in second band most
+	makeSamples(samples, std::size(samples), dut.getBandHz(1));
+	dut.process(samples, std::size(samples), VOLTS_PER_COUNT, 3.3f / 2, meanSquares);
+	EXPECT_GT(meanSquares[1], meanSquares[0]);
+	EXPECT_GT(meanSquares[1], meanSquares[2]);
+}
+
+TEST(knockBandBankBenchmark, DISABLED_throughput) {
+	KnockBandBank dut;
+	dut.configure(SAMPLE_RATE, 6500);
+
+	static uint16_t samples[2000];
+	makeSamples(samples, std::size(samples), 6500);
+	float meanSquares[KNOCK_BAND_COUNT];
+
+	const int events = 2000;
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < events; i++) {
+		dut.process(samples, std::size(samples), VOLTS_PER_COUNT, 3.3f / 2, meanSquares);
+	}
+	double bankUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+	volatile float sink = 0;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < events; i++) {
+		for (size_t band = 0; band < dut.getBandCount(); band++) {
+			sink = sink + scalarMeanSquares(samples, std::size(samples), dut.getBandHz(band));
+		}
+	}
+	double scalarUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+	double sampleCount = (double)events * std::size(samples);
+	printf("knock %d bands: bank %.1f samples/us, scalar %.1f samples/us\n", (int)dut.getBandCount(),
+			sampleCount / bankUs, sampleCount / scalarUs);
+	EXPECT_GT(bankUs, 0);
+}
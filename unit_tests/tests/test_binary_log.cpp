@@ -1,5 +1,7 @@
 #include "log_field.h"
 #include "buffered_writer.h"
+#include "log_recovery.h"
+#include "binary_logging.h"
 
 #include <gmock/gmock.h>
 
@@ -59,3 +61,149 @@ TEST(BinaryLogField, Value) {
 	// Check that big endian data was written, and bytes after weren't touched
 	EXPECT_THAT(buffer, ElementsAre(0x00, 0xbc, 0x61, 0x4e, 0xAA, 0xAA));
 }
+
+class VectorReader : public LogReader {
+public:
+	VectorReader(const std::vector<char>& data) : data(data) { }
+
+	size_t read(size_t offset, char* buffer, size_t count) override {
+		if (offset >= data.size()) {
+			return 0;
+		}
+		count = std::min(count, data.size() - offset);
+		memcpy(buffer, data.data() + offset, count);
+		return count;
+	}
+
+	const std::vector<char>& data;
+};
+
+#define TEST_LOG_FIELDS_SIZE 6
+
+static void appendTestLogBlock(std::vector<char>& log, uint8_t counter, uint8_t value) {
+	// type, counter, timestamp
+	log.insert(log.end(), { 0, (char)counter, 0x12, 0x34 });
+	uint8_t sum = 0;
+	for (int i = 0; i < TEST_LOG_FIELDS_SIZE; i++) {
+		log.push_back(value + i);
+		sum += value + i;
+	}
+	log.push_back(sum);
+}
+
+TEST(BinaryLog, FindDataEndAfterPowerLoss) {
+	// header with two fields descriptors
+	size_t headerSize = MLQ_HEADER_SIZE + 2 * 55;
+	std::vector<char> log(headerSize, 0);
+	memcpy(log.data(), "MLVLG", 6);
+	log[17] = headerSize;
+	log[16] = headerSize >> 8;
+	log[19] = TEST_LOG_FIELDS_SIZE;
+
+	std::vector<size_t> blockEnds;
+	// rolling counter starts wherever it was for previous file
+	for (int i = 0; i < 3; i++) {
+		appendTestLogBlock(log, 254 + i, 10 * i);
+		blockEnds.push_back(log.size());
+	}
+	size_t firstBlockSize = blockEnds[0] - headerSize;
+
+	// complete file
+	{
+		VectorReader reader(log);
+		EXPECT_EQ(blockEnds[2], findLogDataEnd(reader, log.size()));
+	}
+
+	// rest of preallocated region has random stale content
+	{
+		std::vector<char> file = log;
+		file.resize(file.size() + 4096, 0x55);
+		VectorReader reader(file);
+		EXPECT_EQ(blockEnds[2], findLogDataEnd(reader, file.size()));
+	}
+
+	// stale blocks of an older log: rolling counter does not continue
+	{
+		std::vector<char> file = log;
+		appendTestLogBlock(file, 17, 0);
+		VectorReader reader(file);
+		EXPECT_EQ(blockEnds[2], findLogDataEnd(reader, file.size()));
+
+		// while this one does
+		file = log;
+		appendTestLogBlock(file, 1, 0);
+		EXPECT_EQ(file.size(), findLogDataEnd(reader, file.size()));
+	}
+
+	// half written block
+	{
+		VectorReader reader(log);
+		EXPECT_EQ(blockEnds[1], findLogDataEnd(reader, blockEnds[2] - 1));
+	}
+
+	// corrupted data in the second block
+	{
+		std::vector<char> file = log;
+		file[blockEnds[0] + 5]++;
+		VectorReader reader(file);
+		EXPECT_EQ(blockEnds[0], findLogDataEnd(reader, file.size()));
+	}
+
+	// header only
+	{
+		VectorReader reader(log);
+		EXPECT_EQ(headerSize, findLogDataEnd(reader, headerSize + firstBlockSize - 1));
+	}
+
+	// not even the header
+	{
+		std::vector<char> file(4096, 0);
+		VectorReader reader(file);
+		EXPECT_EQ(0, findLogDataEnd(reader, file.size()));
+	}
+}
+
+class VectorWriter : public Writer {
+public:
+	size_t write(const char* buffer, size_t count) override {
+		if (isDropping) {
+			return 0;
+		}
+		data.insert(data.end(), buffer, buffer + count);
+		return count;
+	}
+
+	size_t flush() override {
+		return 0;
+	}
+
+	std::vector<char> data;
+	bool isDropping = false;
+};
+
+TEST(BinaryLog, FindDataEndAfterDroppedBlock) {
+	VectorWriter writer;
+	writeHeader(writer);
+
+	char block[MAX_RECOVERY_BLOCK_SIZE];
+	for (int i = 0; i < 5; i++) {
+		// block in the middle is dropped by a full ring
+		writer.isDropping = i == 2;
+		writeBlock(writer, block);
+	}
+	size_t dataEnd = writer.data.size();
+
+	VectorReader reader(writer.data);
+	EXPECT_EQ(dataEnd, findLogDataEnd(reader, dataEnd));
+
+	// rest of preallocated region holds an older log which happens to continue the rolling counter
+	for (int i = 0; i < 10; i++) {
+		writeBlock(writer, block);
+	}
+	EXPECT_EQ(writer.data.size(), findLogDataEnd(reader, writer.data.size()));
+
+	// that's why end marker is written after our data
+	ASSERT_GT(writer.data.size(), dataEnd + MAX_RECOVERY_BLOCK_SIZE);
+	std::fill(writer.data.begin() + dataEnd, writer.data.begin() + dataEnd + MAX_RECOVERY_BLOCK_SIZE, 0xFF);
+	EXPECT_EQ(dataEnd, findLogDataEnd(reader, writer.data.size()));
+}
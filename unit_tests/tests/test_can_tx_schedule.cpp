@@ -0,0 +1,59 @@
+#include "can_tx_schedule.h"
+
+#include <gtest/gtest.h>
+
+TEST(CanTxSchedule, SlotDueTicks) {
+	// 50ms slot 5ms into the period
+	EXPECT_FALSE(isCanTxSlotDue(0, 50, 5));
+	EXPECT_TRUE(isCanTxSlotDue(5, 50, 5));
+	EXPECT_FALSE(isCanTxSlotDue(10, 50, 5));
+	EXPECT_FALSE(isCanTxSlotDue(50, 50, 5));
+	EXPECT_TRUE(isCanTxSlotDue(55, 50, 5));
+	EXPECT_TRUE(isCanTxSlotDue(1005, 50, 5));
+
+	// phase in the middle of a tick is due on the tick which covers it
+	EXPECT_FALSE(isCanTxSlotDue(0, 20, 7));
+	EXPECT_TRUE(isCanTxSlotDue(5, 20, 7));
+	EXPECT_FALSE(isCanTxSlotDue(10, 20, 7));
+	EXPECT_TRUE(isCanTxSlotDue(25, 20, 7));
+
+	// phase beyond the period wraps around
+	EXPECT_TRUE(isCanTxSlotDue(10, 50, 60));
+
+	// slot as fast as the tick is due on every tick
+	for (uint32_t timeMs = 0; timeMs < 100; timeMs += CAN_TX_TICK_MS) {
+		EXPECT_TRUE(isCanTxSlotDue(timeMs, CAN_TX_TICK_MS, 0)) << timeMs;
+	}
+
+	// zero period is never due
+	EXPECT_FALSE(isCanTxSlotDue(0, 0, 0));
+}
+
+TEST(CanTxSchedule, SharedTicks) {
+	// same phases as Haltech in can_dash.cpp
+	const CanTxSlot spread[] = {
+		{ "20ms", 20, 0, nullptr },
+		{ "50ms", 50, 5, nullptr },
+		{ "100ms", 100, 10, nullptr },
+		{ "200ms", 200, 15, nullptr },
+	};
+	EXPECT_EQ(0, getCanTxSharedTickCount(spread, std::size(spread)));
+
+	// everything at zero phase: 0ms has all three, 100ms has two
+	const CanTxSlot burst[] = {
+		{ "20ms", 20, 0, nullptr },
+		{ "100ms", 100, 0, nullptr },
+		{ "200ms", 200, 0, nullptr },
+	};
+	EXPECT_EQ(2, getCanTxSharedTickCount(burst, std::size(burst)));
+
+	// same phases as E90: 5ms slot shares each tick any other slot is due on
+	const CanTxSlot e90[] = {
+		{ "5ms", 5, 0, nullptr },
+		{ "50ms", 50, 5, nullptr },
+		{ "100ms", 100, 30, nullptr },
+	};
+	EXPECT_EQ(3, getCanTxSharedTickCount(e90, std::size(e90)));
+
+	EXPECT_EQ(0, getCanTxSharedTickCount(nullptr, 0));
+}
@@ -0,0 +1,61 @@
+/*
+ * @file test_config_change.cpp
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#include "engine_test_helper.h"
+#include "config_change.h"
+
+TEST(ConfigChange, regions) {
+	static engine_configuration_s previous;
+	static engine_configuration_s current;
+	memset(&previous, 0, sizeof(previous));
+	memset(&current, 0, sizeof(current));
+
+	EXPECT_EQ(CC_NONE, getConfigurationChanges(&previous, &current));
+
+	current.etb.pFactor = 3;
+	EXPECT_EQ(CC_ETB, getConfigurationChanges(&previous, &current));
+
+	// last byte of a region
+	current.etb.pFactor = 0;
+	current.etb.maxValue = 1;
+	EXPECT_EQ(CC_ETB, getConfigurationChanges(&previous, &current));
+
+	current.trigger.type = TT_ONE;
+	EXPECT_EQ(CC_ETB | CC_TRIGGER, getConfigurationChanges(&previous, &current));
+
+	memcpy(&previous, &current, sizeof(previous));
+	// read live, nothing to re-initialize
+	current.cranking.rpm = 400;
+	current.globalFuelCorrection = 1.1;
+	EXPECT_EQ(CC_NONE, getConfigurationChanges(&previous, &current));
+
+	// anything not attributed to a subsystem makes everyone re-initialize
+	current.tpsMin = 100;
+	EXPECT_EQ(CC_ALL, getConfigurationChanges(&previous, &current));
+}
+
+TEST(ConfigChange, onlyAffectedSubsystems) {
+	WITH_ENGINE_TEST_HELPER(TEST_ENGINE);
+
+	// whatever previous test has left in activeConfiguration
+	incrementGlobalConfigurationVersion(PASS_ENGINE_PARAMETER_SIGNATURE);
+
+	int version = engine->globalConfigurationVersion;
+	engineConfiguration->idleRpmPid.iFactor += 0.1;
+	incrementGlobalConfigurationVersion(PASS_ENGINE_PARAMETER_SIGNATURE);
+	EXPECT_EQ(version + 1, engine->globalConfigurationVersion);
+	EXPECT_EQ(CC_IDLE, engine->lastConfigurationChanges);
+
+	// tables are not part of engine_configuration_s
+	config->ignitionTable[0][0] += 1;
+	incrementGlobalConfigurationVersion(PASS_ENGINE_PARAMETER_SIGNATURE);
+	EXPECT_EQ(CC_NONE, engine->lastConfigurationChanges);
+
+	engineConfiguration->globalTriggerAngleOffset += 10;
+	incrementGlobalConfigurationVersion(PASS_ENGINE_PARAMETER_SIGNATURE);
+	EXPECT_EQ(CC_TRIGGER, engine->lastConfigurationChanges);
+}
@@ -0,0 +1,95 @@
+/*
+ * @file test_engine_sniffer.cpp
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#include "engine_test_helper.h"
+#include "engine_sniffer.h"
+
+extern WaveChart waveChart;
+extern int timeNowUs;
+
+TEST(engineSniffer, recordEncoding) {
+	uint32_t record = encodeSnifferRecord(5, true, 0x800001);
+	// time wraps at 23 bits
+	ASSERT_EQ(0x05800001u, record);
+	ASSERT_EQ(0x05000002u, encodeSnifferRecord(5, false, 2));
+	ASSERT_EQ(0xFF0004D2u, encodeSnifferValue(1234));
+}
+
+TEST(engineSniffer, binaryRecordsDecodedOnPublish) {
+	WITH_ENGINE_TEST_HELPER(TEST_ENGINE);
+	ENGINE(isEngineChartEnabled) = true;
+
+	waveChart.reset();
+	ASSERT_EQ(0, waveChart.getSize());
+
+	timeNowUs = 1000000;
+	waveChart.addEvent3("c1", PROTOCOL_ES_UP);
+	timeNowUs += 500;
+	waveChart.addEvent3("c1", PROTOCOL_ES_DOWN);
+	timeNowUs += 1000;
+	// TDC carries rpm
+	waveChart.addEvent3(TOP_DEAD_CENTER_MESSAGE, "1234");
+	ASSERT_EQ(3, waveChart.getSize());
+
+	waveChart.publish();
+	// same text protocol as always, times in ENGINE_SNIFFER_UNIT_US since first event
+	ASSERT_STREQ("wave_chart,c1!u!0!c1!d!50!r!1234!150!,", waveChart.getTextForUnitTest());
+
+	// nothing is left over in the next chart
+	waveChart.reset();
+	ASSERT_EQ(0, waveChart.getSize());
+	waveChart.publish();
+	ASSERT_STREQ("wave_chart,,", waveChart.getTextForUnitTest());
+}
+
+TEST(engineSniffer, fullChartDropsEvents) {
+	WITH_ENGINE_TEST_HELPER(TEST_ENGINE);
+	ENGINE(isEngineChartEnabled) = true;
+	engineConfiguration->engineChartSize = 5;
+
+	waveChart.reset();
+	for (int i = 0; i < 10; i++) {
+		waveChart.addEvent3("c1", PROTOCOL_ES_UP);
+	}
+	ASSERT_EQ(5, waveChart.getSize());
+	ASSERT_TRUE(waveChart.isFull());
+}
+
+TEST(engineSniffer, channelTableStartsOverWithEachChart) {
+	WITH_ENGINE_TEST_HELPER(TEST_ENGINE);
+	ENGINE(isEngineChartEnabled) = true;
+	engineConfiguration->engineChartSize = 100;
+
+	static char names[ENGINE_SNIFFER_MAX_CHANNELS][8];
+	waveChart.reset();
+	for (int i = 0; i < ENGINE_SNIFFER_MAX_CHANNELS; i++) {
+		itoa10(names[i], i);
+		waveChart.addEvent3(names[i], PROTOCOL_ES_UP);
+	}
+	// no room for one more channel in this chart
+	waveChart.addEvent3("new", PROTOCOL_ES_UP);
+	ASSERT_EQ(ENGINE_SNIFFER_MAX_CHANNELS, waveChart.getSize());
+
+	waveChart.reset();
+	waveChart.addEvent3("new", PROTOCOL_ES_UP);
+	ASSERT_EQ(1, waveChart.getSize());
+	waveChart.publish();
+	ASSERT_STREQ("wave_chart,new!u!0!,", waveChart.getTextForUnitTest());
+}
+
+TEST(engineSniffer, chartSizeIsLimitedByRecordBuffer) {
+	WITH_ENGINE_TEST_HELPER(TEST_ENGINE);
+	ENGINE(isEngineChartEnabled) = true;
+	engineConfiguration->engineChartSize = WaveChart::getMaxSize() + 100;
+
+	waveChart.reset();
+	for (int i = 0; i < WaveChart::getMaxSize() + 100; i++) {
+		waveChart.addEvent3("c1", PROTOCOL_ES_UP);
+	}
+	ASSERT_EQ(WaveChart::getMaxSize(), waveChart.getSize());
+	ASSERT_TRUE(waveChart.isFull());
+}
@@ -0,0 +1,348 @@
+/*
+ * @file test_flash_journal.cpp
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#include "flash_journal.h"
+#include "crc.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+/**
+ * NOR flash: erase sets all bytes to 0xFF, programming can only clear bits.
+ * Power is lost once the given number of bytes has been programmed, nothing works until power is restored.
+ */
+class FlashEmulator : public IFlashRegion {
+public:
+	explicit FlashEmulator(size_t size)
+		: m_memory(size, 0xFF)
+	{
+	}
+
+	bool erase(size_t size) override {
+		EXPECT_LE(size, m_memory.size());
+		if (m_isPowerLost) {
+			return false;
+		}
+		if (m_tearNextErase) {
+			// only the first half of the sector got erased
+			m_tearNextErase = false;
+			m_isPowerLost = true;
+			size /= 2;
+		}
+		std::fill(m_memory.begin(), m_memory.begin() + size, 0xFF);
+		eraseCount++;
+		return !m_isPowerLost;
+	}
+
+	bool write(size_t offset, const uint8_t* data, size_t size) override {
+		EXPECT_LE(offset + size, m_memory.size());
+		for (size_t i = 0; i < size; i++) {
+			if (m_isPowerLost) {
+				return false;
+			}
+			// every byte is programmed only once after erase
+			EXPECT_EQ(0xFF, m_memory[offset + i]) << "at " << offset + i;
+			m_memory[offset + i] &= data[i];
+			programmedBytes++;
+			if (programmedBytes == m_powerBudget) {
+				m_isPowerLost = true;
+			}
+		}
+		return true;
+	}
+
+	void read(size_t offset, uint8_t* data, size_t size) override {
+		EXPECT_LE(offset + size, m_memory.size());
+		memcpy(data, m_memory.data() + offset, size);
+	}
+
+	void losePowerAfter(size_t bytes) {
+		m_powerBudget = programmedBytes + bytes;
+	}
+
+	void losePower() {
+		m_isPowerLost = true;
+	}
+
+	void tearNextErase() {
+		m_tearNextErase = true;
+	}
+
+	void restorePower() {
+		m_isPowerLost = false;
+		m_tearNextErase = false;
+		m_powerBudget = 0;
+	}
+
+	bool isPowerLost() const {
+		return m_isPowerLost;
+	}
+
+	size_t eraseCount = 0;
+	size_t programmedBytes = 0;
+
+private:
+	std::vector<uint8_t> m_memory;
+	size_t m_powerBudget = 0;
+	bool m_tearNextErase = false;
+	bool m_isPowerLost = false;
+};
+
+#define IMAGE_SIZE 1000
+#define JOURNAL_SIZE 1024
+// image is padded to whole blocks
+#define REGION_SIZE (1024 + JOURNAL_SIZE)
+
+// stands for persistent_config_container_s, CRC at the end
+struct TestImage {
+	uint8_t data[IMAGE_SIZE];
+
+	void setByte(size_t index, uint8_t value) {
+		data[index] = value;
+		uint32_t crc = crc32(data, IMAGE_SIZE - sizeof(crc));
+		memcpy(data + IMAGE_SIZE - sizeof(crc), &crc, sizeof(crc));
+	}
+
+	bool isValid() const {
+		uint32_t crc;
+		memcpy(&crc, data + IMAGE_SIZE - sizeof(crc), sizeof(crc));
+		return crc == crc32(data, IMAGE_SIZE - sizeof(crc));
+	}
+
+	bool operator==(const TestImage& other) const {
+		return memcmp(data, other.data, IMAGE_SIZE) == 0;
+	}
+};
+
+static TestImage makeImage(uint8_t seed) {
+	TestImage image;
+	for (size_t i = 0; i < IMAGE_SIZE; i++) {
+		image.data[i] = i * 7 + seed;
+	}
+	image.setByte(0, seed);
+	return image;
+}
+
+static TestImage readAfterBoot(FlashEmulator& flash) {
+	FlashJournal journal(flash, IMAGE_SIZE, JOURNAL_SIZE);
+	TestImage image;
+	journal.read(image.data);
+	return image;
+}
+
+TEST(FlashJournal, firstWriteRewritesRegion) {
+	FlashEmulator flash(REGION_SIZE);
+	FlashJournal journal(flash, IMAGE_SIZE, JOURNAL_SIZE);
+	EXPECT_EQ(REGION_SIZE, journal.getRegionSize());
+
+	// blank flash
+	TestImage image;
+	journal.read(image.data);
+	EXPECT_FALSE(image.isValid());
+
+	TestImage tune = makeImage(1);
+	EXPECT_TRUE(journal.write(tune.data));
+	EXPECT_EQ(1, journal.getCompactionCount());
+	EXPECT_EQ(0, journal.getDeltaCount());
+	EXPECT_EQ(1, flash.eraseCount);
+
+	EXPECT_TRUE(readAfterBoot(flash) == tune);
+}
+
+TEST(FlashJournal, smallChangeIsAppended) {
+	FlashEmulator flash(REGION_SIZE);
+	FlashJournal journal(flash, IMAGE_SIZE, JOURNAL_SIZE);
+
+	TestImage tune = makeImage(1);
+	ASSERT_TRUE(journal.write(tune.data));
+	size_t programmedByCompaction = flash.programmedBytes;
+
+	tune.setByte(100, 0x55);
+	ASSERT_TRUE(journal.write(tune.data));
+	EXPECT_EQ(1, journal.getCompactionCount());
+	EXPECT_EQ(1, journal.getDeltaCount());
+	EXPECT_EQ(1, flash.eraseCount);
+	// record header and two chunks (changed byte and CRC) fit into a single block
+	EXPECT_EQ(FLASH_JOURNAL_BLOCK_SIZE, flash.programmedBytes - programmedByCompaction);
+	EXPECT_TRUE(readAfterBoot(flash) == tune);
+
+	// same image, nothing to write
+	size_t programmed = flash.programmedBytes;
+	ASSERT_TRUE(journal.write(tune.data));
+	EXPECT_EQ(programmed, flash.programmedBytes);
+	EXPECT_EQ(1, journal.getDeltaCount());
+
+	// back to what the base copy has, last delta is the only one applied
+	TestImage original = makeImage(1);
+	ASSERT_TRUE(journal.write(original.data));
+	EXPECT_EQ(2, journal.getDeltaCount());
+	EXPECT_TRUE(readAfterBoot(flash) == original);
+
+	// a journal which was never read picks up where the previous one has stopped
+	FlashJournal afterBoot(flash, IMAGE_SIZE, JOURNAL_SIZE);
+	tune.setByte(200, 0x66);
+	ASSERT_TRUE(afterBoot.write(tune.data));
+	EXPECT_EQ(0, afterBoot.getCompactionCount());
+	EXPECT_EQ(1, afterBoot.getDeltaCount());
+	EXPECT_EQ(journal.getJournalUsed() + FLASH_JOURNAL_BLOCK_SIZE, afterBoot.getJournalUsed());
+	EXPECT_TRUE(readAfterBoot(flash) == tune);
+}
+
+TEST(FlashJournal, fullJournalIsCompacted) {
+	FlashEmulator flash(REGION_SIZE);
+	FlashJournal journal(flash, IMAGE_SIZE, JOURNAL_SIZE);
+
+	TestImage tune = makeImage(1);
+	ASSERT_TRUE(journal.write(tune.data));
+
+	// deltas grow since each of them is relative to the base copy
+	for (int i = 0; i < 100; i++) {
+		tune.setByte(10 * i, i);
+		ASSERT_TRUE(journal.write(tune.data));
+		ASSERT_LE(journal.getJournalUsed(), JOURNAL_SIZE);
+		ASSERT_TRUE(readAfterBoot(flash) == tune) << i;
+	}
+	EXPECT_GT(journal.getCompactionCount(), 2);
+	EXPECT_EQ(journal.getCompactionCount(), flash.eraseCount);
+	EXPECT_GT(journal.getDeltaCount(), 50);
+}
+
+TEST(FlashJournal, unknownBaseIsRewritten) {
+	FlashEmulator flash(REGION_SIZE);
+
+	// copy written by firmware without journal: image only, rest of the sector erased
+	TestImage old = makeImage(3);
+	flash.write(0, old.data, IMAGE_SIZE);
+
+	FlashJournal journal(flash, IMAGE_SIZE, JOURNAL_SIZE);
+	TestImage image;
+	journal.read(image.data);
+	EXPECT_TRUE(image == old);
+
+	old.setByte(5, 5);
+	ASSERT_TRUE(journal.write(old.data));
+	EXPECT_EQ(1, journal.getCompactionCount());
+	EXPECT_TRUE(readAfterBoot(flash) == old);
+}
+
+TEST(FlashJournal, powerLossWhileAppending) {
+	TestImage before = makeImage(1);
+	before.setByte(100, 1);
+	TestImage after = before;
+	after.setByte(100, 2);
+	after.setByte(500, 2);
+	after.setByte(501, 2);
+	after.setByte(600, 2);
+	TestImage next = after;
+	next.setByte(700, 3);
+
+	for (size_t budget = 1; budget < 4 * FLASH_JOURNAL_BLOCK_SIZE; budget++) {
+		FlashEmulator flash(REGION_SIZE);
+		bool isTorn;
+		{
+			FlashJournal journal(flash, IMAGE_SIZE, JOURNAL_SIZE);
+			ASSERT_TRUE(journal.write(makeImage(1).data));
+			ASSERT_TRUE(journal.write(before.data));
+
+			flash.losePowerAfter(budget);
+			isTorn = !journal.write(after.data);
+		}
+		flash.restorePower();
+
+		FlashJournal journal(flash, IMAGE_SIZE, JOURNAL_SIZE);
+		TestImage image;
+		journal.read(image.data);
+		if (isTorn) {
+			// torn in the padding after a complete payload is as good as not torn
+			ASSERT_TRUE(image == before || image == after) << budget;
+		} else {
+			ASSERT_TRUE(image == after) << budget;
+		}
+		bool isRecordLost = image == before;
+
+		ASSERT_TRUE(journal.write(next.data));
+		// nothing is appended after a torn record
+		ASSERT_EQ(isRecordLost ? 1 : 0, journal.getCompactionCount()) << budget;
+		ASSERT_TRUE(readAfterBoot(flash) == next) << budget;
+	}
+}
+
+/**
+ * Same as flash_main.cpp: two copies each with its own journal, first valid copy wins
+ */
+TEST(FlashJournal, powerLossWithTwoCopies) {
+	TestImage before = makeImage(1);
+	before.setByte(100, 1);
+	// every byte has changed, both copies get rewritten
+	TestImage after = makeImage(2);
+
+	size_t burnSize = 0;
+	for (size_t budget = 1; budget == 1 || budget <= burnSize; budget++) {
+		FlashEmulator first(REGION_SIZE);
+		FlashEmulator second(REGION_SIZE);
+		{
+			FlashJournal firstJournal(first, IMAGE_SIZE, JOURNAL_SIZE);
+			FlashJournal secondJournal(second, IMAGE_SIZE, JOURNAL_SIZE);
+			ASSERT_TRUE(firstJournal.write(makeImage(1).data));
+			ASSERT_TRUE(secondJournal.write(makeImage(1).data));
+			ASSERT_TRUE(firstJournal.write(before.data));
+			ASSERT_TRUE(secondJournal.write(before.data));
+
+			size_t programmed = first.programmedBytes + second.programmedBytes;
+			if (burnSize) {
+				first.losePowerAfter(budget);
+			}
+			firstJournal.write(after.data);
+			if (first.isPowerLost()) {
+				second.losePower();
+			} else if (burnSize) {
+				second.losePowerAfter(budget - (first.programmedBytes + second.programmedBytes - programmed));
+			}
+			secondJournal.write(after.data);
+
+			if (!burnSize) {
+				// first pass only measures the burn
+				burnSize = first.programmedBytes + second.programmedBytes - programmed;
+				ASSERT_GT(burnSize, 2 * IMAGE_SIZE);
+				continue;
+			}
+		}
+		first.restorePower();
+		second.restorePower();
+
+		TestImage image = readAfterBoot(first);
+		if (!image.isValid()) {
+			image = readAfterBoot(second);
+		}
+		ASSERT_TRUE(image == before || image == after) << budget;
+		if (budget == burnSize) {
+			ASSERT_TRUE(image == after);
+		}
+	}
+}
+
+TEST(FlashJournal, powerLossWhileErasing) {
+	FlashEmulator flash(REGION_SIZE);
+	TestImage tune = makeImage(1);
+	{
+		FlashJournal journal(flash, IMAGE_SIZE, JOURNAL_SIZE);
+		ASSERT_TRUE(journal.write(tune.data));
+		journal.invalidate();
+		flash.tearNextErase();
+		EXPECT_FALSE(journal.write(makeImage(2).data));
+	}
+	flash.restorePower();
+
+	FlashJournal journal(flash, IMAGE_SIZE, JOURNAL_SIZE);
+	TestImage image;
+	journal.read(image.data);
+	EXPECT_FALSE(image.isValid());
+
+	ASSERT_TRUE(journal.write(tune.data));
+	EXPECT_EQ(1, journal.getCompactionCount());
+	EXPECT_TRUE(readAfterBoot(flash) == tune);
+}
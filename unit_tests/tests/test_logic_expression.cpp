@@ -13,6 +13,8 @@
 #include "thermistors.h"
 #include "allsensors.h"
 
+#include <chrono>
+
 #define TEST_POOL_SIZE 256
 
 FsioResult getEngineValue(le_action_e action DECLARE_ENGINE_PARAMETER_SUFFIX) {
@@ -36,6 +38,7 @@ FsioResult getEngineValue(le_action_e action DECLARE_ENGINE_PARAMETER_SUFFIX) {
 	case LE_METHOD_AC_TOGGLE:
 		return getAcToggle(PASS_ENGINE_PARAMETER_SIGNATURE);
 	case LE_METHOD_IS_COOLANT_BROKEN:
+	case LE_METHOD_IN_MR_BENCH:
 		return 0;
 #include "fsio_getters.def"
 	default:
@@ -118,6 +121,10 @@ static void testExpression2(float selfValue, const char *line, float expected, E
 	EXPAND_Engine;
 
 	ASSERT_NEAR(expected, c.evaluate("test", selfValue, element PASS_ENGINE_PARAMETER_SUFFIX), EPS4D) << line;
+
+	FsioProgram program = pool.compile(element);
+	ASSERT_TRUE(program.isValid()) << line;
+	ASSERT_NEAR(expected, program.evaluate(selfValue PASS_ENGINE_PARAMETER_SUFFIX), EPS4D) << "compiled " << line;
 }
 
 static void testExpression2(float selfValue, const char *line, float expected, const std::unordered_map<SensorType, float>& sensorVals = {}) {
@@ -259,6 +266,199 @@ TEST(fsio, testLogicExpressions) {
 	}
 }
 
+TEST(fsio, compileFoldsConstants) {
+	LEElement thepool[TEST_POOL_SIZE];
+	LEElementPool pool(thepool, TEST_POOL_SIZE);
+
+	LEElement *element = pool.parseExpression("1 3 AND not");
+	int parsedSize = pool.getSize();
+	FsioProgram program = pool.compile(element);
+	ASSERT_TRUE(program.isValid());
+
+	// parsed expression is intact
+	ASSERT_EQ(element[2].action, LE_OPERATOR_AND);
+	ASSERT_EQ(element[4].action, LE_METHOD_RETURN);
+
+	const LEElement *code = program.getCode();
+	ASSERT_EQ(code[0].action, LE_NUMERIC_VALUE);
+	ASSERT_EQ(code[0].fValue, 0);
+	ASSERT_EQ(code[1].action, LE_METHOD_RETURN);
+	ASSERT_EQ(pool.getSize(), parsedSize + 2);
+
+	// only the constant part is folded
+	program = pool.compile(pool.parseExpression("rpm 2 3 * 100 * >"));
+	ASSERT_TRUE(program.isValid());
+	code = program.getCode();
+	ASSERT_EQ(code[0].action, LE_METHOD_RPM);
+	ASSERT_EQ(code[1].action, LE_NUMERIC_VALUE);
+	ASSERT_EQ(code[1].fValue, 600);
+	ASSERT_EQ(code[2].action, LE_OPERATOR_MORE);
+	ASSERT_EQ(code[3].action, LE_METHOD_RETURN);
+
+	program = pool.compile(pool.parseExpression("true 22 33 if"));
+	ASSERT_EQ(program.getCode()[0].fValue, 22);
+}
+
+TEST(fsio, compileResolvesSettingsAndTables) {
+	WITH_ENGINE_TEST_HELPER(FORD_INLINE_6_1995);
+	LEElement thepool[TEST_POOL_SIZE];
+	LEElementPool pool(thepool, TEST_POOL_SIZE);
+
+	CONFIG(fsio_setting)[1] = 42;
+
+	FsioProgram program = pool.compile(pool.parseExpression("1 1 + fsio_setting"));
+	ASSERT_TRUE(program.isValid());
+	ASSERT_EQ(program.getCode()[0].action, LE_COMPILED_FSIO_SETTING);
+	ASSERT_EQ(program.getCode()[0].fValue, 1);
+	ASSERT_EQ(program.getCode()[1].action, LE_METHOD_RETURN);
+	ASSERT_EQ(42, program.evaluate(0 PASS_ENGINE_PARAMETER_SUFFIX));
+
+	// settings are read at runtime, not folded
+	CONFIG(fsio_setting)[1] = 43;
+	ASSERT_EQ(43, program.evaluate(0 PASS_ENGINE_PARAMETER_SUFFIX));
+
+	program = pool.compile(pool.parseExpression("rpm 30 2 fsio_table"));
+	ASSERT_TRUE(program.isValid());
+	ASSERT_EQ(program.getCode()[2].action, LE_COMPILED_FSIO_TABLE);
+	ASSERT_EQ(program.getCode()[2].fValue, 1);
+
+	// index only known at runtime
+	program = pool.compile(pool.parseExpression("self fsio_setting"));
+	ASSERT_TRUE(program.isValid());
+	ASSERT_EQ(program.getCode()[1].action, LE_METHOD_FSIO_SETTING);
+	ASSERT_EQ(43, program.evaluate(2 PASS_ENGINE_PARAMETER_SUFFIX));
+	float outOfRange = program.evaluate(200 PASS_ENGINE_PARAMETER_SUFFIX);
+	ASSERT_TRUE(cisnan(outOfRange));
+}
+
+TEST(fsio, compileRejectsInvalidExpressions) {
+	LEElement thepool[TEST_POOL_SIZE];
+	LEElementPool pool(thepool, TEST_POOL_SIZE);
+
+	ASSERT_FALSE(pool.compile(nullptr).isValid());
+
+	int size = pool.getSize();
+	// stack underflow
+	ASSERT_FALSE(pool.compile(pool.parseExpression("1 +")).isValid());
+	// more than one value left
+	ASSERT_FALSE(pool.compile(pool.parseExpression("1 2")).isValid());
+	ASSERT_FALSE(pool.compile(pool.parseExpression("")).isValid());
+	// constant index out of range
+	ASSERT_FALSE(pool.compile(pool.parseExpression("17 fsio_setting")).isValid());
+	ASSERT_FALSE(pool.compile(pool.parseExpression("1 2 5 fsio_table")).isValid());
+	// nothing was allocated for failed programs
+	ASSERT_EQ(pool.getSize(), size + 3 + 3 + 1 + 3 + 5);
+
+	// stack depth
+	std::string deep;
+	for (int i = 0; i < MAX_STACK_DEPTH + 1; i++) {
+		deep += "rpm ";
+	}
+	for (int i = 0; i < MAX_STACK_DEPTH; i++) {
+		deep += "+ ";
+	}
+	ASSERT_FALSE(pool.compile(pool.parseExpression(deep.c_str())).isValid());
+
+	// no room left for compiled code
+	LEElement smallArr[4];
+	LEElementPool small(smallArr, 4);
+	ASSERT_FALSE(small.compile(small.parseExpression("1 2 +")).isValid());
+}
+
+extern LEElementPool userPool;
+extern LEElementPool userCodePool;
+
+TEST(fsio, formulasFillingWholePool) {
+	WITH_ENGINE_TEST_HELPER(FORD_INLINE_6_1995);
+
+	// 7 tokens and the return statement, all formulas together take all 128 elements of the pool
+	for (int i = 0; i < FSIO_COMMAND_COUNT; i++) {
+		setFsio(i, GPIO_UNASSIGNED, "rpm 1 + 2 + 3 +" PASS_CONFIG_PARAMETER_SUFFIX);
+	}
+	applyFsioConfiguration(PASS_ENGINE_PARAMETER_SIGNATURE);
+	ASSERT_EQ(128, userPool.getSize());
+	// compiled programs do not take any of that room, nothing is folded here
+	ASSERT_EQ(128, userCodePool.getSize());
+
+	engine->fsioState.mockRpm = 1000;
+	for (int i = 0; i < FSIO_COMMAND_COUNT; i++) {
+		ASSERT_EQ(1006, getFsioOutputValue(i PASS_ENGINE_PARAMETER_SUFFIX)) << i;
+	}
+
+	// one element too many
+	LEElement smallArr[3];
+	LEElementPool small(smallArr, 3);
+	ASSERT_EQ(nullptr, small.parseExpression("1 2 +"));
+	ASSERT_EQ(0, small.getSize());
+}
+
+static const char * const systemLogic[] = {
+	FUEL_PUMP_LOGIC,
+	MAIN_RELAY_LOGIC,
+	STARTER_RELAY_LOGIC,
+};
+
+static void setSystemLogicInputs(int i DECLARE_ENGINE_PARAMETER_SUFFIX) {
+	engine->fsioState.mockTimeSinceBoot = (i % 7) * 0.5f;
+	engine->fsioState.mockTimeSinceTrigger = (i % 3) * 0.6f;
+	engine->fsioState.mockRpm = (i % 11) * 100;
+	engine->fsioState.mockCrankingRpm = 550;
+}
+
+TEST(fsio, compiledSystemLogic) {
+	WITH_ENGINE_TEST_HELPER(FORD_INLINE_6_1995);
+	LEElement thepool[TEST_POOL_SIZE];
+	LEElementPool pool(thepool, TEST_POOL_SIZE);
+	LECalculator c;
+
+	for (const char *line : systemLogic) {
+		LEElement *element = pool.parseExpression(line);
+		FsioProgram program = pool.compile(element);
+		ASSERT_TRUE(program.isValid()) << line;
+
+		for (int i = 0; i < 100; i++) {
+			setSystemLogicInputs(i PASS_ENGINE_PARAMETER_SUFFIX);
+			ASSERT_EQ(c.evaluate("test", 0, element PASS_ENGINE_PARAMETER_SUFFIX),
+					program.evaluate(0 PASS_ENGINE_PARAMETER_SUFFIX)) << line << " " << i;
+		}
+	}
+}
+
+// run via 'make benchmark'
+TEST(fsioBenchmark, DISABLED_systemLogic) {
+	WITH_ENGINE_TEST_HELPER(FORD_INLINE_6_1995);
+	LEElement thepool[TEST_POOL_SIZE];
+	LEElementPool pool(thepool, TEST_POOL_SIZE);
+	LECalculator c;
+
+	const int iterations = 1000000;
+	for (const char *line : systemLogic) {
+		LEElement *element = pool.parseExpression(line);
+		FsioProgram program = pool.compile(element);
+
+		// accumulated so that nothing is optimized away
+		float legacySum = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < iterations; i++) {
+			setSystemLogicInputs(i PASS_ENGINE_PARAMETER_SUFFIX);
+			legacySum += c.evaluate("test", 0, element PASS_ENGINE_PARAMETER_SUFFIX);
+		}
+		auto legacyNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+		float compiledSum = 0;
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < iterations; i++) {
+			setSystemLogicInputs(i PASS_ENGINE_PARAMETER_SUFFIX);
+			compiledSum += program.evaluate(0 PASS_ENGINE_PARAMETER_SUFFIX);
+		}
+		auto compiledNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+		EXPECT_EQ(legacySum, compiledSum);
+		printf("[%s] LECalculator %.1fns FsioProgram %.1fns per evaluation\n", line,
+				(double)legacyNs / iterations, (double)compiledNs / iterations);
+	}
+}
+
 TEST(fsio, fuelPump) {
 	// this will init fuel pump fsio logic
 	WITH_ENGINE_TEST_HELPER(TEST_ENGINE);
@@ -0,0 +1,48 @@
+/*
+ * @file test_map_averaging.cpp
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#include "engine_test_helper.h"
+#include "map_averaging.h"
+
+TEST(misc, mapAveragingWindowsAnchoredToTeeth) {
+	WITH_ENGINE_TEST_HELPER(TEST_ENGINE);
+
+	engine->needTdcCallback = false;
+
+	setupSimpleTestEngineWithMafAndTT_ONE_trigger(&eth, IM_SEQUENTIAL);
+	engineConfiguration->isInjectionEnabled = false;
+
+	eth.fireTriggerEvents2(2 /* count */ , 600 /* ms */);
+	ASSERT_EQ( 100,  GET_RPM()) << "spinning-RPM#1";
+
+	engine->periodicFastCallback(PASS_ENGINE_PARAMETER_SIGNATURE);
+
+	// end is precalculated per cylinder, engine cycle angles
+	ASSERT_NEAR(100, ENGINE(engineState.mapAveragingStart[0]), EPS4D);
+	ASSERT_NEAR(150, ENGINE(engineState.mapAveragingEnd[0]), EPS4D);
+	ASSERT_NEAR(640, ENGINE(engineState.mapAveragingStart[3]), EPS4D);
+	ASSERT_NEAR(690, ENGINE(engineState.mapAveragingEnd[3]), EPS4D);
+
+	ASSERT_EQ(0, CONFIG(mapAveragingSchedulingAtIndex));
+	// only the tooth configured as mapAveragingSchedulingAtIndex does anything
+	mapAveragingTriggerCallback(1, getTimeNowNt() PASS_ENGINE_PARAMETER_SUFFIX);
+	ASSERT_EQ(0, engine->angleBasedEvents.size());
+
+	mapAveragingTriggerCallback(CONFIG(mapAveragingSchedulingAtIndex), getTimeNowNt() PASS_ENGINE_PARAMETER_SUFFIX);
+
+	// two windows start after the second tooth, these wait for it
+	ASSERT_EQ(2, engine->angleBasedEvents.size());
+	for (int i = 0; i < 2; i++) {
+		AngleBasedEvent *window = engine->angleBasedEvents.getElementAtIndexForUnitText(i);
+		ASSERT_EQ(1, window->position.triggerEventIndex);
+		ASSERT_NEAR(100 + 180 * i, window->position.angleOffsetFromTriggerEvent, EPS4D);
+	}
+
+	// still pending windows are not queued twice
+	mapAveragingTriggerCallback(CONFIG(mapAveragingSchedulingAtIndex), getTimeNowNt() PASS_ENGINE_PARAMETER_SUFFIX);
+	ASSERT_EQ(2, engine->angleBasedEvents.size());
+}
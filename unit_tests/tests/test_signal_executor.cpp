@@ -156,3 +156,54 @@ TEST(misc, testSignalExecutor) {
 
 	ASSERT_EQ(2, callbackCounter);
 }
+
+TEST(misc, testSignalExecutorCancel) {
+	EventQueue eq;
+	scheduling_s s1;
+	scheduling_s s2;
+	scheduling_s s3;
+
+	eq.insertTask(&s1, 10, { orderCallback, (void*)10 });
+	eq.insertTask(&s2, 11, { orderCallback, (void*)11 });
+	eq.insertTask(&s3, 12, { orderCallback, (void*)12 });
+
+	// middle, head and then a not pending element
+	ASSERT_TRUE(eq.cancel(&s2));
+	ASSERT_EQ(2, eq.size());
+	ASSERT_TRUE(eq.cancel(&s1));
+	ASSERT_EQ(1, eq.size());
+	ASSERT_EQ(&s3, eq.getHead());
+	ASSERT_FALSE(eq.cancel(&s1));
+
+	// cancelled element could be scheduled again, at a different time
+	eq.insertTask(&s1, 13, { orderCallback, (void*)13 });
+	ASSERT_EQ(12, eq.getNextEventTime(0).value_or(-1));
+
+	prevValue = -1;
+	eq.executeAll(100);
+	ASSERT_EQ(13, prevValue);
+	ASSERT_EQ(0, eq.size());
+}
+
+TEST(misc, testExecutorReschedule) {
+	TestExecutor executor;
+	scheduling_s s1;
+
+	callbackCounter = 0;
+	executor.scheduleByTimestamp(&s1, 10, callback);
+	// plain schedule does not move pending event
+	executor.scheduleByTimestamp(&s1, 20, callback);
+	ASSERT_EQ(10, executor.getHead()->momentX);
+
+	executor.rescheduleByTimestampNt(&s1, US2NT(20), callback);
+	ASSERT_EQ(1, executor.size());
+	ASSERT_EQ(20, executor.getHead()->momentX);
+
+	executor.executeAll(15);
+	ASSERT_EQ(0, callbackCounter);
+
+	executor.cancel(&s1);
+	ASSERT_EQ(0, executor.size());
+	executor.executeAll(100);
+	ASSERT_EQ(0, callbackCounter);
+}
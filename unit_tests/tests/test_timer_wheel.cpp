@@ -0,0 +1,258 @@
+/**
+ * @file	test_timer_wheel.cpp
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2020
+ */
+
+#include "global.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "event_queue.h"
+#include "timer_wheel.h"
+#include "unit_test_framework.h"
+
+extern int timeNowUs;
+
+static int callbackCounter = 0;
+
+static void callback(void *) {
+	callbackCounter++;
+}
+
+static std::vector<long> executionOrder;
+
+static void orderCallback(void *arg) {
+	executionOrder.push_back((long)arg);
+}
+
+TEST(timerWheel, basic) {
+	TimerWheel wheel;
+	ASSERT_EQ(wheel.getNextEventTime(0), unexpected);
+
+	scheduling_s s1;
+	scheduling_s s2;
+	scheduling_s s3;
+	scheduling_s s4;
+
+	ASSERT_TRUE(wheel.insertTask(&s1, 10, callback));
+	ASSERT_FALSE(wheel.insertTask(&s4, 10, callback));
+	ASSERT_FALSE(wheel.insertTask(&s3, 12, callback));
+	ASSERT_FALSE(wheel.insertTask(&s2, 11, callback));
+	// already scheduled
+	ASSERT_FALSE(wheel.insertTask(&s2, 1, callback));
+
+	ASSERT_EQ(4, wheel.size());
+	ASSERT_EQ(&s1, wheel.getHead());
+	ASSERT_EQ(10, wheel.getNextEventTime(0).value_or(-1));
+
+	callbackCounter = 0;
+	wheel.executeAll(10);
+	ASSERT_EQ(2, callbackCounter);
+	ASSERT_EQ(11, wheel.getNextEventTime(0).value_or(-1));
+
+	callbackCounter = 0;
+	wheel.executeAll(11);
+	ASSERT_EQ(1, callbackCounter);
+	wheel.executeAll(100);
+	ASSERT_EQ(0, wheel.size());
+	ASSERT_EQ(wheel.getNextEventTime(0), unexpected);
+}
+
+TEST(timerWheel, orderAcrossLevels) {
+	// 1 unit per slot so that these timestamps hit near, far and overflow levels
+	TimerWheel wheel(0, 0);
+
+	scheduling_s s[6];
+	long times[] = { 5000, 3, 40, 31, 100000, 1100 };
+	for (int i = 0; i < 6; i++) {
+		wheel.insertTask(&s[i], times[i], { orderCallback, (void*)times[i] });
+	}
+	ASSERT_EQ(6, wheel.size());
+	ASSERT_EQ(3, wheel.getNextEventTime(0).value_or(-1));
+
+	executionOrder.clear();
+	wheel.executeAll(35);
+	ASSERT_EQ(2, executionOrder.size());
+	ASSERT_EQ(40, wheel.getNextEventTime(35).value_or(-1));
+
+	wheel.executeAll(200000);
+	std::vector<long> expected = { 3, 31, 40, 1100, 5000, 100000 };
+	ASSERT_EQ(expected, executionOrder);
+	ASSERT_EQ(0, wheel.size());
+}
+
+TEST(timerWheel, lateInsertIsExecutedFirst) {
+	TimerWheel wheel(0, 2);
+
+	scheduling_s s1;
+	scheduling_s s2;
+	wheel.insertTask(&s1, 1000, { orderCallback, (void*)1000 });
+	// move cursor forward
+	wheel.executeAll(900);
+	ASSERT_EQ(1, wheel.size());
+
+	// this one is in the past as far as the wheel is concerned
+	ASSERT_TRUE(wheel.insertTask(&s2, 100, { orderCallback, (void*)100 }));
+	ASSERT_EQ(&s2, wheel.getHead());
+
+	executionOrder.clear();
+	wheel.executeAll(2000);
+	std::vector<long> expected = { 100, 1000 };
+	ASSERT_EQ(expected, executionOrder);
+}
+
+TEST(timerWheel, cancel) {
+	TimerWheel wheel(0, 0);
+
+	scheduling_s near1;
+	scheduling_s near2;
+	scheduling_s far;
+	scheduling_s overflow;
+	wheel.insertTask(&near1, 5, { orderCallback, (void*)5 });
+	wheel.insertTask(&near2, 6, { orderCallback, (void*)6 });
+	wheel.insertTask(&far, 500, { orderCallback, (void*)500 });
+	wheel.insertTask(&overflow, 50000, { orderCallback, (void*)50000 });
+
+	ASSERT_TRUE(wheel.cancel(&near1));
+	ASSERT_EQ(&near2, wheel.getHead());
+	ASSERT_TRUE(wheel.cancel(&near2));
+	// slot is empty now, next one is in the far level
+	ASSERT_EQ(&far, wheel.getHead());
+	ASSERT_TRUE(wheel.cancel(&overflow));
+	ASSERT_FALSE(wheel.cancel(&overflow));
+	ASSERT_EQ(1, wheel.size());
+
+	// moving to a different level
+	wheel.insertTask(&overflow, 7, { orderCallback, (void*)7 });
+	ASSERT_EQ(&overflow, wheel.getHead());
+
+	executionOrder.clear();
+	wheel.executeAll(100000);
+	std::vector<long> expected = { 7, 500 };
+	ASSERT_EQ(expected, executionOrder);
+}
+
+TEST(timerWheel, clear) {
+	TimerWheel wheel(0, 0);
+
+	scheduling_s s1;
+	scheduling_s s2;
+	wheel.insertTask(&s1, 10, callback);
+	wheel.insertTask(&s2, 100000, callback);
+	wheel.clear();
+
+	ASSERT_EQ(0, wheel.size());
+	ASSERT_EQ(wheel.getNextEventTime(0), unexpected);
+	ASSERT_FALSE(s1.action);
+	ASSERT_FALSE(s2.action);
+
+	// elements are reusable after clear
+	callbackCounter = 0;
+	wheel.insertTask(&s1, 20, callback);
+	wheel.executeAll(20);
+	ASSERT_EQ(1, callbackCounter);
+}
+
+/**
+ * Synthetic engine load: on each tooth every cylinder which is due arms dwell, spark, trailing spark,
+ * injector open and injector close events. Same load is applied to the sorted list and to the wheel,
+ * execution order is compared and worst-case insert and execute times are printed.
+ */
+
+#define BENCH_EVENTS_PER_CYLINDER 5
+#define BENCH_MAX_CYLINDERS 16
+#define BENCH_TEETH_PER_CYCLE 120
+#define BENCH_CYCLES 40
+// 720 degrees at 6000 rpm
+#define BENCH_CYCLE_US 20000
+
+struct BenchResult {
+	std::vector<efitime_t> executed;
+	long maxInsertNs = 0;
+	long totalInsertNs = 0;
+	int insertCount = 0;
+	long maxExecuteNs = 0;
+	long totalExecuteNs = 0;
+	int executeToothCount = 0;
+};
+
+static BenchResult *currentBench;
+static scheduling_s benchEvents[BENCH_MAX_CYLINDERS][BENCH_EVENTS_PER_CYLINDER];
+
+static void benchCallback(scheduling_s *s) {
+	currentBench->executed.push_back((efitime_t)s->momentX);
+}
+
+static long nanosSince(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<typename TQueue>
+static BenchResult runEngineBench(int cylindersCount) {
+	TQueue queue;
+	BenchResult result;
+	currentBench = &result;
+
+	int toothUs = BENCH_CYCLE_US / BENCH_TEETH_PER_CYCLE;
+	int teethPerCylinder = BENCH_TEETH_PER_CYCLE / cylindersCount;
+	// events are armed about one cylinder ahead, with distinct offsets so order is well defined
+	int offsetsUs[BENCH_EVENTS_PER_CYLINDER] = { 1, 3000, 3003, 3500, 6007 };
+
+	for (int tooth = 0; tooth < BENCH_CYCLES * BENCH_TEETH_PER_CYCLE; tooth++) {
+		efitime_t now = tooth * toothUs;
+		timeNowUs = now;
+
+		auto start = std::chrono::steady_clock::now();
+		queue.executeAll(now);
+		long executeNs = nanosSince(start);
+		result.maxExecuteNs = std::max(result.maxExecuteNs, executeNs);
+		result.totalExecuteNs += executeNs;
+		result.executeToothCount++;
+
+		if (tooth % teethPerCylinder != 0) {
+			continue;
+		}
+		int cylinderIndex = (tooth / teethPerCylinder) % cylindersCount;
+		for (int i = 0; i < BENCH_EVENTS_PER_CYLINDER; i++) {
+			scheduling_s *s = &benchEvents[cylinderIndex][i];
+			efitime_t eventTime = now + offsetsUs[i] + cylinderIndex;
+
+			start = std::chrono::steady_clock::now();
+			queue.insertTask(s, eventTime, { benchCallback, s });
+			long insertNs = nanosSince(start);
+			result.maxInsertNs = std::max(result.maxInsertNs, insertNs);
+			result.totalInsertNs += insertNs;
+			result.insertCount++;
+		}
+	}
+	timeNowUs = BENCH_CYCLES * BENCH_CYCLE_US * 2;
+	queue.executeAll(timeNowUs);
+	timeNowUs = 0;
+	return result;
+}
+
+static void printBench(const char *name, int cylindersCount, const BenchResult& r) {
+	printf("BENCH %s cyl=%d inserts=%d avgInsertNs=%ld maxInsertNs=%ld avgExecuteNs=%ld maxExecuteNs=%ld\r\n",
+			name, cylindersCount, r.insertCount,
+			r.totalInsertNs / r.insertCount, r.maxInsertNs,
+			r.totalExecuteNs / r.executeToothCount, r.maxExecuteNs);
+}
+
+TEST(timerWheel, benchmarkVsSortedList) {
+	for (int cylindersCount : { 8, 12, 16 }) {
+		BenchResult list = runEngineBench<EventQueue>(cylindersCount);
+		BenchResult wheel = runEngineBench<TimerWheel>(cylindersCount);
+
+		// please note that EventQueue validates whole list on each operation in unit tests
+		printBench("list", cylindersCount, list);
+		printBench("wheel", cylindersCount, wheel);
+
+		ASSERT_EQ(list.insertCount, wheel.insertCount);
+		ASSERT_EQ(list.executed.size(), wheel.executed.size());
+		ASSERT_EQ(list.executed, wheel.executed);
+	}
+}
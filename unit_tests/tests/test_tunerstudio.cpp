@@ -1,5 +1,6 @@
 #include "engine_test_helper.h"
 #include "tunerstudio_io.h"
+#include "ts_output_delta.h"
 
 static uint8_t st5TestBuffer[16000];
 
@@ -63,3 +64,140 @@ TEST(binary, testWriteCrc) {
 	test.writeCrcPacket(CODE, (const uint8_t*)PAYLOAD, SIZE);
 	assertCrcPacket(test);
 }
+
+/**
+ * Reference decoder, same as OutputChannelsDelta.java
+ */
+static bool applyOutputDelta(uint8_t* image, size_t size, const uint8_t* payload, size_t payloadSize) {
+	if (payload[0] & TS_OUTPUT_DELTA_KEYFRAME) {
+		if (payloadSize != TS_OUTPUT_DELTA_HEADER_SIZE + size) {
+			return false;
+		}
+		memcpy(image, payload + TS_OUTPUT_DELTA_HEADER_SIZE, size);
+		return true;
+	}
+	size_t position = TS_OUTPUT_DELTA_HEADER_SIZE;
+	size_t index = 0;
+	while (position < payloadSize) {
+		index += payload[position++];
+		size_t length = payload[position++];
+		if (index + length > size) {
+			return false;
+		}
+		memcpy(image + index, payload + position, length);
+		position += length;
+		index += length;
+	}
+	return true;
+}
+
+TEST(binary, outputDeltaEncoding) {
+	uint8_t previous[600] = { 0 };
+	uint8_t current[600] = { 0 };
+	uint8_t out[700];
+
+	// nothing changed - nothing to send
+	ASSERT_EQ(0, encodeOutputDelta(previous, current, sizeof(current), out, sizeof(out)));
+
+	current[3] = 1;
+	// single unchanged byte between changes goes inline
+	current[5] = 2;
+	current[6] = 3;
+	// gap of two starts a new run
+	current[9] = 4;
+	ASSERT_EQ(2 + 4 + 2 + 1, encodeOutputDelta(previous, current, sizeof(current), out, sizeof(out)));
+	uint8_t expected[] = { 3, 4, 1, 0, 2, 3, 2, 1, 4 };
+	ASSERT_EQ(0, memcmp(expected, out, sizeof(expected)));
+
+	// unchanged stretch longer than one run header can skip
+	current[500] = 5;
+	int size = encodeOutputDelta(previous, current, sizeof(current), out, sizeof(out));
+	ASSERT_EQ((int)sizeof(expected) + 2 + 2 + 1, size);
+
+	uint8_t image[600] = { 0 };
+	uint8_t payload[702] = { 0, 1 };
+	memcpy(payload + TS_OUTPUT_DELTA_HEADER_SIZE, out, size);
+	ASSERT_TRUE(applyOutputDelta(image, sizeof(image), payload, TS_OUTPUT_DELTA_HEADER_SIZE + size));
+	ASSERT_EQ(0, memcmp(image, current, sizeof(current)));
+
+	// does not fit
+	ASSERT_EQ(-1, encodeOutputDelta(previous, current, sizeof(current), out, 10));
+}
+
+TEST(binary, outputDeltaStream) {
+	static TsOutputDelta dut;
+	const int size = 200;
+	uint8_t current[size] = { 0 };
+	uint8_t image[size];
+
+	// first frame is always a keyframe
+	size_t payloadSize = dut.update(current, 0, size, 0);
+	const uint8_t* payload = dut.getResponse();
+	ASSERT_EQ((size_t)TS_OUTPUT_DELTA_HEADER_SIZE + size, payloadSize);
+	ASSERT_EQ(TS_OUTPUT_DELTA_KEYFRAME, payload[0]);
+	ASSERT_TRUE(applyOutputDelta(image, size, payload, payloadSize));
+	uint8_t sequence = payload[1];
+
+	int totalBytes = 0;
+	for (int frame = 0; frame < 50; frame++) {
+		// a few gauges move
+		current[10] = frame;
+		current[40 + frame % 4]++;
+		current[150] = frame * 3;
+
+		payloadSize = dut.update(current, 0, size, sequence);
+		payload = dut.getResponse();
+		ASSERT_EQ(0, payload[0]) << "frame " << frame;
+		ASSERT_EQ((uint8_t)(sequence + 1), payload[1]);
+		sequence = payload[1];
+		ASSERT_TRUE(applyOutputDelta(image, size, payload, payloadSize));
+		ASSERT_EQ(0, memcmp(image, current, size)) << "frame " << frame;
+		totalBytes += payloadSize;
+	}
+	// several times less than full frames
+	ASSERT_LT(totalBytes * 10, 50 * size);
+
+	// client has lost a frame
+	payloadSize = dut.update(current, 0, size, sequence - 1);
+	ASSERT_EQ(TS_OUTPUT_DELTA_KEYFRAME, dut.getResponse()[0]);
+	sequence = dut.getResponse()[1];
+
+	// different range
+	dut.update(current, 0, size - 1, sequence);
+	ASSERT_EQ(TS_OUTPUT_DELTA_KEYFRAME, dut.getResponse()[0]);
+	sequence = dut.getResponse()[1];
+
+	// periodic keyframe
+	int keyframes = 0;
+	for (int frame = 0; frame < TS_OUTPUT_DELTA_KEYFRAME_PERIOD + 1; frame++) {
+		dut.update(current, 0, size - 1, sequence);
+		sequence = dut.getResponse()[1];
+		keyframes += dut.getResponse()[0] & TS_OUTPUT_DELTA_KEYFRAME;
+	}
+	ASSERT_EQ(1, keyframes);
+}
+
+TEST(binary, outputDeltaPerChannel) {
+	static MockTsChannel usb;
+	static MockTsChannel bluetooth;
+	const int size = 100;
+	uint8_t current[size] = { 0 };
+
+	usb.outputDelta.update(current, 0, size, 0);
+	uint8_t usbSequence = usb.outputDelta.getResponse()[1];
+	bluetooth.outputDelta.update(current, 0, size, 0);
+	uint8_t bluetoothSequence = bluetooth.outputDelta.getResponse()[1];
+
+	// clients polling in turns do not force keyframes on each other
+	for (int frame = 0; frame < 5; frame++) {
+		current[5] = frame;
+
+		usb.outputDelta.update(current, 0, size, usbSequence);
+		ASSERT_EQ(0, usb.outputDelta.getResponse()[0]) << "frame " << frame;
+		usbSequence = usb.outputDelta.getResponse()[1];
+
+		bluetooth.outputDelta.update(current, 0, size, bluetoothSequence);
+		ASSERT_EQ(0, bluetooth.outputDelta.getResponse()[0]) << "frame " << frame;
+		bluetoothSequence = bluetooth.outputDelta.getResponse()[1];
+	}
+}
@@ -10,6 +10,7 @@
 #include "cyclic_buffer.h"
 #include "global.h"
 #include "histogram.h"
+#include "perf_stats.h"
 
 #include "malfunction_central.h"
 #include "cli_registry.h"
@@ -139,6 +140,51 @@ TEST(util, histogram) {
 	ASSERT_EQ(1011, result[4]);
 }
 
+TEST(util, perfStats) {
+	ASSERT_EQ(0, perfStatsGetBucketIndex(0));
+	ASSERT_EQ(0, perfStatsGetBucketIndex(31));
+	ASSERT_EQ(1, perfStatsGetBucketIndex(32));
+	ASSERT_EQ(1, perfStatsGetBucketIndex(63));
+	ASSERT_EQ(2, perfStatsGetBucketIndex(64));
+	ASSERT_EQ(PERF_STATS_BUCKET_COUNT - 1, perfStatsGetBucketIndex(1 << 19));
+	ASSERT_EQ(PERF_STATS_BUCKET_COUNT - 1, perfStatsGetBucketIndex(0xFFFFFFFF));
+
+	perfStatsReset();
+	const perf_event_stats_s& stats = getPerfStats()->events[(size_t)PE::MainTriggerCallback];
+	ASSERT_EQ(0, stats.count);
+	ASSERT_EQ(0, perfStatsGetPercentileNt(PE::MainTriggerCallback, 99));
+
+	// 98 fast ones and two slow outliers
+	for (int i = 0; i < 98; i++) {
+		perfStatsAdd(PE::MainTriggerCallback, 40 + i % 10);
+	}
+	perfStatsAdd(PE::MainTriggerCallback, 1000);
+	perfStatsAdd(PE::MainTriggerCallback, 5000);
+
+	ASSERT_EQ(100, stats.count);
+	ASSERT_EQ(40, stats.minNt);
+	ASSERT_EQ(5000, stats.maxNt);
+	ASSERT_EQ(98, stats.buckets[1]);
+	ASSERT_EQ(1, stats.buckets[perfStatsGetBucketIndex(1000)]);
+	ASSERT_EQ(1, stats.buckets[perfStatsGetBucketIndex(5000)]);
+
+	// upper bound of the bucket
+	ASSERT_EQ(63, perfStatsGetPercentileNt(PE::MainTriggerCallback, 50));
+	ASSERT_EQ(63, perfStatsGetPercentileNt(PE::MainTriggerCallback, 98));
+	ASSERT_EQ(1023, perfStatsGetPercentileNt(PE::MainTriggerCallback, 99));
+	// never above max
+	ASSERT_EQ(5000, perfStatsGetPercentileNt(PE::MainTriggerCallback, 100));
+
+	// other events are not affected
+	ASSERT_EQ(0, getPerfStats()->events[(size_t)PE::EventQueueExecuteCallback].count);
+
+	// ScopePerf feeds the same statistics
+	{
+		ScopePerf perf(PE::EventQueueExecuteCallback);
+	}
+	ASSERT_EQ(1, getPerfStats()->events[(size_t)PE::EventQueueExecuteCallback].count);
+}
+
 static void testMalfunctionCentralRemoveNonExistent() {
 	clearWarnings();
 
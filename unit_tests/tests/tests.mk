@@ -9,6 +9,7 @@ TESTS_SRC_CPP = \
 	tests/trigger/test_real_cranking_miata_NA.cpp \
 	tests/trigger/test_real_cranking_miata_na6.cpp \
 	tests/trigger/test_real_volkswagen.cpp \
+	tests/trigger/test_trigger_replay_benchmark.cpp \
 	tests/trigger/test_rpm_multiplier.cpp \
 	tests/trigger/test_quad_cam.cpp \
 	tests/trigger/test_nissan_vq_vvt.cpp \
@@ -23,6 +24,7 @@ TESTS_SRC_CPP = \
 	tests/ignition_injection/test_injector_model.cpp \
 	tests/lua/test_lua_basic.cpp \
 	tests/lua/test_lua_hooks.cpp \
+	tests/lua/test_lua_bytecode.cpp \
 	tests/sensor/test_cj125.cpp \
 	tests/util/test_timer.cpp \
 	tests/system/test_periodic_thread_controller.cpp \
@@ -31,6 +33,10 @@ TESTS_SRC_CPP = \
 	tests/test_hardware_reinit.cpp \
 	tests/test_ion.cpp \
 	tests/test_aux_valves.cpp \
+	tests/test_map_averaging.cpp \
+	tests/test_engine_sniffer.cpp \
+	tests/test_config_change.cpp \
+	tests/test_flash_journal.cpp \
 	tests/test_on_demand_parameters.cpp \
 	tests/test_hip9011.cpp \
 	tests/test_engine_math.cpp \
@@ -47,10 +53,12 @@ TESTS_SRC_CPP = \
 	tests/ignition_injection/test_fuel_wall_wetting.cpp \
 	tests/test_one_cylinder_logic.cpp \
 	tests/test_tunerstudio.cpp \
+	tests/test_can_tx_schedule.cpp \
 	tests/test_pwm_generator.cpp \
 	tests/test_logic_expression.cpp \
 	tests/test_log_buffer.cpp \
 	tests/test_signal_executor.cpp \
+	tests/test_timer_wheel.cpp \
 	tests/test_cpp_memory_layout.cpp \
 	tests/test_sensors.cpp \
 	tests/test_pid_auto.cpp \
@@ -71,6 +79,7 @@ TESTS_SRC_CPP = \
 	tests/sensor/redundant.cpp \
 	tests/sensor/test_sensor_init.cpp \
 	tests/sensor/table_func.cpp \
+	tests/sensor/test_knock_band_bank.cpp \
 	tests/util/test_closed_loop_controller.cpp \
 	tests/test_stft.cpp \
 	tests/test_boost.cpp \
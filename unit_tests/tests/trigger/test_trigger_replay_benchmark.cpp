@@ -0,0 +1,127 @@
+/*
+ * @file test_trigger_replay_benchmark.cpp
+ *
+ * Replays real trigger captures through hwHandleShaftSignal -> mainTriggerCallback -> executor queue and reports
+ * cost of each stage. Full benchmark is disabled in regular runs, see 'make benchmark'.
+ *
+ * @date Oct 18, 2026
+ * @author Andrey Belomutskiy, (c) 2012-2021
+ */
+
+#include "engine_test_helper.h"
+#include "logicdata_csv_reader.h"
+
+#define TRIGGER_REPLAY_BENCHMARK_OUTPUT "build/trigger_replay_benchmark.json"
+
+struct ReplayCapture {
+	const char *name;
+	const char *fileName;
+	size_t triggerCount;
+	int columns[2];
+	engine_type_e engineType;
+	// TT_ONE means engine default trigger
+	trigger_type_e triggerType;
+};
+
+static const ReplayCapture captures[] = {
+	{ "vw_aba_cranking", "tests/trigger/recourses/nick_1.csv", 1, { 0, 0 }, VW_ABA, TT_60_2_VW },
+	// these files have first trigger channel in second column
+	{ "miata_na_cranking_3", "tests/trigger/recourses/cranking_na_3.csv", 2, { 1, 0 }, MIATA_NA6_MAP, TT_ONE },
+	{ "miata_na_cranking_4", "tests/trigger/recourses/cranking_na_4.csv", 2, { 1, 0 }, MIATA_NA6_MAP, TT_ONE },
+};
+
+struct ReplayResult {
+	CsvReplayStats stats;
+	int rpm = 0;
+	int warnings = 0;
+};
+
+static ReplayResult replay(const ReplayCapture& capture, double speed) {
+	ReplayResult result;
+
+	CsvReader reader(capture.triggerCount, /* timestampOffset */ 0, speed);
+	reader.setStats(&result.stats);
+	reader.open(capture.fileName, capture.columns);
+
+	WITH_ENGINE_TEST_HELPER(capture.engineType);
+	if (capture.triggerType != TT_ONE) {
+		eth.setTriggerType(capture.triggerType PASS_ENGINE_PARAMETER_SUFFIX);
+	}
+
+	while (reader.haveMore()) {
+		reader.processLine(&eth);
+	}
+
+	result.rpm = GET_RPM();
+	result.warnings = eth.recentWarnings()->getCount();
+	return result;
+}
+
+static void printStage(FILE *fp, const char *name, const CsvReplayStage& stage, bool isLast) {
+	fprintf(fp, "        \"%s\": { \"calls\": %d, \"totalNs\": %ld, \"maxNs\": %ld, \"nsPerCall\": %ld, "
+			"\"allocations\": %ld, \"scheduled\": %d, \"executed\": %d }%s\n",
+			name, stage.calls, stage.totalNs, stage.maxNs,
+			stage.calls == 0 ? 0 : stage.totalNs / stage.calls,
+			stage.allocations, stage.scheduled, stage.executed,
+			isLast ? "" : ",");
+}
+
+TEST(triggerReplayBenchmark, statsAtRecordedSpeed) {
+	ReplayResult result = replay(captures[0], 1);
+	const CsvReplayStats& stats = result.stats;
+
+	// same capture as crankingVW.vwRealCrankingFromFile
+	ASSERT_EQ(1687, result.rpm);
+	ASSERT_EQ(0, result.warnings);
+
+	// one call per edge
+	ASSERT_GT(stats.trigger.calls, 5000);
+	// spark and fuel are scheduled from trigger callback, and some more from executed callbacks
+	ASSERT_GT(stats.trigger.scheduled, 0);
+	ASSERT_GT(stats.events.executed, 0);
+	// trigger callback does not execute anything itself
+	ASSERT_EQ(0, stats.trigger.executed);
+	// firmware does not touch the heap on this path, the few we see are unit test recorders growing their vectors
+	EXPECT_LT(stats.trigger.allocations, stats.trigger.calls / 100);
+	EXPECT_LT(stats.events.allocations, stats.trigger.calls / 100);
+}
+
+/**
+ * Run with 'make benchmark', results are written as JSON to TRIGGER_REPLAY_BENCHMARK_OUTPUT
+ */
+TEST(triggerReplayBenchmark, DISABLED_replayCaptures) {
+	FILE *fp = fopen(TRIGGER_REPLAY_BENCHMARK_OUTPUT, "w");
+	ASSERT_TRUE(fp != nullptr);
+
+	fprintf(fp, "{\n  \"runs\": [\n");
+	bool isFirst = true;
+	for (const ReplayCapture& capture : captures) {
+		for (int speed : { 1, 2, 5, 10, 20, 50, 100 }) {
+			ReplayResult result = replay(capture, speed);
+			const CsvReplayStats& stats = result.stats;
+			long teeth = stats.trigger.calls;
+			long nsPerTooth = teeth == 0 ? 0 : (stats.trigger.totalNs + stats.events.totalNs) / teeth;
+
+			printf("BENCH %s speed=%dx teeth=%ld nsPerTooth=%ld maxTriggerNs=%ld scheduled=%d allocations=%ld\r\n",
+					capture.name, speed, teeth, nsPerTooth, stats.trigger.maxNs,
+					stats.trigger.scheduled + stats.events.scheduled,
+					stats.trigger.allocations + stats.events.allocations);
+
+			fprintf(fp, "%s    {\n", isFirst ? "" : ",\n");
+			isFirst = false;
+			fprintf(fp, "      \"capture\": \"%s\",\n", capture.name);
+			fprintf(fp, "      \"speed\": %d,\n", speed);
+			fprintf(fp, "      \"teeth\": %ld,\n", teeth);
+			fprintf(fp, "      \"nsPerTooth\": %ld,\n", nsPerTooth);
+			fprintf(fp, "      \"rpm\": %d,\n", result.rpm);
+			fprintf(fp, "      \"warnings\": %d,\n", result.warnings);
+			fprintf(fp, "      \"stages\": {\n");
+			printStage(fp, "trigger", stats.trigger, false);
+			printStage(fp, "events", stats.events, true);
+			fprintf(fp, "      }\n    }");
+		}
+	}
+	fprintf(fp, "\n  ]\n}\n");
+	fclose(fp);
+	printf("Benchmark results written to %s\r\n", TRIGGER_REPLAY_BENCHMARK_OUTPUT);
+}
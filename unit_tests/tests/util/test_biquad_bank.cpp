@@ -0,0 +1,140 @@
+#include "biquad_bank.h"
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+
+// same rate as slow ADC
+#define SAMPLE_RATE 500
+#define CHANNELS 16
+
+static float getInput(int channel, int sample) {
+	// every channel sees a different ramp with a bit of noise on top
+	return 0.1f * channel + 0.001f * sample + ((sample * 7 + channel * 13) % 5) * 0.01f;
+}
+
+TEST(BiquadBank, PassthruByDefault) {
+	BiquadBank<4> dut;
+
+	float in[] = { 1, 2, 3, 4 };
+	float out[4];
+	dut.filter(in, out, 4);
+
+	EXPECT_EQ(0, memcmp(in, out, sizeof(in)));
+}
+
+TEST(BiquadBank, BitExactWithBiquad) {
+	BiquadBank<CHANNELS> dut;
+	Biquad reference[CHANNELS];
+
+	for (int i = 0; i < CHANNELS; i++) {
+		float cutoff = 5 + 10 * i;
+		dut.configureLowpass(i, SAMPLE_RATE, cutoff);
+		reference[i].configureLowpass(SAMPLE_RATE, cutoff);
+
+		dut.cookSteadyState(i, getInput(i, 0));
+		reference[i].cookSteadyState(getInput(i, 0));
+	}
+
+	float in[CHANNELS];
+	float out[CHANNELS];
+	for (int sample = 0; sample < 1000; sample++) {
+		for (int i = 0; i < CHANNELS; i++) {
+			in[i] = getInput(i, sample);
+		}
+
+		dut.filter(in, out, CHANNELS);
+
+		for (int i = 0; i < CHANNELS; i++) {
+			float expected = reference[i].filter(in[i]);
+			ASSERT_EQ(0, memcmp(&expected, &out[i], sizeof(float))) << "channel " << i << " sample " << sample;
+		}
+	}
+}
+
+TEST(BiquadBank, OnlyCountChannelsUpdated) {
+	BiquadBank<4> dut;
+	for (int i = 0; i < 4; i++) {
+		dut.configureLowpass(i, SAMPLE_RATE, 10);
+		dut.cookSteadyState(i, 2);
+	}
+
+	// in place, only first two channels
+	float values[] = { 3, 3, 3, 3 };
+	dut.filter(values, values, 2);
+	EXPECT_GT(values[0], 2);
+	EXPECT_LT(values[0], 3);
+	EXPECT_EQ(3, values[2]);
+
+	// untouched channels still sit at the steady state
+	float steady[] = { 2, 2, 2, 2 };
+	dut.filter(steady, steady, 4);
+	EXPECT_NEAR(2, steady[3], 1e-4);
+}
+
+// Per-entry layout as AdcSubscription had it: filter state scattered between other fields
+struct AdcEntryLike {
+	void *Sensor;
+	float VoltsPerAdcVolt;
+	int Channel;
+	Biquad Filter;
+	bool HasUpdated;
+};
+
+static float s_published[CHANNELS];
+
+static void __attribute__((noinline)) postRawValue(int index, float value) {
+	s_published[index] = value;
+}
+
+TEST(biquadBankBenchmark, DISABLED_adcSubscription) {
+	const int iterations = 200000;
+	static float raw[CHANNELS];
+	for (int i = 0; i < CHANNELS; i++) {
+		raw[i] = getInput(i, 0);
+	}
+
+	static AdcEntryLike entries[CHANNELS];
+	for (int i = 0; i < CHANNELS; i++) {
+		entries[i].VoltsPerAdcVolt = 1.5f;
+		entries[i].Filter.configureLowpass(SAMPLE_RATE, 20);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	for (int n = 0; n < iterations; n++) {
+		raw[n % CHANNELS] += 0.0001f;
+		for (int i = 0; i < CHANNELS; i++) {
+			auto& entry = entries[i];
+			postRawValue(i, entry.Filter.filter(raw[i] * entry.VoltsPerAdcVolt));
+		}
+	}
+	double perEntryNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+	float perEntryLast = s_published[CHANNELS - 1];
+
+	static BiquadBank<CHANNELS> bank;
+	static float voltsPerAdcVolt[CHANNELS];
+	static float volts[CHANNELS];
+	for (int i = 0; i < CHANNELS; i++) {
+		raw[i] = getInput(i, 0);
+		voltsPerAdcVolt[i] = 1.5f;
+		bank.configureLowpass(i, SAMPLE_RATE, 20);
+	}
+
+	start = std::chrono::steady_clock::now();
+	for (int n = 0; n < iterations; n++) {
+		raw[n % CHANNELS] += 0.0001f;
+		for (int i = 0; i < CHANNELS; i++) {
+			volts[i] = raw[i] * voltsPerAdcVolt[i];
+		}
+		bank.filter(volts, volts, CHANNELS);
+		for (int i = 0; i < CHANNELS; i++) {
+			postRawValue(i, volts[i]);
+		}
+	}
+	double bankNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+	// both paths filtered exactly the same inputs
+	EXPECT_EQ(perEntryLast, s_published[CHANNELS - 1]);
+
+	printf("%d channels update: per entry %.1f ns, bank %.1f ns\n", CHANNELS, perEntryNs, bankNs);
+}
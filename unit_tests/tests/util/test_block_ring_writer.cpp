@@ -0,0 +1,83 @@
+#include "block_ring_writer.h"
+#include <gtest/gtest.h>
+
+#include <string>
+
+static const char* testBuffer = "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+template <size_t TBlockSize, size_t TBlockCount>
+static std::string drain(BlockRingWriter<TBlockSize, TBlockCount>& dut) {
+	std::string result;
+	size_t size;
+	while (const char* block = dut.getReadyBlock(size)) {
+		result.append(block, size);
+		dut.releaseBlock();
+	}
+	return result;
+}
+
+TEST(BlockRingWriter, NothingReadyUntilBlockIsFull) {
+	BlockRingWriter<10, 3> dut;
+	size_t size;
+
+	EXPECT_EQ(5u, dut.write(testBuffer, 5));
+	EXPECT_FALSE(dut.hasReadyBlock());
+	EXPECT_EQ(nullptr, dut.getReadyBlock(size));
+
+	EXPECT_EQ(5u, dut.write(testBuffer + 5, 5));
+	EXPECT_TRUE(dut.hasReadyBlock());
+	EXPECT_EQ("abcdefghij", drain(dut));
+	EXPECT_FALSE(dut.hasReadyBlock());
+}
+
+TEST(BlockRingWriter, RecordSpansBlocks) {
+	BlockRingWriter<10, 3> dut;
+
+	EXPECT_EQ(7u, dut.write(testBuffer, 7));
+	EXPECT_EQ(16u, dut.write(testBuffer + 7, 16));
+	EXPECT_EQ(2u, dut.getMaxReadyBlocks());
+	EXPECT_EQ(std::string(testBuffer, 20), drain(dut));
+
+	// partial block is handed over by flush
+	EXPECT_EQ(3u, dut.flush());
+	EXPECT_EQ(std::string(testBuffer + 20, 3), drain(dut));
+	EXPECT_EQ(0u, dut.flush());
+}
+
+TEST(BlockRingWriter, SlowConsumerDropsWholeRecords) {
+	BlockRingWriter<10, 2> dut;
+
+	EXPECT_EQ(8u, dut.write(testBuffer, 8));
+	EXPECT_EQ(8u, dut.write(testBuffer + 8, 8));
+	// only 4 bytes left, record does not fit and is not partially stored
+	EXPECT_EQ(0u, dut.write(testBuffer + 16, 8));
+	EXPECT_EQ(1u, dut.getDroppedRecords());
+	EXPECT_EQ(4u, dut.write(testBuffer + 16, 4));
+	// everything is full now
+	EXPECT_EQ(0u, dut.write(testBuffer + 20, 1));
+	EXPECT_EQ(2u, dut.getDroppedRecords());
+
+	// consumer catches up, producer continues
+	EXPECT_EQ(std::string(testBuffer, 20), drain(dut));
+	EXPECT_EQ(8u, dut.write(testBuffer + 20, 8));
+	EXPECT_EQ(2u, dut.getDroppedRecords());
+	dut.flush();
+	EXPECT_EQ(std::string(testBuffer + 20, 8), drain(dut));
+}
+
+TEST(BlockRingWriter, ConsumerReleasesOneBlock) {
+	BlockRingWriter<4, 2> dut;
+	size_t size;
+
+	EXPECT_EQ(8u, dut.write(testBuffer, 8));
+	const char* block = dut.getReadyBlock(size);
+	ASSERT_NE(nullptr, block);
+	EXPECT_EQ(4u, size);
+	EXPECT_EQ(std::string("abcd"), std::string(block, size));
+	dut.releaseBlock();
+
+	// freed block is reused while the second one is still waiting
+	EXPECT_EQ(4u, dut.write(testBuffer + 8, 4));
+	EXPECT_EQ(0u, dut.write(testBuffer + 12, 1));
+	EXPECT_EQ(std::string(testBuffer + 4, 8), drain(dut));
+}
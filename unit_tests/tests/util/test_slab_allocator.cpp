@@ -0,0 +1,201 @@
+#include "slab_allocator.h"
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <vector>
+
+static int fallbackAllocCount;
+static int fallbackFreeCount;
+static int fallbackBudget;
+// slab pages are never given back, whatever is left is freed after each test
+static std::set<void*> fallbackBlocks;
+
+static void* countingAlloc(size_t size) {
+	if (fallbackBudget-- <= 0) {
+		return nullptr;
+	}
+	fallbackAllocCount++;
+	void* ptr = malloc(size);
+	fallbackBlocks.insert(ptr);
+	return ptr;
+}
+
+static void countingFree(void* ptr) {
+	fallbackFreeCount++;
+	fallbackBlocks.erase(ptr);
+	free(ptr);
+}
+
+class SlabAllocatorTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		fallbackAllocCount = 0;
+		fallbackFreeCount = 0;
+		fallbackBudget = 1000000;
+	}
+
+	void TearDown() override {
+		for (void* ptr : fallbackBlocks) {
+			free(ptr);
+		}
+		fallbackBlocks.clear();
+	}
+};
+
+TEST(SlabAllocator, SizeClasses) {
+	EXPECT_EQ(0, getSlabSizeClass(1));
+	EXPECT_EQ(0, getSlabSizeClass(8));
+	EXPECT_EQ(1, getSlabSizeClass(9));
+	EXPECT_EQ(4, getSlabSizeClass(33));
+	EXPECT_EQ(5, getSlabSizeClass(64));
+	EXPECT_EQ(-1, getSlabSizeClass(65));
+}
+
+TEST_F(SlabAllocatorTest, SmallBlocksShareOnePage) {
+	SlabAllocator dut(countingAlloc, countingFree);
+
+	std::set<void*> blocks;
+	// one page worth of 16 byte blocks
+	for (int i = 0; i < SLAB_PAGE_SIZE / 16; i++) {
+		void* ptr = dut.reallocate(nullptr, 0, 16);
+		ASSERT_NE(nullptr, ptr);
+		memset(ptr, i, 16);
+		blocks.insert(ptr);
+	}
+	EXPECT_EQ(SLAB_PAGE_SIZE / 16, blocks.size());
+	EXPECT_EQ(1, fallbackAllocCount);
+	EXPECT_EQ(SLAB_PAGE_SIZE / 16 * 16, dut.getStats().usedBytes);
+	EXPECT_EQ(SLAB_PAGE_SIZE, dut.getStats().slabBytes);
+	EXPECT_EQ(0, dut.getStats().slabFreeBytes);
+
+	// freed block is the next one handed out
+	void* some = *blocks.begin();
+	dut.reallocate(some, 16, 0);
+	EXPECT_EQ(some, dut.reallocate(nullptr, 0, 12));
+	EXPECT_EQ(1, fallbackAllocCount);
+
+	// Lua passes object type as old size for new blocks
+	void* next = dut.reallocate(nullptr, 5, 16);
+	ASSERT_NE(nullptr, next);
+	EXPECT_EQ(2, fallbackAllocCount);
+	EXPECT_EQ(SLAB_PAGE_SIZE / 16 * 16 + 16 + 12 - 16, dut.getStats().usedBytes);
+}
+
+TEST_F(SlabAllocatorTest, ReallocWithinClassDoesNotMove) {
+	SlabAllocator dut(countingAlloc, countingFree);
+
+	void* ptr = dut.reallocate(nullptr, 0, 40);
+	strcpy((char*)ptr, "hello");
+
+	// 33..48 is one class
+	EXPECT_EQ(ptr, dut.reallocate(ptr, 40, 48));
+	EXPECT_EQ(ptr, dut.reallocate(ptr, 48, 33));
+	EXPECT_EQ(2, dut.getStats().inPlaceCount);
+	EXPECT_EQ(33, dut.getStats().usedBytes);
+	EXPECT_EQ(48, dut.getStats().peakUsedBytes);
+
+	// grows into the next class
+	void* moved = dut.reallocate(ptr, 33, 60);
+	EXPECT_NE(ptr, moved);
+	EXPECT_STREQ("hello", (char*)moved);
+	EXPECT_EQ(60, dut.getStats().usedBytes);
+}
+
+TEST_F(SlabAllocatorTest, LargeBlocksGoToFallback) {
+	SlabAllocator dut(countingAlloc, countingFree);
+
+	void* ptr = dut.reallocate(nullptr, 0, 1000);
+	ASSERT_NE(nullptr, ptr);
+	EXPECT_EQ(1, fallbackAllocCount);
+	EXPECT_EQ(1000, dut.getStats().largeBytes);
+	EXPECT_EQ(0, dut.getStats().slabBytes);
+
+	// large shrink stays in place
+	EXPECT_EQ(ptr, dut.reallocate(ptr, 1000, 200));
+	EXPECT_EQ(200, dut.getStats().largeBytes);
+	EXPECT_EQ(1, fallbackAllocCount);
+
+	// large grow moves
+	memset(ptr, 7, 200);
+	void* grown = dut.reallocate(ptr, 200, 2000);
+	EXPECT_EQ(7, ((uint8_t*)grown)[199]);
+	EXPECT_EQ(1, fallbackFreeCount);
+
+	// shrinking into slab range moves to a slab
+	void* small = dut.reallocate(grown, 2000, 20);
+	EXPECT_EQ(7, ((uint8_t*)small)[19]);
+	EXPECT_EQ(2, fallbackFreeCount);
+	EXPECT_EQ(0, dut.getStats().largeBytes);
+	EXPECT_EQ(20, dut.getStats().usedBytes);
+	EXPECT_EQ(2000, dut.getStats().peakUsedBytes);
+
+	dut.reallocate(small, 20, 0);
+	EXPECT_EQ(0, dut.getStats().usedBytes);
+	EXPECT_EQ(100, dut.getSlabFragmentationPercent());
+}
+
+TEST_F(SlabAllocatorTest, OutOfMemory) {
+	SlabAllocator dut(countingAlloc, countingFree);
+
+	void* large = dut.reallocate(nullptr, 0, 500);
+	void* small = dut.reallocate(nullptr, 0, 64);
+	fallbackBudget = 0;
+
+	// growing fails, old block is intact
+	EXPECT_EQ(nullptr, dut.reallocate(large, 500, 600));
+	EXPECT_EQ(nullptr, dut.reallocate(nullptr, 0, 8));
+	EXPECT_EQ(2, dut.getStats().failedCount);
+
+	// shrinks never fail even when there is no page for the smaller class
+	EXPECT_EQ(small, dut.reallocate(small, 64, 8));
+	EXPECT_EQ(large, dut.reallocate(large, 500, 8));
+	EXPECT_EQ(0, dut.getStats().largeBytes);
+	EXPECT_EQ(16, dut.getStats().usedBytes);
+
+	// and come back as 8 byte blocks
+	dut.reallocate(small, 8, 0);
+	dut.reallocate(large, 8, 0);
+	EXPECT_EQ(large, dut.reallocate(nullptr, 0, 8));
+	EXPECT_EQ(small, dut.reallocate(nullptr, 0, 8));
+	EXPECT_EQ(2, dut.getStats().failedCount);
+	EXPECT_LE(dut.getStats().slabFreeBytes, dut.getStats().slabBytes);
+}
+
+TEST_F(SlabAllocatorTest, LuaLikeChurnKeepsPagesReused) {
+	SlabAllocator dut(countingAlloc, countingFree);
+	srand(0);
+
+	std::vector<std::pair<void*, size_t>> live;
+	for (int i = 0; i < 100000; i++) {
+		if (live.size() < 200 && (live.empty() || rand() % 2)) {
+			size_t size = 1 + rand() % (rand() % 10 == 0 ? 300 : 64);
+			void* ptr = dut.reallocate(nullptr, rand() % 9, size);
+			ASSERT_NE(nullptr, ptr);
+			memset(ptr, 0xAA, size);
+			live.push_back({ptr, size});
+		} else {
+			size_t index = rand() % live.size();
+			dut.reallocate(live[index].first, live[index].second, 0);
+			live[index] = live.back();
+			live.pop_back();
+		}
+	}
+
+	size_t used = 0;
+	for (auto& block : live) {
+		used += block.second;
+	}
+	EXPECT_EQ(used, dut.getStats().usedBytes);
+	// pages are bounded by the peak live set, not by the number of allocations
+	EXPECT_LT(dut.getStats().slabBytes, 200 * 64 + SLAB_SIZE_CLASS_COUNT * SLAB_PAGE_SIZE);
+	EXPECT_LE(dut.getStats().slabFreeBytes, dut.getStats().slabBytes);
+
+	for (auto& block : live) {
+		dut.reallocate(block.first, block.second, 0);
+	}
+	EXPECT_EQ(0, dut.getStats().usedBytes);
+	EXPECT_EQ(0, dut.getStats().largeBytes);
+	EXPECT_EQ(dut.getStats().slabBytes, dut.getStats().slabFreeBytes);
+}
@@ -0,0 +1,120 @@
+#include "spsc_queue.h"
+#include <gtest/gtest.h>
+
+#include <thread>
+
+// stands for CAN frame with the time it was received
+struct TimestampedFrame {
+	uint32_t eid;
+	uint8_t data[8];
+	int64_t nowNt;
+};
+
+static TimestampedFrame makeFrame(uint32_t eid, int64_t nowNt) {
+	TimestampedFrame frame = { eid, { 0 }, nowNt };
+	frame.data[0] = eid & 0xFF;
+	return frame;
+}
+
+TEST(SpscQueue, EmptyQueue) {
+	SpscQueue<TimestampedFrame, 4> dut;
+	TimestampedFrame frame;
+
+	EXPECT_FALSE(dut.pop(frame));
+	EXPECT_EQ(0u, dut.getCount());
+	EXPECT_EQ(0u, dut.getOverrunCount());
+	EXPECT_EQ(0u, dut.getHighWaterMark());
+}
+
+TEST(SpscQueue, FramesKeepOrderAndTimestamps) {
+	SpscQueue<TimestampedFrame, 8> dut;
+
+	for (int i = 0; i < 5; i++) {
+		EXPECT_TRUE(dut.push(makeFrame(0x100 + i, 1000 + 10 * i)));
+	}
+	EXPECT_EQ(5u, dut.getCount());
+
+	TimestampedFrame frame;
+	for (int i = 0; i < 5; i++) {
+		ASSERT_TRUE(dut.pop(frame));
+		EXPECT_EQ(0x100u + i, frame.eid);
+		EXPECT_EQ(i, frame.data[0]);
+		// timestamp is the one taken on arrival, not when the frame was consumed
+		EXPECT_EQ(1000 + 10 * i, frame.nowNt);
+	}
+	EXPECT_FALSE(dut.pop(frame));
+	EXPECT_EQ(5u, dut.getHighWaterMark());
+}
+
+TEST(SpscQueue, BurstOverrun) {
+	SpscQueue<TimestampedFrame, 16> dut;
+
+	// burst of 20 frames while consumer is busy
+	int accepted = 0;
+	for (int i = 0; i < 20; i++) {
+		accepted += dut.push(makeFrame(i, i)) ? 1 : 0;
+	}
+	EXPECT_EQ(16, accepted);
+	EXPECT_EQ(4u, dut.getOverrunCount());
+	EXPECT_EQ(16u, dut.getHighWaterMark());
+
+	// batch drain gets the oldest frames, newest ones were dropped
+	TimestampedFrame frame;
+	int count = 0;
+	while (dut.pop(frame)) {
+		EXPECT_EQ((uint32_t)count, frame.eid);
+		count++;
+	}
+	EXPECT_EQ(16, count);
+
+	// room again, statistics are sticky
+	EXPECT_TRUE(dut.push(makeFrame(100, 100)));
+	EXPECT_EQ(4u, dut.getOverrunCount());
+	EXPECT_EQ(16u, dut.getHighWaterMark());
+}
+
+TEST(SpscQueue, IndexWrapAround) {
+	SpscQueue<int, 4> dut;
+	int value;
+
+	for (int i = 0; i < 1000; i++) {
+		ASSERT_TRUE(dut.push(i));
+		ASSERT_TRUE(dut.push(-i));
+		ASSERT_TRUE(dut.pop(value));
+		ASSERT_EQ(i, value);
+		ASSERT_TRUE(dut.pop(value));
+		ASSERT_EQ(-i, value);
+	}
+	EXPECT_EQ(0u, dut.getOverrunCount());
+	EXPECT_EQ(2u, dut.getHighWaterMark());
+}
+
+TEST(SpscQueue, ProducerAndConsumerThreads) {
+	static SpscQueue<TimestampedFrame, 32> dut;
+	const int frameCount = 100000;
+
+	std::thread producer([&]() {
+		for (int i = 0; i < frameCount; i++) {
+			while (!dut.push(makeFrame(i, i))) {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	TimestampedFrame frame;
+	int expected = 0;
+	while (expected < frameCount) {
+		if (!dut.pop(frame)) {
+			std::this_thread::yield();
+			continue;
+		}
+		// no ASSERT here, producer thread has to be joined
+		EXPECT_EQ((uint32_t)expected, frame.eid);
+		EXPECT_EQ(expected, frame.nowNt);
+		expected++;
+	}
+	producer.join();
+
+	EXPECT_EQ(0u, dut.getCount());
+	EXPECT_LE(dut.getHighWaterMark(), 32u);
+}
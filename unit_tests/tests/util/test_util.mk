@@ -1,7 +1,11 @@
 
 
 CPPSRC += 	$(PROJECT_DIR)/../unit_tests/tests/util/test_buffered_writer.cpp \
+	$(PROJECT_DIR)/../unit_tests/tests/util/test_block_ring_writer.cpp \
+	$(PROJECT_DIR)/../unit_tests/tests/util/test_spsc_queue.cpp \
+	$(PROJECT_DIR)/../unit_tests/tests/util/test_slab_allocator.cpp \
 	$(PROJECT_DIR)/../unit_tests/tests/util/test_error_accumulator.cpp \
+	$(PROJECT_DIR)/../unit_tests/tests/util/test_biquad_bank.cpp \
 
 INCDIR += $(PROJECT_DIR)/controllers/system	
 	
\ No newline at end of file